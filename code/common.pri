@@ -43,6 +43,11 @@ win32 {
 
 DEFINES += READLINE_LIBRARY
 
+# gzip compression of the log files, see utility/log_file.h
+unix {
+    DEFINES += HAVE_ZLIB
+}
+
 win32 {
   DEFINES += HAVE_STRUCT_TIMESPEC
 }
@@ -52,7 +57,7 @@ CONFIG(debug, debug|release) {
 }
 
 
-MODULES = utility tcl device gui editor
+MODULES = utility tcl device design gui editor
 
 QT += core widgets xml
 CONFIG += qt thread
@@ -0,0 +1,57 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Multithreaded reader for VTR-style BLIF (.model, .inputs, .outputs,
+//* .names, .latch, .subckt). The memory-mapped file is cut at its .model
+//* lines, large models are cut further between .names/.latch/.subckt lines.
+//* The pieces are parsed on worker threads into private designs and merged
+//* in file order, the nets of every model are built from the signal names
+//* once the whole model is merged.
+//******************************************************************************
+
+#ifndef DESIGN_BLIF_READER_H
+#define DESIGN_BLIF_READER_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "design/design.h"
+
+namespace eda {
+
+  class BlifReader {
+  public:
+    // models are cut into pieces of about this size
+    static const size_t kUnitSize = 1024 * 1024;
+
+    explicit BlifReader(Design* design);
+    ~BlifReader() {}
+
+    // num_threads <= 0 uses all processors
+    bool read(const std::string& file_name, int num_threads = 0);
+
+  private:
+    // A piece of one model. The first piece of a model starts at its .model
+    // line, the others at a .names, .latch or .subckt line.
+    class Unit {
+    public:
+      const char* begin;
+      const char* end;
+      // line number of begin
+      uint32_t line;
+      bool header;
+    };
+
+    bool split(const char* begin, const char* end);
+
+    Design* design_;
+    std::string file_name_;
+    std::vector<Unit> units_;
+  };
+
+}
+
+#endif // !DESIGN_BLIF_READER_H
@@ -0,0 +1,204 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* In-memory netlist shared by the XDL, EDIF and BLIF readers. All names are
+//* IDs into one string pool and all objects are plain records in flat arrays:
+//* the pins of net n are [netPinBegin(n), netPinEnd(n)), its PIPs are
+//* [netPipBegin(n), netPipEnd(n)).
+//*
+//* Hierarchical netlists (EDIF, BLIF) are stored as cells: the ports,
+//* instances and nets of cell c are contiguous ranges as well. A physical XDL
+//* design has no cells, its instances and nets form one flat netlist.
+//******************************************************************************
+
+#ifndef DESIGN_DESIGN_H
+#define DESIGN_DESIGN_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "utility/string_pool.h"
+
+namespace eda {
+
+  class Design {
+  public:
+    typedef StringPool::Id StringId;
+    static const uint32_t kInvalidIndex = 0xffffffff;
+
+    enum NetType {
+      NET_WIRE,
+      NET_POWER,
+      NET_GROUND
+    };
+    enum PinDirection {
+      PIN_INPUT,
+      PIN_OUTPUT,
+      PIN_INOUT,
+      PIN_UNKNOWN
+    };
+
+    class Instance {
+    public:
+      StringId name;
+      StringId type;
+      // StringPool::kInvalidId if unplaced
+      StringId tile;
+      StringId site;
+      StringId config;
+    };
+    class Net {
+    public:
+      StringId name;
+      StringId config;
+      uint32_t pin_begin;
+      uint32_t pip_begin;
+      uint8_t type;
+    };
+    class Cell {
+    public:
+      StringId name;
+      StringId library;
+      uint32_t port_begin;
+      uint32_t instance_begin;
+      uint32_t net_begin;
+    };
+    class Port {
+    public:
+      StringId name;
+      // number of bits, ports wider than 1 are referenced as "name[i]"
+      uint32_t width;
+      uint8_t direction;
+    };
+    class Pin {
+    public:
+      // Instance index once the pins are resolved, the instance name before.
+      // kInvalidIndex for a port of the cell the net belongs to.
+      uint32_t instance;
+      StringId name;
+      uint8_t direction;
+    };
+    class Pip {
+    public:
+      StringId tile;
+      StringId from;
+      StringId to;
+      // the XDL connection operator, e.g. "->"
+      StringId direction;
+    };
+
+  private:
+    static Design* design_;
+
+  public:
+    Design();
+    ~Design() {}
+
+    // the design of the current session, owned by Design
+    static Design* design() { return design_; }
+    static void set_design(Design* design);
+    static void release() { set_design(NULL); }
+
+    StringPool& strings() { return strings_; }
+    const StringPool& strings() const { return strings_; }
+    const char* str(StringId id) const { return id == StringPool::kInvalidId ? "" : strings_.str(id); }
+
+    StringId name() const { return name_; }
+    void set_name(StringId name) { name_ = name; }
+    StringId part() const { return part_; }
+    void set_part(StringId part) { part_ = part; }
+    StringId config() const { return config_; }
+    void set_config(StringId config) { config_ = config; }
+    // name of the top cell of a hierarchical netlist
+    StringId top() const { return top_; }
+    void set_top(StringId top) { top_ = top; }
+
+    // building, ports, instances and nets are added to the last cell if any
+    uint32_t addCell(StringId name, StringId library);
+    void addPort(StringId name, uint32_t width, PinDirection direction);
+    uint32_t addInstance(const Instance& instance);
+    // pins and PIPs are added to the last net
+    uint32_t addNet(StringId name, NetType type);
+    void setNetConfig(StringId config) { nets_.back().config = config; }
+    void addPin(StringId instance_name, StringId pin, PinDirection direction);
+    void addPip(const Pip& pip);
+    // Appends the cells, ports, instances and nets of an unresolved part, e.g.
+    // one parsed on a worker thread, with its names interned into this pool.
+    // string_ids receives the mapping from the IDs of the part to ours.
+    void append(const Design& part, std::vector<StringId>* string_ids = NULL);
+    // Maps the instance names of all pins to instance indices, pins on
+    // unknown instances get kInvalidIndex. Returns the number of such pins.
+    uint32_t resolvePins();
+    // The same for hierarchical netlists, instance names are looked up in
+    // the cell of the net. The direction of every resolved pin is taken from
+    // the port of the instantiated cell if that cell is defined.
+    uint32_t resolveCellPins();
+    // Only the second step, for readers that add pins with instance indices.
+    void resolvePinDirections();
+
+    uint32_t numCells() const { return static_cast<uint32_t>(cells_.size()); }
+    const Cell& cell(uint32_t c) const { return cells_[c]; }
+    uint32_t cellPortBegin(uint32_t c) const { return cells_[c].port_begin; }
+    uint32_t cellPortEnd(uint32_t c) const { return c + 1 < cells_.size() ? cells_[c + 1].port_begin : numPorts(); }
+    uint32_t cellInstanceBegin(uint32_t c) const { return cells_[c].instance_begin; }
+    uint32_t cellInstanceEnd(uint32_t c) const { return c + 1 < cells_.size() ? cells_[c + 1].instance_begin : numInstances(); }
+    uint32_t cellNetBegin(uint32_t c) const { return cells_[c].net_begin; }
+    uint32_t cellNetEnd(uint32_t c) const { return c + 1 < cells_.size() ? cells_[c + 1].net_begin : numNets(); }
+    // returns kInvalidIndex if there is no such cell
+    uint32_t findCell(StringId name) const;
+    uint32_t numPorts() const { return static_cast<uint32_t>(ports_.size()); }
+    const Port& port(uint32_t p) const { return ports_[p]; }
+
+    uint32_t numInstances() const { return static_cast<uint32_t>(instances_.size()); }
+    const Instance& instance(uint32_t i) const { return instances_[i]; }
+    void set_instance_name(uint32_t i, StringId name) { instances_[i].name = name; }
+    // returns kInvalidIndex if there is no such instance
+    uint32_t findInstance(const std::string& name) const;
+
+    uint32_t numNets() const { return static_cast<uint32_t>(nets_.size()); }
+    const Net& net(uint32_t n) const { return nets_[n]; }
+    uint32_t netPinBegin(uint32_t n) const { return nets_[n].pin_begin; }
+    uint32_t netPinEnd(uint32_t n) const { return n + 1 < nets_.size() ? nets_[n + 1].pin_begin : numPins(); }
+    uint32_t netPipBegin(uint32_t n) const { return nets_[n].pip_begin; }
+    uint32_t netPipEnd(uint32_t n) const { return n + 1 < nets_.size() ? nets_[n + 1].pip_begin : numPips(); }
+
+    uint32_t numPins() const { return static_cast<uint32_t>(pins_.size()); }
+    const Pin& pin(uint32_t p) const { return pins_[p]; }
+    uint32_t numPips() const { return static_cast<uint32_t>(pips_.size()); }
+    const Pip& pip(uint32_t p) const { return pips_[p]; }
+
+    size_t memoryUsage() const;
+
+    // Binary snapshot of the design. All records refer to each other by
+    // index, so they are written and read back as flat arrays. source_key
+    // identifies the netlist the design was read from, load() fails if the
+    // snapshot belongs to another key or snapshot version.
+    bool save(const std::string& file_name, uint64_t source_key) const;
+    bool load(const std::string& file_name, uint64_t source_key);
+
+  private:
+    Design(const Design&);
+    Design& operator=(const Design&);
+
+    StringPool strings_;
+    StringId name_;
+    StringId part_;
+    StringId config_;
+    StringId top_;
+    std::vector<Cell> cells_;
+    std::vector<Port> ports_;
+    std::vector<Instance> instances_;
+    std::vector<Net> nets_;
+    std::vector<Pin> pins_;
+    std::vector<Pip> pips_;
+    // (name, index) sorted by name ID, built by resolvePins()
+    std::vector<std::pair<StringId, uint32_t> > instance_index_;
+  };
+
+}
+
+#endif // !DESIGN_DESIGN_H
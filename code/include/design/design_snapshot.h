@@ -0,0 +1,46 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Snapshot of the netlist of a project, <project path>/<project name>.dsnap.
+//* It is written after the netlist has been read and keyed by the xxHash64 of
+//* the original netlist file seeded with kReaderVersion, so reopening the
+//* project loads the snapshot instead of parsing the netlist again until the
+//* netlist or a reader changes.
+//******************************************************************************
+
+#ifndef DESIGN_DESIGN_SNAPSHOT_H
+#define DESIGN_DESIGN_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string>
+
+namespace eda {
+
+  class Design;
+  class Project;
+
+  class DesignSnapshot {
+  public:
+    // bump whenever a reader builds a different design from the same file
+    static const uint32_t kReaderVersion = 1;
+
+    static std::string fileName(Project* project);
+    // the XDL, EDIF or BLIF file of the project, empty if there is none
+    static std::string netlistFile(Project* project);
+
+    // Makes the snapshot the current design if it is up to date. Reads the
+    // whole netlist to hash it, so it runs on the command thread through
+    // the read_snapshot command.
+    static bool open(Project* project);
+    // Writes the snapshot if design was read from the netlist of project.
+    static bool save(Project* project, const Design& design, const std::string& netlist_file);
+
+  private:
+    static bool sourceKey(Project* project, uint64_t& key);
+  };
+
+}
+
+#endif // !DESIGN_DESIGN_SNAPSHOT_H
@@ -0,0 +1,58 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Multithreaded EDIF reader. The memory-mapped file is first cut at the
+//* (cell ...) forms of every library; the contents of large cells, e.g. the
+//* top cell of a flattened netlist, are cut further between their instance and
+//* net forms. The pieces are parsed on worker threads into private designs
+//* which are merged in file order afterwards.
+//******************************************************************************
+
+#ifndef DESIGN_EDIF_READER_H
+#define DESIGN_EDIF_READER_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "design/design.h"
+
+namespace eda {
+
+  class EdifReader {
+  public:
+    // contents of a cell are cut into pieces of about this size
+    static const size_t kUnitSize = 1024 * 1024;
+
+    explicit EdifReader(Design* design);
+    ~EdifReader() {}
+
+    // num_threads <= 0 uses all processors
+    bool read(const std::string& file_name, int num_threads = 0);
+
+  private:
+    // A piece of one cell. The first piece of a cell starts at '(cell' and
+    // defines the cell, the others only hold instance and net forms.
+    class Unit {
+    public:
+      const char* begin;
+      const char* end;
+      uint32_t library;
+      bool header;
+    };
+
+    bool split(const char* begin, const char* end);
+
+    Design* design_;
+    std::string file_name_;
+    std::vector<std::string> libraries_;
+    std::vector<Unit> units_;
+    std::string design_name_;
+    std::string top_cell_;
+  };
+
+}
+
+#endif // !DESIGN_EDIF_READER_H
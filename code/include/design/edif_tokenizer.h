@@ -0,0 +1,60 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Tokenizer for EDIF S-expressions over an in-memory range. Runs of
+//* whitespace, identifiers and skipped forms are scanned 16 (SSE2) or 32
+//* (AVX2) bytes at a time, the AVX2 code is selected at run time if the
+//* processor supports it. Other targets use the scalar code.
+//******************************************************************************
+
+#ifndef DESIGN_EDIF_TOKENIZER_H
+#define DESIGN_EDIF_TOKENIZER_H
+
+#include <stddef.h>
+#include <string.h>
+
+namespace eda {
+
+  class EdifTokenizer {
+  public:
+    enum TokenKind {
+      TOKEN_END,
+      TOKEN_OPEN,
+      TOKEN_CLOSE,
+      TOKEN_ATOM,
+      // text without the quotes
+      TOKEN_STRING
+    };
+
+    EdifTokenizer(const char* begin, const char* end) : p_(begin), end_(end), kind_(TOKEN_END), text_(begin), length_(0) {}
+
+    TokenKind next();
+    TokenKind kind() const { return kind_; }
+    const char* text() const { return text_; }
+    size_t length() const { return length_; }
+    // case-insensitive, EDIF keywords are not case sensitive
+    bool is(const char* keyword) const;
+    const char* position() const { return p_; }
+
+    // Skips to the ')' closing the innermost open form, the next token is the
+    // one after it. Returns false at the end of the range.
+    bool skipForm();
+
+    // first '(', ')' or '"' in [p, end), end if there is none
+    static const char* findStructural(const char* p, const char* end);
+    // "AVX2", "SSE2" or "scalar"
+    static const char* instructionSet();
+
+  private:
+    const char* p_;
+    const char* end_;
+    TokenKind kind_;
+    const char* text_;
+    size_t length_;
+  };
+
+}
+
+#endif // !DESIGN_EDIF_TOKENIZER_H
@@ -0,0 +1,83 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Streaming XDL reader. The file is read sequentially in fixed-size chunks
+//* and every complete statement (up to the terminating ';') is parsed and
+//* dropped right away, so only the statement being parsed is ever held as
+//* text, whatever the size of the file. Module definitions are skipped.
+//******************************************************************************
+
+#ifndef DESIGN_XDL_READER_H
+#define DESIGN_XDL_READER_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "design/design.h"
+
+namespace eda {
+
+  class XdlReader {
+  public:
+    static const size_t kChunkSize = 4 * 1024 * 1024;
+
+    explicit XdlReader(Design* design);
+    ~XdlReader() {}
+
+    // Reports the progress through CommandContext and gives up, returning
+    // false, if the command thread is stopped.
+    bool read(const std::string& file_name);
+
+  private:
+    enum TokenKind {
+      TOKEN_WORD,
+      TOKEN_QUOTED,
+      TOKEN_COMMA
+    };
+    class Token {
+    public:
+      const char* text;
+      size_t length;
+      TokenKind kind;
+      bool is(const char* word) const { return kind == TOKEN_WORD && length == strlen(word) && strncmp(text, word, length) == 0; }
+    };
+    // scanner state, kept between chunks while a statement is incomplete
+    class ScanState {
+    public:
+      ScanState() : offset(0), in_quote(false), escaped(false), in_comment(false), lines(0) {}
+      size_t offset;
+      bool in_quote;
+      bool escaped;
+      bool in_comment;
+      int lines;
+    };
+
+    bool findStatementEnd(const char* begin, const char* end, size_t& length);
+    void tokenize(const char* begin, const char* end);
+    bool parseStatement();
+    bool parseDesign();
+    bool parseInstance();
+    bool parseNet();
+    Design::StringId intern(const Token& token) { return design_->strings().intern(token.text, token.length); }
+    Design::StringId add(const Token& token) { return design_->strings().add(token.text, token.length); }
+    bool syntaxError(const char* message);
+
+    Design* design_;
+    std::string file_name_;
+    ScanState scan_;
+    // line of the current statement and of its first token
+    int line_;
+    int token_line_;
+    bool in_module_;
+    int num_modules_;
+    std::vector<Token> tokens_;
+  };
+
+}
+
+#endif // !DESIGN_XDL_READER_H
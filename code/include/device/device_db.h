@@ -0,0 +1,122 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Binary device catalogue. The file is mapped read-only and accessed in place:
+//* families, devices and the package/speed references are fixed-size records
+//* whose names are offsets into one string pool, so opening the database does
+//* not allocate anything per entry.
+//*
+//*   DeviceDBHeader
+//*   FamilyRecord[num_families]
+//*   DeviceRecord[num_devices]   (grouped by family)
+//*   uint32_t[num_refs]          (string offsets of packages and speeds)
+//*   char[strings_size]          (NUL terminated, de-duplicated names)
+//******************************************************************************
+
+#ifndef DEVICE_DEVICE_DB_H
+#define DEVICE_DEVICE_DB_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "utility/mapped_file.h"
+
+namespace eda {
+
+  struct DeviceDBHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_families;
+    uint32_t num_devices;
+    uint32_t num_refs;
+    uint32_t families_offset;
+    uint32_t devices_offset;
+    uint32_t refs_offset;
+    uint32_t strings_offset;
+    uint32_t strings_size;
+    uint32_t reserved;
+  };
+
+  struct DeviceDBFamilyRecord {
+    uint32_t name;
+    uint32_t device_begin;
+    uint32_t device_count;
+  };
+
+  struct DeviceDBDeviceRecord {
+    uint32_t name;
+    uint32_t family;
+    uint32_t package_begin;
+    uint32_t package_count;
+    uint32_t speed_begin;
+    uint32_t speed_count;
+  };
+
+  class DeviceDatabase {
+  public:
+    static const char kMagic[8];
+    static const uint32_t kVersion = 1;
+
+    DeviceDatabase();
+    ~DeviceDatabase() {}
+
+    bool open(const std::string& file_name);
+    void close();
+    bool isOpen() const { return header_ != NULL; }
+    const std::string& file_name() const { return file_.file_name(); }
+
+    uint32_t numFamilies() const { return header_ ? header_->num_families : 0; }
+    uint32_t numDevices() const { return header_ ? header_->num_devices : 0; }
+    const char* familyName(uint32_t family) const { return stringAt(families_[family].name); }
+    uint32_t familyDeviceBegin(uint32_t family) const { return families_[family].device_begin; }
+    uint32_t familyDeviceCount(uint32_t family) const { return families_[family].device_count; }
+
+    const char* deviceName(uint32_t device) const { return stringAt(devices_[device].name); }
+    uint32_t deviceFamily(uint32_t device) const { return devices_[device].family; }
+    uint32_t numPackages(uint32_t device) const { return devices_[device].package_count; }
+    const char* packageName(uint32_t device, uint32_t i) const { return stringAt(refs_[devices_[device].package_begin + i]); }
+    uint32_t numSpeeds(uint32_t device) const { return devices_[device].speed_count; }
+    const char* speedName(uint32_t device, uint32_t i) const { return stringAt(refs_[devices_[device].speed_begin + i]); }
+
+  private:
+    const char* stringAt(uint32_t offset) const { return strings_ + offset; }
+    bool validate() const;
+
+    MappedFile file_;
+    const DeviceDBHeader* header_;
+    const DeviceDBFamilyRecord* families_;
+    const DeviceDBDeviceRecord* devices_;
+    const uint32_t* refs_;
+    const char* strings_;
+  };
+
+  // Collects a device catalogue in memory and serializes it in the layout
+  // read by DeviceDatabase. Devices may be added in any order.
+  class DeviceDatabaseWriter {
+  public:
+    void addDevice(const std::string& family, const std::string& name,
+      const std::vector<std::string>& packages, const std::vector<std::string>& speeds);
+    bool write(const std::string& file_name);
+
+  private:
+    struct Device {
+      std::string name;
+      std::vector<std::string> packages;
+      std::vector<std::string> speeds;
+    };
+    uint32_t intern(const std::string& s);
+
+    std::vector<std::string> families_;
+    std::vector<std::vector<Device>> devices_;
+    std::map<std::string, size_t> family_index_map_;
+    std::map<std::string, uint32_t> string_offsets_;
+    std::string strings_;
+  };
+
+}
+
+#endif // !DEVICE_DEVICE_DB_H
@@ -0,0 +1,138 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Device fabric: a grid of tiles, the sites of every tile and the BELs of every
+//* site. All objects are addressed by dense integer IDs and stored as parallel
+//* arrays, so iterating over all sites of a large device only walks a few
+//* contiguous buffers.
+//*
+//* Tile and site types are templates: a tile type lists the site types it
+//* contains and a site type lists its BEL names. Instantiated sites of tile t
+//* are [tileSiteBegin(t), tileSiteEnd(t)), the BELs of site s are
+//* [siteBelBegin(s), siteBelEnd(s)).
+//******************************************************************************
+
+#ifndef DEVICE_DEVICE_FABRIC_H
+#define DEVICE_DEVICE_FABRIC_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class DeviceFabric {
+  public:
+    typedef uint32_t TileId;
+    typedef uint32_t SiteId;
+    typedef uint32_t BelId;
+    typedef uint16_t TypeId;
+    static const uint32_t kInvalidId = 0xffffffff;
+    static const TypeId kEmptyTileType = 0;
+
+    // Names of templates, stored back to back in one buffer.
+    class NameTable {
+    public:
+      uint32_t size() const { return static_cast<uint32_t>(offsets_.size()); }
+      const char* name(uint32_t i) const { return chars_.data() + offsets_[i]; }
+      uint32_t add(const std::string& name);
+      // returns kInvalidId if there is no such name
+      uint32_t find(const std::string& name) const;
+      // every name starts in the buffer and is NUL terminated, for loading
+      bool valid() const;
+      void clear() { chars_.clear(); offsets_.clear(); }
+    private:
+      friend class DeviceFabric;
+      friend class RoutingGraph;
+      std::string chars_;
+      std::vector<uint32_t> offsets_;
+    };
+
+  public:
+    DeviceFabric();
+    ~DeviceFabric() {}
+
+    // building, the grid is filled with the empty tile type (ID 0)
+    TypeId addSiteType(const std::string& name, const std::vector<std::string>& bels);
+    TypeId addTileType(const std::string& name, const std::vector<TypeId>& site_types);
+    void resize(int rows, int cols);
+    void setTileType(int row, int col, TypeId type) { tile_types_[tileAt(row, col)] = type; }
+    // instantiates the sites and BELs of all tiles, must be called after the
+    // grid is complete and before any site/BEL query
+    void finalize();
+
+    bool save(const std::string& file_name) const;
+    bool load(const std::string& file_name);
+
+    // templates
+    uint32_t numSiteTypes() const { return site_type_names_.size(); }
+    const char* siteTypeName(TypeId type) const { return site_type_names_.name(type); }
+    TypeId findSiteType(const std::string& name) const;
+    uint32_t numSiteTypeBels(TypeId type) const { return site_type_bel_begin_[type + 1] - site_type_bel_begin_[type]; }
+    const char* belName(TypeId site_type, uint32_t i) const { return bel_names_.name(site_type_bel_begin_[site_type] + i); }
+    uint32_t numTileTypes() const { return tile_type_names_.size(); }
+    const char* tileTypeName(TypeId type) const { return tile_type_names_.name(type); }
+    TypeId findTileType(const std::string& name) const;
+    uint32_t numTileTypeSites(TypeId type) const { return tile_type_site_begin_[type + 1] - tile_type_site_begin_[type]; }
+    TypeId tileTypeSite(TypeId type, uint32_t i) const { return tile_type_sites_[tile_type_site_begin_[type] + i]; }
+
+    // grid
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    uint32_t numTiles() const { return static_cast<uint32_t>(tile_types_.size()); }
+    TileId tileAt(int row, int col) const { return static_cast<TileId>(row) * static_cast<TileId>(cols_) + static_cast<TileId>(col); }
+    int tileRow(TileId tile) const { return static_cast<int>(tile / static_cast<TileId>(cols_)); }
+    int tileCol(TileId tile) const { return static_cast<int>(tile % static_cast<TileId>(cols_)); }
+    TypeId tileType(TileId tile) const { return tile_types_[tile]; }
+    std::string tileName(TileId tile) const;
+    const TypeId* tileTypes() const { return tile_types_.data(); }
+
+    // sites
+    uint32_t numSites() const { return static_cast<uint32_t>(site_tiles_.size()); }
+    SiteId tileSiteBegin(TileId tile) const { return tile_site_begin_[tile]; }
+    SiteId tileSiteEnd(TileId tile) const { return tile_site_begin_[tile + 1]; }
+    TileId siteTile(SiteId site) const { return site_tiles_[site]; }
+    TypeId siteType(SiteId site) const { return site_types_[site]; }
+    uint16_t siteX(SiteId site) const { return site_x_[site]; }
+    uint16_t siteY(SiteId site) const { return site_y_[site]; }
+    std::string siteName(SiteId site) const;
+    const TileId* siteTiles() const { return site_tiles_.data(); }
+    const TypeId* siteTypes() const { return site_types_.data(); }
+
+    // BELs
+    uint32_t numBels() const { return site_bel_begin_.empty() ? 0 : site_bel_begin_.back(); }
+    BelId siteBelBegin(SiteId site) const { return site_bel_begin_[site]; }
+    BelId siteBelEnd(SiteId site) const { return site_bel_begin_[site + 1]; }
+    // BEL name within its site, e.g. "A6LUT"
+    const char* siteBelName(SiteId site, BelId bel) const { return belName(site_types_[site], bel - site_bel_begin_[site]); }
+
+    size_t memoryUsage() const;
+
+  private:
+    void computeSiteCoordinates();
+
+    int rows_;
+    int cols_;
+
+    NameTable site_type_names_;
+    NameTable bel_names_;
+    std::vector<uint32_t> site_type_bel_begin_;
+    NameTable tile_type_names_;
+    std::vector<TypeId> tile_type_sites_;
+    std::vector<uint32_t> tile_type_site_begin_;
+
+    std::vector<TypeId> tile_types_;
+    std::vector<uint32_t> tile_site_begin_;
+
+    std::vector<TileId> site_tiles_;
+    std::vector<TypeId> site_types_;
+    std::vector<uint16_t> site_x_;
+    std::vector<uint16_t> site_y_;
+    std::vector<uint32_t> site_bel_begin_;
+  };
+
+}
+
+#endif // !DEVICE_DEVICE_FABRIC_H
@@ -2,8 +2,11 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
-//* This is only a demo used for how to design the new project wizard pages
+//* Last updated: 2026-10-17
+//* Only the family index is read at startup. The devices of a family are paged
+//* in from the device database on first access and families that have not been
+//* used recently are dropped again once the resident catalogue exceeds the
+//* memory budget.
 //******************************************************************************
 
 #ifndef DEVICE_DEVICE_MANAGER
@@ -11,8 +14,13 @@
 
 #include <string>
 #include <vector>
+#include <list>
 #include <map>
 
+#include "device/device_db.h"
+#include "device/device_fabric.h"
+#include "device/routing_graph.h"
+
 namespace eda {
 
   class DeviceManager {
@@ -24,14 +32,36 @@ namespace eda {
       std::vector<std::string> packages;
       std::vector<std::string> speeds;
     };
-    
+    static const size_t kDefaultMemoryBudget = 4 * 1024 * 1024;
+
   private:
+    class Family {
+    public:
+      Family() : loaded(false), pinned(false), bytes(0) {}
+      std::vector<DeviceDef> devices;
+      bool loaded;
+      // families without a database entry can not be paged in again
+      bool pinned;
+      size_t bytes;
+      std::list<size_t>::iterator lru_pos;
+    };
+
     static DeviceManager* manager_;
     std::vector<std::string> families_;
-    std::vector<std::vector<DeviceDef>> devices_;
+    std::vector<Family> family_data_;
     std::map<std::string, size_t> family_index_map_;
+    // most recently used family first
+    std::list<size_t> lru_;
+    size_t resident_bytes_;
+    size_t memory_budget_;
+    DeviceDatabase database_;
+    // fabric of the device last returned by fabric(), "<family>/<device>"
+    std::string fabric_key_;
+    DeviceFabric fabric_;
+    RoutingGraph routing_graph_;
+    bool routing_graph_built_;
 
-    DeviceManager() {}
+    DeviceManager() : resident_bytes_(0), memory_budget_(kDefaultMemoryBudget), routing_graph_built_(false) {}
     ~DeviceManager() {}
 
   public:
@@ -39,25 +69,45 @@ namespace eda {
       return manager_;
     }
     static void load();
+    // $DB/device/device.db, the catalogue opened by load()
+    static std::string databaseFile();
+    // $DB/device/<family>/<device>.fab
+    static std::string fabricFile(const std::string& family, const std::string& name);
+    // $DB/device/<family>/<device>.rrg, the routing templates of the fabric
+    static std::string routingFile(const std::string& family, const std::string& name);
     static void release() {
       if (manager_ != NULL) delete manager_;
       manager_ = NULL;
     }
-    std::vector<std::string> families() { return families_; }
-    std::vector<std::vector<DeviceDef>> devices() { return devices_; }
-    void addDevice(DeviceDef device) {
-      std::string family = device.family;
-      auto iter = family_index_map_.find(device.family);
-      size_t index = families_.size();
-      if (iter == family_index_map_.end()) {
-        family_index_map_.insert(std::make_pair(family, families_.size()));
-        families_.push_back(family);
-        devices_.push_back(std::vector<DeviceDef>());
-      } else {
-        index = iter->second;
-      }
-      devices_[index].push_back(device);
-    }
+    const std::vector<std::string>& families() const { return families_; }
+    size_t numFamilies() const { return families_.size(); }
+    // returns -1 if there is no such family
+    int familyIndex(const std::string& family) const;
+    // Pages the family in if needed. The returned reference stays valid until
+    // devices() is called for another family.
+    const std::vector<DeviceDef>& devices(size_t family_index);
+    const DeviceDef* device(const std::string& family, const std::string& name);
+    void addDevice(const DeviceDef& device);
+
+    size_t memory_budget() const { return memory_budget_; }
+    void set_memory_budget(size_t bytes);
+    size_t resident_bytes() const { return resident_bytes_; }
+    size_t numResidentFamilies() const { return lru_.size(); }
+    const DeviceDatabase& database() const { return database_; }
+    // Loads the fabric of a device, returns NULL if it is not installed. Only
+    // one fabric is kept, the pointer is invalidated by the next call.
+    const DeviceFabric* fabric(const std::string& family, const std::string& name);
+    // Builds the routing graph of the device on first use, same lifetime as
+    // the fabric.
+    const RoutingGraph* routingGraph(const std::string& family, const std::string& name);
+
+  private:
+    void loadDatabase();
+    void loadBuiltinDevices();
+    void pageIn(size_t family_index);
+    void touch(size_t family_index);
+    void evict(size_t keep_index);
+    static size_t memoryUsage(const DeviceDef& device);
   };
 }
 
@@ -0,0 +1,124 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Routing-resource graph of a device. Every wire of every tile is a node, the
+//* PIPs and the wire connections between tiles are directed edges. The fanout
+//* of node n is what forEachEdge(fabric, n, fn) passes to fn.
+//*
+//* Wires and edges are described once per tile type (templates keyed by the
+//* DeviceFabric tile type ID) in compressed sparse row form. build() only
+//* numbers the nodes tile by tile, edges are resolved from the templates and
+//* the fabric grid when they are read, so the memory stays proportional to
+//* the tile types plus the grid however many edges the device has.
+//******************************************************************************
+
+#ifndef DEVICE_ROUTING_GRAPH_H
+#define DEVICE_ROUTING_GRAPH_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "device/device_fabric.h"
+
+namespace eda {
+
+  class RoutingGraph {
+  public:
+    typedef uint32_t NodeId;
+    typedef uint64_t EdgeId;
+    typedef DeviceFabric::TypeId TypeId;
+    static const NodeId kInvalidNode = 0xffffffff;
+
+    // Edge from wire 'from' of a tile to wire 'to' of the tile at the given
+    // row/column offset, which must be of type 'to_type'. PIPs have a zero
+    // offset.
+    class TemplateEdge {
+    public:
+      uint32_t from;
+      uint32_t to;
+      int16_t drow;
+      int16_t dcol;
+      TypeId to_type;
+      uint16_t reserved;
+    };
+
+  private:
+    class TileTemplate {
+    public:
+      DeviceFabric::NameTable wires;
+      std::vector<TemplateEdge> edges;
+      // per wire, filled by build()
+      std::vector<uint32_t> edge_begin;
+    };
+
+  public:
+    RoutingGraph() : num_edges_(0) {}
+    ~RoutingGraph() {}
+
+    // templates
+    void setTileTypeWires(TypeId tile_type, const std::vector<std::string>& wires);
+    uint32_t numTileTypeWires(TypeId tile_type) const;
+    const char* wireName(TypeId tile_type, uint32_t wire) const { return templates_[tile_type].wires.name(wire); }
+    // returns DeviceFabric::kInvalidId if there is no such wire
+    uint32_t findWire(TypeId tile_type, const std::string& name) const;
+    void addPip(TypeId tile_type, uint32_t from, uint32_t to) { addTemplateEdge(tile_type, from, 0, 0, tile_type, to); }
+    void addTemplateEdge(TypeId tile_type, uint32_t from, int drow, int dcol, TypeId to_type, uint32_t to);
+    bool saveTemplates(const std::string& file_name) const;
+    bool loadTemplates(const std::string& file_name);
+
+    // Numbers the nodes of the fabric grid and counts the edges that stay on
+    // it, the tile rows are counted in parallel. num_threads <= 0 uses all
+    // processors.
+    void build(const DeviceFabric& fabric, int num_threads = 0);
+
+    uint32_t numNodes() const { return tile_node_begin_.empty() ? 0 : tile_node_begin_.back(); }
+    // the edges forEachEdge() passes over all nodes
+    EdgeId numEdges() const { return num_edges_; }
+    // Calls fn(edge, target) for every edge of node that resolves to a node,
+    // template edges that leave the grid or end on a tile of another type
+    // are skipped. An edge is the tile in the high 32 bits and the template
+    // edge of its type in the low ones. The fabric must be the one given to
+    // build().
+    template <typename Fn>
+    void forEachEdge(const DeviceFabric& fabric, NodeId node, Fn fn) const {
+      DeviceFabric::TileId tile = nodeTile(node);
+      const TileTemplate& tmpl = templates_[fabric.tileType(tile)];
+      uint32_t wire = node - tile_node_begin_[tile];
+      int row = fabric.tileRow(tile);
+      int col = fabric.tileCol(tile);
+      NodeId target;
+      for (uint32_t e = tmpl.edge_begin[wire]; e < tmpl.edge_begin[wire + 1]; e++) {
+        if (resolveEdge(fabric, row, col, tmpl.edges[e], target))
+          fn((static_cast<EdgeId>(tile) << 32) | e, target);
+      }
+    }
+    // the target of an edge given by forEachEdge()
+    NodeId edgeTarget(const DeviceFabric& fabric, EdgeId edge) const;
+
+    NodeId tileNodeBegin(DeviceFabric::TileId tile) const { return tile_node_begin_[tile]; }
+    NodeId tileNodeEnd(DeviceFabric::TileId tile) const { return tile_node_begin_[tile + 1]; }
+    // binary search, nodes are numbered tile by tile
+    DeviceFabric::TileId nodeTile(NodeId node) const;
+    uint32_t nodeWire(NodeId node) const { return node - tile_node_begin_[nodeTile(node)]; }
+    // "<tile>/<wire>", e.g. "CLB_X12Y34/A6"
+    std::string nodeName(const DeviceFabric& fabric, NodeId node) const;
+    NodeId findNode(const DeviceFabric& fabric, DeviceFabric::TileId tile, const std::string& wire) const;
+
+    size_t memoryUsage() const;
+
+  private:
+    void compileTemplates();
+    bool resolveEdge(const DeviceFabric& fabric, int row, int col, const TemplateEdge& edge, NodeId& target) const;
+
+    std::vector<TileTemplate> templates_;
+
+    std::vector<NodeId> tile_node_begin_;
+    EdgeId num_edges_;
+  };
+
+}
+
+#endif // !DEVICE_ROUTING_GRAPH_H
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //* class for storing context information for the running command and notify
 //* the current progress of the running command. The running command is supposed
 //* to check the status of the thread it resides regularly using the function
@@ -41,6 +41,7 @@ namespace eda {
     static int min();
     static int max();
     static int range();
+    // not thread safe, parallel workers leave it to the command's thread
     static void setProgress(int);
     static int currentProgress();
     static void setProgressFactor(double);
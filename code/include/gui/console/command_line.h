@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #ifndef GUI_CONSOLE_COMMAND_LINE
 #define GUI_CONSOLE_COMMAND_LINE
@@ -13,6 +13,8 @@
 #include <qlist.h>
 #include <qstring.h>
 #include <qevent.h>
+#include <qcompleter.h>
+#include <qstringlistmodel.h>
 
 namespace eda {
 
@@ -25,6 +27,11 @@ namespace eda {
     MainConsole* main_console_;
     QList<QString> command_list_;
     QList<QString>::iterator current_iter_;
+    // lists the matches of gCompletion for the word at the cursor
+    QCompleter* completer_;
+    QStringListModel* completion_model_;
+    // where that word starts in text()
+    int completion_start_;
 
   public:
     CommandLine(MainConsole* main_console, QWidget* parent);
@@ -42,6 +49,15 @@ namespace eda {
     void keyUp();
     void keyDown();
     void keyEnter();
+    // TAB completes instead of moving the focus
+    bool focusNextPrevChild(bool next);
+    // Lists the matches of the word at the cursor, a TAB also inserts their
+    // common prefix. While typing, only command names pop up by themselves.
+    void complete(bool tab);
+
+  private slots:
+    void insertCompletion(const QString& completion);
+    void onTextEdited(const QString& text);
 
   signals:
     void sigTclCommand(const QString& cmd);
@@ -0,0 +1,70 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Thread that runs the commands of the GUI so the event loop keeps painting
+//* while they execute. The worker owns the Tcl interpreter from start() until
+//* finish() returns, nothing else may evaluate in it during that time. Output
+//* reaches the console through the log queue, progress through the events of
+//* CommandContext and the result of a queued job through a
+//* CommandQueueDoneEvent posted to its receiver.
+//******************************************************************************
+#ifndef GUI_CONSOLE_COMMAND_WORKER_H
+#define GUI_CONSOLE_COMMAND_WORKER_H
+
+#include <tcl.h>
+#include <atomic>
+#include <qobject.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+#include <qqueue.h>
+#include <qstringlist.h>
+
+namespace eda {
+
+  class CommandWorker : public QThread {
+    Q_OBJECT
+  public:
+    CommandWorker(QObject* parent = NULL);
+    ~CommandWorker();
+
+    // Runs the commands one after the other and stops at the first error or
+    // when CommandContext::threadStopped() is set. Every job ends with
+    // LayoutWindow::prepareScene(), a job without commands only does that.
+    // receiver may be NULL if nobody waits for the result.
+    void post(const QStringList& commands, QObject* receiver);
+    // Aborts the running script before its next Tcl command. A C++ command
+    // that is running has to notice CommandContext::threadStopped() itself.
+    void cancel();
+    // Drops the queued jobs, cancels the running one and waits for the
+    // thread, the interpreter belongs to the calling thread again afterwards.
+    void finish();
+    bool busy();
+
+  protected:
+    virtual void run();
+
+  private:
+    class Job {
+    public:
+      QStringList commands;
+      QObject* receiver;
+    };
+
+    static int onCancel(ClientData data, Tcl_Interp* interp, int code);
+    int runJob(const Job& job);
+
+    QMutex mutex_;
+    QWaitCondition work_;
+    QQueue<Job> jobs_;
+    bool stopping_;
+    bool busy_;
+    std::atomic<bool> canceled_;
+    Tcl_AsyncHandler cancel_handler_;
+  };
+
+}
+
+#endif // !GUI_CONSOLE_COMMAND_WORKER_H
@@ -2,37 +2,57 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef GUI_CONSOLE_H
 #define GUI_CONSOLE_H
 
+#include <stdarg.h>
+#include <stdio.h>
 #include <string>
 #include <vector>
 
 namespace eda {
 
   class MainConsole;
+  class LogIndex;
 
   class Console {
+  public:
+    // how startLogFile() writes the log
+    class LogOptions {
+    public:
+      LogOptions() : json(false), compress(false), max_size_mb(0) {}
+      // one JSON object per message with its time, severity, thread and
+      // command instead of the plain text
+      bool json;
+      // gzip, compressed by a background thread
+      bool compress;
+      // a new generation is started after this many MB of text, 0: never
+      int max_size_mb;
+    };
+
   private:
     static MainConsole* console_;
-    static FILE* fp_;
     static std::string logfile_name_;
 
   public:
-    static FILE* fp();
-    static void set_fp(FILE* fp);
     static std::string logfile_name();
     static void set_logfile_name(std::string logfile_name);
     static MainConsole* console_window();
     static void set_console(MainConsole* console);
+    // search index of the open log file, saved next to it by endLogFile(),
+    // compressed logs are not indexed
+    static LogIndex& log_index();
 
   public:
     // In any case, after using the console, we should call
     // Console::done() to make it available again.
     static void done();
+    // Messages are written by a background thread once the log file is
+    // started, flush() waits until everything printed so far is out.
+    static void flush();
     // Print anything on console
     static void print(const char* format, ...);
 
@@ -52,10 +72,18 @@ namespace eda {
     // Print Error message on GUI Error Message Box
     static int printGUIErrorMsg(const char* format, ...);
 
-    // start to write every log message into a file
-    static void startLogFile(std::string log_file);
+    // Start to write every log message into a file. An existing file is
+    // moved aside to the next generation, see App::avoidOverwrite(). A
+    // compressed log gets a ".gz" suffix.
+    static void startLogFile(std::string log_file, const LogOptions& options = LogOptions());
     // close the open log file
     static void endLogFile();
+    // Copies a file into the open log file as it is, without showing it,
+    // e.g. the log of a batch job. False if it can not be read.
+    static bool appendLogFile(const std::string& file_name);
+
+  private:
+    static void write(int type, const char* prefix, const char* format, va_list args);
   };
 
 }
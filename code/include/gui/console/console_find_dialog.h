@@ -0,0 +1,46 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+#ifndef GUI_CONSOLE_FIND_DIALOG_H
+#define GUI_CONSOLE_FIND_DIALOG_H
+
+#include <qobject.h>
+#include <qdialog.h>
+#include <qlineedit.h>
+#include <qcheckbox.h>
+#include <qpushbutton.h>
+#include <qlistwidget.h>
+#include <qlabel.h>
+
+namespace eda {
+
+  // Searches the log file through its index, see LogIndex.
+  class ConsoleFindDialog : public QDialog {
+    Q_OBJECT
+  public:
+    static const int kMaxMatches = 1000;
+
+  private:
+    QLineEdit* pattern_edit_;
+    QCheckBox* regex_box_;
+    QCheckBox* case_box_;
+    QPushButton* find_btn_;
+    QListWidget* result_list_;
+    QLabel* status_label_;
+
+  public:
+    ConsoleFindDialog(QWidget* parent = NULL);
+    ~ConsoleFindDialog();
+
+    void set_pattern(const QString& pattern);
+
+  protected slots:
+    void onFind();
+
+  };
+
+}
+#endif // !GUI_CONSOLE_FIND_DIALOG_H
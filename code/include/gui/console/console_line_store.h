@@ -0,0 +1,90 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Append-only store of the console output. Lines are kept as
+//* <type byte><text>'\n' in chunks of about kChunkSize bytes, only the last
+//* kMaxResidentChunks chunks that were used stay in memory. Older chunks are
+//* written to a scratch file once and read back when their lines are shown
+//* again, the line offsets of a chunk are rebuilt from its text then.
+//******************************************************************************
+
+#ifndef GUI_CONSOLE_LINE_STORE_H
+#define GUI_CONSOLE_LINE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class ConsoleLineStore {
+  public:
+    static const size_t kChunkSize = 1024 * 1024;
+    static const size_t kMaxResidentChunks = 32;
+
+    ConsoleLineStore();
+    ~ConsoleLineStore();
+
+    // Appends the text of one message. The message continues the last line if
+    // that line has no '\n' yet.
+    void append(int type, const char* text, size_t length);
+    void clear();
+
+    uint32_t numLines() const { return num_lines_; }
+    // text of the line without '\n', false if index is out of range
+    bool line(uint32_t index, std::string& text, int& type);
+    // lines where the messages of a type start, only kept for the types
+    // given to set_indexed_types()
+    const std::vector<uint32_t>& messageLines(int type) const;
+    void set_indexed_types(int warn_type, int error_type) {
+      warn_type_ = warn_type;
+      error_type_ = error_type;
+    }
+    // longest line seen so far, in bytes
+    size_t max_line_length() const { return max_line_length_; }
+    // bytes of text and line offsets in memory
+    size_t residentBytes() const;
+
+  private:
+    ConsoleLineStore(const ConsoleLineStore&);
+    ConsoleLineStore& operator=(const ConsoleLineStore&);
+
+    class Chunk {
+    public:
+      uint32_t first_line;
+      uint32_t num_lines;
+      // offset in the scratch file, -1 until written
+      int64_t file_offset;
+      size_t size;
+      uint64_t last_use;
+      std::vector<char> text;
+      std::vector<uint32_t> line_starts;
+    };
+
+    size_t findChunk(uint32_t line) const;
+    bool load(Chunk& chunk);
+    void evict();
+    void startLine(int type);
+
+    std::vector<Chunk> chunks_;
+    uint32_t num_lines_;
+    // the last line has no '\n' yet
+    bool line_open_;
+    size_t line_length_;
+    size_t max_line_length_;
+    size_t num_resident_;
+    uint64_t use_clock_;
+    FILE* spill_;
+    int warn_type_;
+    int error_type_;
+    std::vector<uint32_t> warn_lines_;
+    std::vector<uint32_t> error_lines_;
+  };
+
+}
+
+#endif // !GUI_CONSOLE_LINE_STORE_H
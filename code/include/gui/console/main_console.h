@@ -2,60 +2,113 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 //******************************************************************************
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #ifndef GUI_MAIN_CONSOLE_H
 #define GUI_MAIN_CONSOLE_H
 
 #include <qobject.h>
 #include <qlineedit.h>
-#include <qtextbrowser.h>
+#include <qabstractscrollarea.h>
+#include <qbytearray.h>
+#include <qmutex.h>
+#include <qtimer.h>
 
 #include <qstringlist.h>
 #include <qlist.h>
 #include <qstring.h>
 
 #include "gui/main_event.h"
+#include "gui/console/console_line_store.h"
 
 namespace eda {
 
   class CommandExecutor;
+  class ConsoleFindDialog;
 
-  class MainConsole : public QTextBrowser {
+  // Console window. The output lives in a ConsoleLineStore and only the
+  // visible lines are laid out and painted, selection works on whole lines.
+  class MainConsole : public QAbstractScrollArea {
     Q_OBJECT
   public:
     static QColor fontColor;
     static QColor warnColor;
     static QColor errColor;
     static QColor debugColor;
+    // pending output is inserted at most once per interval
+    static const int kFlushIntervalMs = 20;
+    // characters of a line painted at most
+    static const int kMaxPaintedChars = 2048;
 
   private:
+    // consecutive messages of one type, appended to the store in one flush
+    class OutputRun {
+    public:
+      int type;
+      QByteArray text;
+      // of each message in text, the store counts warnings and errors per
+      // message
+      QList<int> lengths;
+    };
+
+    QMutex pending_mutex_;
+    QList<OutputRun> pending_;
+    // a CONSOLE_BATCH event is on its way
+    bool pending_posted_;
+    QTimer flush_timer_;
+
+    ConsoleLineStore store_;
+    // selected lines, -1 if none
+    int64_t select_anchor_;
+    int64_t select_end_;
+
     CommandExecutor* executor_;
+    ConsoleFindDialog* find_dialog_;
     QAction* copy_text_;
+    QAction* find_;
     QAction* view_log_;
     QAction* clear_;
-    QStringList warning_list_;
-    QStringList error_list_;
+    QAction* stop_;
 
   public:
     MainConsole(QWidget* parent = NULL);
     virtual ~MainConsole();
 
   public:
-    QStringList warnings() { return warning_list_; }
-    QStringList errors() { return error_list_; }
+    int numWarnings() const { return static_cast<int>(store_.messageLines(CONSOLE_WARN).size()); }
+    int numErrors() const { return static_cast<int>(store_.messageLines(CONSOLE_ERROR).size()); }
+    // first line of a warning or error message
+    QString warning(int index);
+    QString error(int index);
 
     void appendOutput(const QString& message, const int output_type = CONSOLE_INFO);
-    void setCursorEnd();
+    // Queues a message for the next flush, may be called from any thread.
+    void postOutput(const int output_type, const char* text, const size_t length);
+    void scrollToEnd();
+    void clear();
     void run(const QString& cmd);
   protected:
     virtual void customEvent(QEvent* event);
+    virtual void paintEvent(QPaintEvent* event);
+    virtual void resizeEvent(QResizeEvent* event);
+    virtual void mousePressEvent(QMouseEvent* event);
+    virtual void mouseMoveEvent(QMouseEvent* event);
+    virtual void keyPressEvent(QKeyEvent* event);
+
+  private:
+    QString lineText(uint32_t index);
+    int lineHeight() const;
+    int visibleLines() const;
+    int64_t lineAt(int y) const;
+    void updateScrollBars();
+    // emits the changed counts and follows the output if the view was at the end
+    void outputAppended(int num_warnings, int num_errors, bool at_end);
 
   signals:
     void warningsCountChanged(int);
@@ -67,7 +120,10 @@ namespace eda {
 
   protected slots:
     void onCopy();
+    void onFind();
     void onClear();
+    void onStop();
+    void onFlushOutput();
 
   };
 
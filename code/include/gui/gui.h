@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #ifndef GUI_GUI_H
 #define GUI_GUI_H
@@ -18,6 +18,7 @@ namespace eda {
 
   class MainApp;
   class MainWindow;
+  class CommandWorker;
 
   class Gui {
   private:
@@ -25,6 +26,7 @@ namespace eda {
 
     static MainApp* main_app_;
     static Tcl_Interp* interp_;
+    static CommandWorker* command_worker_;
 
     static bool gui_mode_;
     static QSettings* setting_;
@@ -40,7 +42,14 @@ namespace eda {
 
     static void set_interp(Tcl_Interp* interp) { interp_ = interp; }
     static Tcl_Interp* interp() { return interp_; }
+    // owns the interpreter while the main window is open
+    static CommandWorker* command_worker() { return command_worker_; }
     static int executeCmd(QString cmd, const bool print_relsult = false);
+    // Checks a command on the GUI thread and adds it to the history, false
+    // if it is not to be evaluated.
+    static bool prepareCmd(const QString& cmd);
+    // Evaluates a prepared command on the thread that owns the interpreter.
+    static int evalCmd(const QString& cmd, const bool print_result = false);
     static QSettings* setting() { return setting_; }
 
 
@@ -0,0 +1,92 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Highlighted nets, cells, tiles and tile regions drawn by the FabricView on
+//* top of the raster tiles. Highlights are kept by name and resolved against
+//* the scene, every change reports the area it touches so the view repaints
+//* only that part and composites the cached tiles there again, the tiles are
+//* never drawn anew. The highlights sit in a PackedRTree that takes the edits
+//* one by one, so a paint only visits the ones in its area. GUI thread only.
+//******************************************************************************
+
+#ifndef GUI_LAYOUT_FABRIC_OVERLAY_H
+#define GUI_LAYOUT_FABRIC_OVERLAY_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gui/layout/fabric_scene.h"
+#include "utility/packed_rtree.h"
+
+namespace eda {
+
+  class FabricOverlay {
+  public:
+    enum Kind {
+      kNet,
+      kCell,
+      kTile,
+      // "<x0> <y0> <x1> <y1>" in the X and Y of the tile names
+      kRegion
+    };
+
+    class Item {
+    public:
+      Kind kind;
+      std::string name;
+      // ARGB
+      uint32_t color;
+      // nets: the segments in the scene, the others: the outlined box
+      uint32_t segment_begin;
+      uint32_t segment_end;
+      PackedRTree::Box box;
+      PackedRTree::Box bounds;
+      bool used;
+    };
+
+    FabricOverlay();
+    ~FabricOverlay() {}
+
+    // resolves all highlights on a new scene, the ones it does not have are
+    // dropped
+    void setScene(const std::shared_ptr<const FabricScene>& scene);
+
+    // Adds a highlight or changes its color. Returns false if the scene has
+    // no such object, otherwise dirty is the area to repaint.
+    bool highlight(Kind kind, const std::string& name, uint32_t color, PackedRTree::Box& dirty);
+    bool unhighlight(Kind kind, const std::string& name, PackedRTree::Box& dirty);
+    void clear();
+
+    uint32_t size() const { return static_cast<uint32_t>(by_key_.size()); }
+    // the highlights intersecting box
+    void find(const PackedRTree::Box& box, std::vector<uint32_t>& items) const;
+    const Item& item(uint32_t i) const { return items_[i]; }
+
+  private:
+    FabricOverlay(const FabricOverlay&);
+    FabricOverlay& operator=(const FabricOverlay&);
+
+    static std::string key(Kind kind, const std::string& name);
+    bool resolve(Item& item);
+    uint32_t findNet(const std::string& name);
+    uint32_t findCell(const std::string& name);
+
+    std::shared_ptr<const FabricScene> scene_;
+    std::vector<Item> items_;
+    // unused slots of items_
+    std::vector<uint32_t> free_;
+    std::unordered_map<std::string, uint32_t> by_key_;
+    PackedRTree index_;
+    // IDs of the scene sorted by name, built on the first lookup
+    std::vector<uint32_t> nets_by_name_;
+    std::vector<uint32_t> cells_by_name_;
+  };
+
+}
+
+#endif // !GUI_LAYOUT_FABRIC_OVERLAY_H
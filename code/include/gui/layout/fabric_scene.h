@@ -0,0 +1,168 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Drawing model of a device for the fabric view: the tile grid, the sites of
+//* every tile, the cells placed on them and the routing of the design as
+//* segments between the tiles of consecutive PIPs. A scene is immutable once
+//* built, so the render threads read it without locks.
+//*
+//* The device is drawn as a pyramid of raster tiles of kTileSize pixels.
+//* Level 0 draws a device tile with kMaxPixelsPerTile pixels, every further
+//* level halves that, down to the level that holds the whole device in one
+//* raster tile. Coarse levels average the tiles under each pixel instead of
+//* sampling them, so single columns of BRAM or DSP tiles do not flicker.
+//*
+//* Routing has three levels of detail. Below kLinePixels the number of nets
+//* through every tile is drawn as a heatmap. Up to kDetailPixels every net is
+//* a polyline simplified to kSimplifyPixels of the level, with the segments
+//* that several nets share drawn once. From kDetailPixels on every segment is
+//* drawn and the tiles holding PIPs are marked. All of it is prepared as flat
+//* segment arrays when the scene is built and rasterized on the render
+//* threads, the GUI thread only composites finished tiles.
+//*
+//* Positions are in device tile units, tile (row, col) covers [col, col + 1)
+//* x [row, row + 1). Tiles, sites and BELs are found from the grid, the
+//* routing segments through packed R-trees that also cull them for every
+//* raster tile.
+//******************************************************************************
+
+#ifndef GUI_LAYOUT_FABRIC_SCENE_H
+#define GUI_LAYOUT_FABRIC_SCENE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "device/device_fabric.h"
+#include "utility/packed_rtree.h"
+
+namespace eda {
+
+  class Design;
+
+  class FabricScene {
+  public:
+    static const int kTileSize = 256;
+    static const int kMaxPixelsPerTile = 32;
+    // sites are drawn from this size on, routing as lines from kLinePixels
+    // and with all PIPs from kDetailPixels
+    static const int kSitePixels = 16;
+    static const int kLinePixels = 4;
+    static const int kDetailPixels = 16;
+    // tolerance of the simplified routing, in pixels of the level
+    static const int kSimplifyPixels = 2;
+    static const uint32_t kBackground = 0xff202020;
+    static const uint32_t kInvalidId = DeviceFabric::kInvalidId;
+
+    // segment between the centers of two device tiles, net is kInvalidId
+    // where several nets share a simplified segment
+    class Segment {
+    public:
+      uint16_t col0;
+      uint16_t row0;
+      uint16_t col1;
+      uint16_t row1;
+      uint32_t net;
+    };
+    // the objects under a position, kInvalidId where there is none
+    class Hit {
+    public:
+      Hit() : tile(kInvalidId), site(kInvalidId), bel(kInvalidId), segment(kInvalidId) {}
+      uint32_t tile;
+      uint32_t site;
+      uint32_t bel;
+      uint32_t segment;
+    };
+
+    // design may be NULL, parts of it that do not match the fabric are skipped
+    FabricScene(const DeviceFabric& fabric, const Design* design);
+    ~FabricScene() {}
+
+    // a copy, the fabric of DeviceManager may be replaced while the scene is
+    // drawn
+    const DeviceFabric& fabric() const { return fabric_; }
+    int rows() const { return fabric_.rows(); }
+    int cols() const { return fabric_.cols(); }
+    int numLevels() const { return num_levels_; }
+    static double pixelsPerTile(int level) { return static_cast<double>(kMaxPixelsPerTile) / static_cast<double>(1 << level); }
+    // raster tiles of a level
+    int levelCols(int level) const;
+    int levelRows(int level) const;
+
+    uint32_t numUsedSites() const { return num_used_sites_; }
+    // name of the cell placed on a site, NULL if there is none
+    const char* siteCell(uint32_t site) const;
+    // the placed cells
+    uint32_t numCells() const { return cell_names_.size(); }
+    const char* cellName(uint32_t cell) const { return cell_names_.name(cell); }
+    uint32_t cellSite(uint32_t cell) const { return cell_sites_[cell]; }
+    // tile of a name like "CLBLL_L_X2Y10", kInvalidId if it is off the grid
+    uint32_t findTile(const std::string& name) const;
+    uint32_t numSegments() const { return static_cast<uint32_t>(segments_.size()); }
+    // segments drawn on a level, fewer than numSegments() where the routing
+    // is simplified
+    uint32_t numLevelSegments(int level) const;
+    const Segment& segment(uint32_t i) const { return segments_[i]; }
+    // the routed nets, the segments of a net are [begin, end)
+    uint32_t numNets() const { return net_names_.size(); }
+    const char* netName(uint32_t net) const { return net_names_.name(net); }
+    void netSegments(uint32_t net, uint32_t& begin, uint32_t& end) const;
+
+    // Resolves a position, the routing segment is the nearest one within
+    // tolerance.
+    Hit pick(double x, double y, double tolerance) const;
+    // the outline of the smallest object of a hit
+    PackedRTree::Box bounds(const Hit& hit) const;
+    // e.g. "CLBLL_L_X2Y10 / SLICE_X0Y10 / A6LUT, cell u0/q_reg, net n12"
+    std::string describe(const Hit& hit) const;
+    // the segments intersecting a box
+    void findSegments(const PackedRTree::Box& box, std::vector<uint32_t>& segments) const { segment_index_.search(box, segments); }
+
+    // Draws raster tile (x, y) of a level into kTileSize x kTileSize ARGB
+    // pixels, stride is in pixels. Thread safe.
+    void render(int level, int x, int y, uint32_t* pixels, int stride) const;
+
+  private:
+    FabricScene(const FabricScene&);
+    FabricScene& operator=(const FabricScene&);
+
+    class RouteLayer {
+    public:
+      std::vector<Segment> segments;
+      PackedRTree index;
+    };
+
+    void addDesign(const Design& design);
+    void renderTiles(int ppt, int col0, int row0, uint32_t* pixels, int stride) const;
+    void renderAveraged(int step, int col0, int row0, uint32_t* pixels, int stride) const;
+    void renderSegments(const std::vector<Segment>& segments, const PackedRTree& index, double ppt, double col0, double row0, uint32_t* pixels, int stride) const;
+    void renderPips(int ppt, int col0, int row0, uint32_t* pixels, int stride) const;
+    uint32_t tileColor(uint32_t tile) const;
+    uint32_t usageColor(uint32_t color, uint32_t tile) const;
+    PackedRTree::Box siteBounds(uint32_t site) const;
+
+    DeviceFabric fabric_;
+    int num_levels_;
+    std::vector<uint32_t> type_colors_;
+    // index into cell_names_ per site and back
+    std::vector<uint32_t> site_cells_;
+    DeviceFabric::NameTable cell_names_;
+    std::vector<uint32_t> cell_sites_;
+    uint32_t num_used_sites_;
+    // nets routed through each tile
+    std::vector<uint16_t> tile_usage_;
+    uint16_t max_usage_;
+    // the full routing
+    std::vector<Segment> segments_;
+    DeviceFabric::NameTable net_names_;
+    PackedRTree segment_index_;
+    // the simplified routing per level, empty on the levels drawing the full
+    // routing or none
+    std::vector<RouteLayer> simplified_;
+  };
+
+}
+
+#endif // !GUI_LAYOUT_FABRIC_SCENE_H
@@ -0,0 +1,101 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Draws the raster tiles of a FabricScene on a pool of threads and keeps the
+//* finished ones as pixmaps in an LRU cache bounded by memory. The view asks
+//* for the tiles of every frame with request(), which replaces the tiles
+//* still waiting from earlier frames, and repaints on tileReady(). Tiles of
+//* an earlier scene that arrive after setScene() are dropped.
+//******************************************************************************
+
+#ifndef GUI_LAYOUT_FABRIC_TILE_RENDERER_H
+#define GUI_LAYOUT_FABRIC_TILE_RENDERER_H
+
+#include <list>
+#include <memory>
+#include <qobject.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qwaitcondition.h>
+#include <qhash.h>
+#include <qset.h>
+#include <qvector.h>
+#include <qpixmap.h>
+
+#include "gui/layout/fabric_scene.h"
+
+namespace eda {
+
+  class FabricTileRenderer : public QObject {
+    Q_OBJECT
+  public:
+    static const size_t kDefaultCacheBytes = 256 * 1024 * 1024;
+
+    FabricTileRenderer(QObject* parent = NULL);
+    ~FabricTileRenderer();
+
+    static quint64 tileKey(int level, int x, int y) {
+      return (static_cast<quint64>(level) << 48) | (static_cast<quint64>(y) << 24) | static_cast<quint64>(x);
+    }
+
+    const std::shared_ptr<const FabricScene>& scene() const { return scene_; }
+    // drops the cache and all pending tiles
+    void setScene(const std::shared_ptr<const FabricScene>& scene);
+    // NULL if the tile is not cached, marks it as recently used
+    const QPixmap* tile(quint64 key);
+    // Tiles to draw, most important first. Replaces all tiles not started
+    // yet, tiles that are cached or being drawn are skipped.
+    void request(const QVector<quint64>& keys);
+
+    size_t cache_bytes() const { return cache_bytes_; }
+    void set_max_cache_bytes(size_t bytes);
+
+  signals:
+    void tileReady();
+
+  protected:
+    virtual void customEvent(QEvent* event);
+
+  private:
+    class RenderThread : public QThread {
+    public:
+      RenderThread(FabricTileRenderer* renderer) : renderer_(renderer) {}
+    protected:
+      virtual void run() { renderer_->work(); }
+    private:
+      FabricTileRenderer* renderer_;
+    };
+    class CacheEntry {
+    public:
+      QPixmap pixmap;
+      std::list<quint64>::iterator lru_pos;
+    };
+
+    void work();
+    void evict();
+
+    std::shared_ptr<const FabricScene> scene_;
+    QVector<RenderThread*> threads_;
+
+    // shared with the render threads
+    QMutex mutex_;
+    QWaitCondition work_;
+    QVector<quint64> pending_;
+    QSet<quint64> drawing_;
+    std::shared_ptr<const FabricScene> work_scene_;
+    int generation_;
+    bool stopping_;
+
+    // GUI thread only
+    QHash<quint64, CacheEntry> cache_;
+    // most recently used first
+    std::list<quint64> lru_;
+    size_t cache_bytes_;
+    size_t max_cache_bytes_;
+  };
+
+}
+
+#endif // !GUI_LAYOUT_FABRIC_TILE_RENDERER_H
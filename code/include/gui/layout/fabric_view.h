@@ -0,0 +1,101 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Pan and zoom view of a FabricScene. A frame only composites cached raster
+//* tiles of the level closest to the zoom, tiles that are not drawn yet are
+//* covered by a coarser cached level until FabricTileRenderer delivers them.
+//* Drag with the left button to pan, the wheel zooms around the cursor and F
+//* fits the device into the view. Positions under the cursor and clicks are
+//* reported in device coordinates, see FabricScene::pick(). Highlights and
+//* the selection only repaint the area they cover, see FabricOverlay.
+//******************************************************************************
+
+#ifndef GUI_LAYOUT_FABRIC_VIEW_H
+#define GUI_LAYOUT_FABRIC_VIEW_H
+
+#include <memory>
+#include <qwidget.h>
+#include <qpoint.h>
+#include <qrect.h>
+#include <qcolor.h>
+
+#include "gui/layout/fabric_overlay.h"
+#include "gui/layout/fabric_scene.h"
+
+class QPainter;
+
+namespace eda {
+
+  class FabricTileRenderer;
+
+  class FabricView : public QWidget {
+    Q_OBJECT
+  public:
+    FabricView(QWidget* parent = NULL);
+    ~FabricView();
+
+    const std::shared_ptr<const FabricScene>& scene() const;
+    void setScene(const std::shared_ptr<const FabricScene>& scene);
+
+    // screen pixels per device tile
+    double scale() const { return scale_; }
+    // pyramid level of the last frame
+    int level() const { return level_; }
+    double frame_ms() const { return frame_ms_; }
+    // device tile coordinates under a point of the widget
+    QPointF toDevice(const QPoint& pos) const;
+    // outlined on top of the tiles, in device coordinates, empty for none
+    void setSelection(const QRectF& selection);
+
+    const FabricOverlay& overlay() const { return overlay_; }
+    // false if the scene has no such object
+    bool highlight(FabricOverlay::Kind kind, const QString& name, const QColor& color);
+    bool unhighlight(FabricOverlay::Kind kind, const QString& name);
+    void clearHighlights();
+
+  public slots:
+    void fit();
+    void zoomIn();
+    void zoomOut();
+
+  signals:
+    void frameDrawn();
+    void hovered(const QPointF& pos);
+    void clicked(const QPointF& pos);
+
+  protected:
+    virtual void paintEvent(QPaintEvent* event);
+    virtual void mousePressEvent(QMouseEvent* event);
+    virtual void mouseMoveEvent(QMouseEvent* event);
+    virtual void mouseReleaseEvent(QMouseEvent* event);
+    virtual void wheelEvent(QWheelEvent* event);
+    virtual void keyPressEvent(QKeyEvent* event);
+    virtual void leaveEvent(QEvent* event);
+
+  private:
+    void zoomAt(const QPoint& pos, double factor);
+    bool drawCoarser(QPainter& painter, const FabricScene& scene, int level, int x, int y, const QRect& target);
+    void drawOverlay(QPainter& painter, const FabricScene& scene, const QRect& clip);
+    QRectF toScreen(const QRectF& rect) const;
+    // repaints the widget area of a box in device coordinates
+    void updateDevice(const QRectF& rect);
+
+    FabricTileRenderer* renderer_;
+    double scale_;
+    // device coordinates of the top left corner of the widget
+    QPointF origin_;
+    bool dragging_;
+    QPoint drag_pos_;
+    // a release close to the press is a click
+    QPoint press_pos_;
+    QRectF selection_;
+    FabricOverlay overlay_;
+    int level_;
+    double frame_ms_;
+  };
+
+}
+
+#endif // !GUI_LAYOUT_FABRIC_VIEW_H
@@ -1,34 +1,79 @@
-
 //******************************************************************************
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
-//* This is only a demo used for how to design a QT window used in the Multiple
-//* Document Interface of this desktop software framework.
+//* Last updated: 2026-10-17
+//* Device Browser: shows the device of the project with the placement and
+//* routing of the current design in a FabricView. The scene is built on the
+//* CommandWorker after its jobs, the only thread that may read the design and
+//* the device manager, and only if the device or the design changed. The
+//* windows pick it up through kEventSceneReady. The status bar
+//* names the tile, site and BEL under the cursor, a click selects the object
+//* and prints it to the console. The highlight and unhighlight commands reach
+//* the view through kEventHighlightChanged.
 //******************************************************************************
 
 #ifndef GUI_LAYOUT_LAYOUT_WINDOW_H
 #define GUI_LAYOUT_LAYOUT_WINDOW_H
 
+#include <stdint.h>
+#include <memory>
 #include <qobject.h>
+#include <qmutex.h>
 #include <qlabel.h>
 #include <qtreewidget.h>
-#include <qgraphicsscene.h>
 #include <qmainwindow.h>
+#include <qmap.h>
+#include <qvariant.h>
 
 namespace eda {
 
+  class Design;
+  class FabricScene;
+  class FabricView;
+
   class LayoutWindow : public QMainWindow {
   Q_OBJECT
   public:
     LayoutWindow(QWidget* parent = NULL);
+    ~LayoutWindow();
+
+    FabricView* fabric_view() { return fabric_view_; }
+    // shows the scene prepareScene() built last
+    void reload();
+    // Builds the scene again if a Device Browser is open and its device or
+    // the design changed, then broadcasts kEventSceneReady. Called by the
+    // CommandWorker after every job, it reads no Project.
+    static void prepareScene();
 
   protected:
     void initializeSideBar();
+    virtual void customEvent(QEvent* event);
+    void highlight(const QMap<const char*, QVariant>& attributes);
+
+  protected slots:
+    void onFrameDrawn();
+    void onHovered(const QPointF& pos);
+    void onClicked(const QPointF& pos);
 
   private:
     QLabel* statusLabel_;
+    QLabel* frame_label_;
+    FabricView* fabric_view_;
+    QString device_key_;
+
+    // the device to show, copied from the project on the GUI thread
+    static QMutex scene_mutex_;
+    static QString scene_family_;
+    static QString scene_device_;
+    // the scene of prepareScene() and what it was built from
+    static std::shared_ptr<const FabricScene> scene_;
+    static QString scene_key_;
+    static QString scene_status_;
+    static const Design* scene_design_;
+    static uint32_t scene_instances_;
+    static uint32_t scene_pips_;
+    static int num_windows_;
   };
 
 }
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef GUI_MAIN_EVENT_H
@@ -10,7 +10,9 @@
 
 #include <qstring.h>
 #include <qevent.h>
+#include <qimage.h>
 #include <qobject.h>
+#include <qmutex.h>
 
 namespace eda {
 
@@ -21,6 +23,10 @@ namespace eda {
 #define CONSOLE_WARN 2
 #define CONSOLE_ERROR 3
 #define CONSOLE_DEBUG 4
+// eda_print, terminal and log file only
+#define CONSOLE_PRINT 5
+// output is pending in MainConsole::postOutput()
+#define CONSOLE_BATCH 6
 
   const int PROGRESS_STARTED = QEvent::Type(QEvent::MaxUser - 1);
   const int PROGRESS_UPDATED = QEvent::Type(QEvent::MaxUser - 2);
@@ -31,6 +37,8 @@ namespace eda {
   const QEvent::Type CMD_EXECUTED = QEvent::Type(QEvent::MaxUser - 7);
   const QEvent::Type CMD_FINISHED = QEvent::Type(QEvent::MaxUser - 8);
   const QEvent::Type LOADING_COMPLETED = QEvent::Type(QEvent::MaxUser - 9);
+  const QEvent::Type CMD_QUEUE_DONE = QEvent::Type(QEvent::MaxUser - 10);
+  const QEvent::Type FABRIC_TILE_RENDERED = QEvent::Type(QEvent::MaxUser - 11);
 
   static const int global_event_type = QEvent::registerEventType();
 
@@ -44,10 +52,20 @@ namespace eda {
       kEventCommandFinish, 
       kEventChipSelected,
       kEventBusyLocked,
-      kEventLabelWorkFinish
+      kEventLabelWorkFinish,
+      // an object of the layout was highlighted or unhighlighted
+      kEventHighlightChanged,
+      // LayoutWindow::prepareScene() built a new scene
+      kEventSceneReady
     };
   public:
     static const char* key_result;
+    // kEventHighlightChanged: "net", "cell", "tile", "region" or "all", its
+    // name, the color and false to unhighlight
+    static const char* key_object_type;
+    static const char* key_object_name;
+    static const char* key_color;
+    static const char* key_highlight;
   private:
     EventId id_;
     void* sender_;
@@ -69,6 +87,10 @@ namespace eda {
     Q_OBJECT
   private:
     static EventDispatcher* instance_;
+    // Commands broadcast from the CommandWorker while the GUI thread
+    // subscribes and cleans up. Events are posted under the lock, so an
+    // object is never posted to once cleanup() removed it.
+    QMutex mutex_;
     std::map<GlobalEvent::EventId, std::list<QObject*>> event_object_map_;
   public:
     EventDispatcher();
@@ -127,5 +149,30 @@ namespace eda {
     QString cmd_;
   };
 
+  // the commands posted to the CommandWorker are done
+  class CommandQueueDoneEvent : public QEvent {
+  public:
+    CommandQueueDoneEvent(int result) : QEvent(CMD_QUEUE_DONE), result_(result) {}
+    int result() const { return result_; }
+
+  private:
+    int result_;
+  };
+
+  // a raster tile drawn by a thread of the FabricTileRenderer
+  class FabricTileEvent : public QEvent {
+  public:
+    FabricTileEvent(quint64 key, int generation, const QImage& image) :
+      QEvent(FABRIC_TILE_RENDERED), key_(key), generation_(generation), image_(image) {}
+    quint64 key() const { return key_; }
+    int generation() const { return generation_; }
+    const QImage& image() const { return image_; }
+
+  private:
+    quint64 key_;
+    int generation_;
+    QImage image_;
+  };
+
 }
 #endif // !GUI_MAIN_EVENT_H
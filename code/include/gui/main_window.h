@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #ifndef GUI_MAIN_WINDOW_H
 #define GUI_MAIN_WINDOW_H
@@ -12,6 +12,7 @@
 #include <qmainwindow.h>
 #include <qmdiarea.h>
 #include <qurl.h>
+#include <qprogressbar.h>
 
 #include "gui/gui_utility.h"
 
@@ -47,6 +48,8 @@ namespace eda {
     CommandLine* command_line() { return command_line_; }
 
     void setCurrentProject(Project* project);
+    // progress of the running command in the status bar, hidden for value < 0
+    void showProgress(int min, int max, int value);
 
   protected:
 
@@ -83,6 +86,7 @@ namespace eda {
     QTabWidget* console_tab_;
     CommandLine* command_line_;
     QDockWidget* dock_console_;
+    QProgressBar* progress_bar_;
 
     QString init_path_;
     QTabWidget* main_tab_;
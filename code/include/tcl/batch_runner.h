@@ -0,0 +1,77 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Runs independent Tcl scripts side by side from one start of the program.
+//* The Tcl library is built without threads and the commands keep their
+//* state in globals, so every job gets its own interpreter in a process
+//* forked after the device database is opened: the catalogue and the mapped
+//* database pages are shared, and each job works in its own directory
+//* <dir>/<job> with its own job.log, stdout.txt and result.txt. Once all jobs
+//* are done their logs are copied into the main log one job after the other.
+//******************************************************************************
+
+#ifndef TCL_BATCH_RUNNER_H
+#define TCL_BATCH_RUNNER_H
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gui/console/console.h"
+
+namespace eda {
+
+  class BatchRunner {
+  public:
+    class Job {
+    public:
+      Job() : exit_code(-1), elapsed_ms(0), peak_kb(0) {}
+      std::string name;
+      std::string script;
+      // set as global Tcl variables before the script is sourced
+      std::vector<std::pair<std::string, std::string> > parameters;
+      // -1 if the job did not run or was killed
+      int exit_code;
+      int64_t elapsed_ms;
+      uint32_t peak_kb;
+      // the result of the script
+      std::string result;
+    };
+
+    BatchRunner();
+
+    // Reads a job per line: "<script> [<name>=<value> ...]", # starts a
+    // comment.
+    bool readJobs(const std::string& jobs_file);
+    // Adds a job per combination of the sweeps, each is "<name>=<first>..<last>"
+    // for integers or "<name>=<value>,<value>,...".
+    bool addSweep(const std::string& script, const std::vector<std::string>& sweeps);
+
+    void set_num_parallel(int num_parallel) { num_parallel_ = num_parallel; }
+    void set_dir(const std::string& dir) { dir_ = dir; }
+    const std::vector<Job>& jobs() const { return jobs_; }
+
+    // Runs the jobs, at most num_parallel at a time, numProcessors() if it is
+    // not set. Has to be called before the process starts any thread, the
+    // jobs are forked from it. Returns the number of failed jobs.
+    int run(const Console::LogOptions& log_options);
+    // Copies the job logs into the open log file and prints a summary, also
+    // written to <dir>/results.csv.
+    void report();
+
+  private:
+    std::string jobDir(const Job& job) const;
+    // the forked process, returns its exit code
+    int runJob(const Job& job, const Console::LogOptions& log_options);
+
+    std::vector<Job> jobs_;
+    int num_parallel_;
+    std::string dir_;
+  };
+
+}
+
+#endif // !TCL_BATCH_RUNNER_H
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef TCL_COMMAND_H
@@ -10,7 +10,7 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <tcl.h>
 #include "utility/time.h"
 
@@ -26,9 +26,18 @@ namespace eda {
       std::string regex;
     };
 
+    // what postRun() reports about a command
+    enum ProfileLevel {
+      PROFILE_OFF,
+      PROFILE_TIMING,
+      // timing and memory
+      PROFILE_MEMORY
+    };
+
     Commands() {
       memory_begin_ = 0;
-      verbose_ = true;
+      memory_sampled_ = false;
+      profile_level_ = PROFILE_MEMORY;
     }
     ~Commands() {}
 
@@ -46,22 +55,17 @@ namespace eda {
       else
         return "";
     }
-    std::vector<Option> command_options(const std::string& cmd) {
-      std::map<std::string, std::vector<Option>>::iterator iter = cmd_opts_.find(cmd);
-      if (iter != cmd_opts_.end()) {
-        return iter->second;
-      }
-      else {
-        return std::vector<Option>();
-      }
+    const std::vector<Option>& command_options(const std::string& cmd) const {
+      static const std::vector<Option> kNoOptions;
+      const CommandSpec* spec = findSpec(cmd);
+      return spec != NULL ? spec->options : kNoOptions;
     }
-    void set_verbose(const bool verbose) { verbose_ = verbose; }
-    CommandFunction getCmdFunction(const std::string& cmd_name) {
-      std::map<std::string, CommandFunction>::iterator iter = cmds_map_.find(cmd_name);
-      if (iter != cmds_map_.end()) {
-        return iter->second;
-      }
-      return NULL;
+    // only called by the set_verbose command
+    void set_verbose(const ProfileLevel level) { profile_level_ = level; }
+    ProfileLevel profile_level() const { return profile_level_; }
+    CommandFunction getCmdFunction(const std::string& cmd_name) const {
+      const CommandSpec* spec = findSpec(cmd_name);
+      return spec != NULL ? spec->function : NULL;
     }
     static void init(int argc, char* argv[]);
     static Tcl_Interp* interp() { return interp_; }
@@ -101,21 +105,59 @@ namespace eda {
     bool checkArguments(int objc, Tcl_Obj* const objv[]);
     std::string visibleOption(const std::string cmd_name, const std::string opt_name = "") const;
   private:
+    // The value spec of an option, compiled once by register_cmd():
+    //   -opt                 no value
+    //   -opt <string>        any non-empty value
+    //   -opt <int> <double>  one field of each type
+    //   -opt a|b|c           words out of the list
+    // and any of them in braces, e.g. -opt {<int> <int>}.
+    struct OptionSpec {
+      enum ValueKind {
+        VALUE_NONE,
+        VALUE_STRING,
+        VALUE_FIELDS,
+        VALUE_WORDS,
+        VALUE_INVALID
+      };
+      ValueKind kind;
+      bool braced;
+      // 'i', 'd', 's' or '?' (unchecked) per field
+      std::string field_types;
+      std::vector<std::string> words;
+    };
+    struct CommandSpec {
+      CommandFunction function;
+      std::string option_text;
+      // positional arguments, given before the options
+      std::string arguments;
+      int num_arguments;
+      std::vector<Option> options;
+      std::vector<OptionSpec> option_specs;
+      // option name -> index into options and option_specs
+      std::unordered_map<std::string, int> option_index;
+      // getObject() positions, filled on first use
+      std::unordered_map<std::string, int> object_index;
+    };
+
+    const CommandSpec* findSpec(const std::string& cmd_name) const {
+      std::unordered_map<std::string, CommandSpec>::const_iterator iter = specs_.find(cmd_name);
+      return iter != specs_.end() ? &iter->second : NULL;
+    }
+    void compileOption(const std::string& regex, OptionSpec& spec);
+    bool matchOption(const OptionSpec& spec, Tcl_Obj* const objv[], int count);
     int splitString(const std::string& str, std::string& arguments, std::vector<Option>& ret, std::string sep = " ");
     int splitString(const std::string& str, std::vector<std::string>& ret, std::string sep = " ");
-    bool matchRegex(const std::string& para, const std::string& regex);
     std::string trimString(const std::string& str, const std::string& trim_b = " ", const std::string& trim_e = " ");
-    bool isValidInt(std::string opt);
-    bool isValidDouble(std::string opt);
-    bool isValidString(std::string opt);
+    static bool isValidInt(const char* opt, size_t length);
+    static bool isValidDouble(const char* opt, size_t length);
     
   private:
     std::vector<std::string> commands_;
     std::vector<std::string> options_;
     std::vector<CommandFunction> cmd_funcs_;
-    std::map<std::string, std::string> cmd_args_;
-    std::map<std::string, std::vector<Option>> cmd_opts_;
-    std::map<std::string, CommandFunction> cmds_map_;
+    std::unordered_map<std::string, CommandSpec> specs_;
+    // words of the option value being matched
+    std::vector<std::pair<const char*, size_t> > words_;
     static Tcl_Interp* interp_;
     struct timespec tp_begin_, tp_end_;
 #ifdef WIN32
@@ -124,7 +166,10 @@ namespace eda {
     timeval time_begin_, time_end_;
 #endif
     int memory_begin_;
-    bool verbose_;
+    // preRun() opened a MemorySampler trace, the level may change before
+    // postRun()
+    bool memory_sampled_;
+    ProfileLevel profile_level_;
   };
 
   extern Commands gCommands;
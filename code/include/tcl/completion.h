@@ -0,0 +1,103 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Completion of the command line, shared by the readline prompt and the
+//* CommandLine of the GUI. The first word of a command completes to the
+//* commands, "-..." to the options of its command, "$..." to the Tcl
+//* variables and any other word to the names of the design objects. Each is
+//* a CompletionIndex built ahead of time: the commands, options and
+//* variables after every evaluated command, the object names by a background
+//* thread after the design is set. A TAB never calls into Tcl and is a binary
+//* search however large the design is, so the GUI may complete while a worker
+//* runs a command.
+//******************************************************************************
+
+#ifndef TCL_COMPLETION_H
+#define TCL_COMPLETION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <tcl.h>
+
+#include "utility/completion_index.h"
+
+namespace eda {
+
+  class Design;
+
+  class CommandCompletion {
+  public:
+    // matches listed at most, common still covers all of them
+    static const size_t kMaxMatches = 500;
+
+    class Result {
+    public:
+      // what the word completes to, the prefix shared by all matches
+      std::string common;
+      // the first kMaxMatches matches in order
+      std::vector<std::string> matches;
+      size_t num_matches;
+    };
+
+    CommandCompletion();
+    ~CommandCompletion();
+
+    // The registered commands and their options, the commands and variables
+    // of interp. Call on the thread that owns interp after it evaluated a
+    // command, procs and variables may have changed.
+    void indexInterp(Tcl_Interp* interp);
+    // The names of the cells, instances, ports, pins and nets. They are
+    // copied at once, sorting them takes seconds on a large design and is
+    // left to a background thread, until then no object name completes.
+    // NULL drops them.
+    void indexDesign(const Design* design);
+
+    // Completes the word line[start, end), returns false if nothing matches
+    // or the word is empty and not a command.
+    bool complete(const std::string& line, size_t start, size_t end, Result& result) const;
+
+  private:
+    CommandCompletion(const CommandCompletion&);
+    CommandCompletion& operator=(const CommandCompletion&);
+
+    typedef std::shared_ptr<const CompletionIndex> IndexPtr;
+
+    // the command the word at start belongs to, empty if it is the command
+    static std::string commandOf(const std::string& line, size_t start);
+    static void collect(const CompletionIndex& index, const std::string& prefix, size_t skip,
+      const std::string& insert, Result& result);
+    static void* indexerThread(void* data);
+    void buildObjects();
+
+    // indexInterp() and indexDesign() may run on a worker thread, they swap
+    // in new indices under the mutex, complete() keeps the ones it found
+    mutable std::mutex mutex_;
+    IndexPtr commands_;
+    // "<command> <option>"
+    IndexPtr options_;
+    IndexPtr variables_;
+    IndexPtr objects_;
+
+    // the object names indexDesign() left to the indexer thread, only the
+    // index of the last design is kept
+    std::shared_ptr<CompletionIndex> pending_objects_;
+    uint64_t objects_generation_;
+    std::condition_variable work_;
+    bool stopping_;
+    bool thread_started_;
+    pthread_t thread_;
+  };
+
+  extern CommandCompletion gCompletion;
+
+}
+
+#endif // !TCL_COMPLETION_H
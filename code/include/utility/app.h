@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef UTILITY_APP_H
@@ -15,7 +15,9 @@ namespace eda {
   public:
     static bool canonicalFilePath(std::string &file_path, std::string &canonical_path);
     static std::string getDBPath();
-    static bool avoidOverwrite(const std::string & file_name);
+    // Moves an existing file_name aside to a new numbered generation, the
+    // new name is returned in moved_name.
+    static bool avoidOverwrite(const std::string & file_name, std::string* moved_name = NULL);
   };
 }
 
@@ -0,0 +1,71 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Raw reading and writing of POD arrays, each stored as a 32-bit element
+//* count followed by the elements in host byte order. The overloads taking
+//* a (position, end) pair read the same format from memory, e.g. from a
+//* MappedFile, and advance the position past what they read.
+//******************************************************************************
+
+#ifndef UTILITY_BINARY_IO_H
+#define UTILITY_BINARY_IO_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  template <typename T>
+  bool writeVector(FILE* fp, const std::vector<T>& v) {
+    uint32_t count = static_cast<uint32_t>(v.size());
+    if (fwrite(&count, sizeof(count), 1, fp) != 1) return false;
+    return count == 0 || fwrite(v.data(), sizeof(T), count, fp) == count;
+  }
+
+  template <typename T>
+  bool readVector(FILE* fp, std::vector<T>& v) {
+    uint32_t count = 0;
+    if (fread(&count, sizeof(count), 1, fp) != 1) return false;
+    v.resize(count);
+    return count == 0 || fread(&v[0], sizeof(T), count, fp) == count;
+  }
+
+  inline bool writeString(FILE* fp, const std::string& s) {
+    uint32_t count = static_cast<uint32_t>(s.size());
+    if (fwrite(&count, sizeof(count), 1, fp) != 1) return false;
+    return count == 0 || fwrite(s.data(), 1, count, fp) == count;
+  }
+
+  inline bool readString(FILE* fp, std::string& s) {
+    uint32_t count = 0;
+    if (fread(&count, sizeof(count), 1, fp) != 1) return false;
+    s.resize(count);
+    return count == 0 || fread(&s[0], 1, count, fp) == count;
+  }
+
+  template <typename T>
+  bool readValue(const char*& p, const char* end, T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool readVector(const char*& p, const char* end, std::vector<T>& v) {
+    uint32_t count = 0;
+    if (!readValue(p, end, count) || static_cast<size_t>(end - p) / sizeof(T) < count) return false;
+    v.resize(count);
+    if (count > 0) memcpy(static_cast<void*>(&v[0]), p, count * sizeof(T));
+    p += count * sizeof(T);
+    return true;
+  }
+
+}
+
+#endif // !UTILITY_BINARY_IO_H
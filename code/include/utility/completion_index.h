@@ -0,0 +1,52 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Sorted word list for prefix completion. The words are copied back to back
+//* into one buffer and sorted once by build(), the words starting with a
+//* prefix are then one contiguous range found by two binary searches, so a
+//* lookup among millions of names takes microseconds and allocates nothing.
+//* A sorted array answers the same prefix queries as a trie with a fraction
+//* of its memory, the index does not change after build().
+//******************************************************************************
+
+#ifndef UTILITY_COMPLETION_INDEX_H
+#define UTILITY_COMPLETION_INDEX_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class CompletionIndex {
+  public:
+    CompletionIndex() {}
+    ~CompletionIndex() {}
+
+    void reserve(size_t num_words, size_t num_bytes);
+    void add(const char* word, size_t length);
+    void add(const std::string& word) { add(word.data(), word.size()); }
+    // sorts the words and drops duplicates, call once after the last add()
+    void build();
+    void clear();
+
+    size_t size() const { return offsets_.size(); }
+    const char* word(size_t i) const { return &text_[offsets_[i]]; }
+    // the words starting with prefix are [begin, end)
+    void find(const char* prefix, size_t length, size_t& begin, size_t& end) const;
+    // length of the prefix shared by the words [begin, end), end > begin
+    size_t commonLength(size_t begin, size_t end) const;
+    size_t memoryUsage() const;
+
+  private:
+    // each word is followed by '\0'
+    std::vector<char> text_;
+    // where the words start in text_, sorted by word after build()
+    std::vector<size_t> offsets_;
+  };
+
+}
+
+#endif // !UTILITY_COMPLETION_INDEX_H
@@ -2,11 +2,12 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #ifndef UTILITY_DATA_VAR_H
 #define UTILITY_DATA_VAR_H
 
+#include <atomic>
 #include <vector>
 #include <list>
 #include <string>
@@ -21,11 +22,12 @@ namespace eda {
   public:
 
   public:
-    static int current_used_memory_;
-    static int cmd_peak_used_memory_;
-    static int eda_peak_used_memory_;
+    // MB, written by MemorySampler
+    static std::atomic<int> current_used_memory_;
+    static std::atomic<int> cmd_peak_used_memory_;
+    static std::atomic<int> eda_peak_used_memory_;
 
-    static bool cmd_started_;
+    static std::atomic<bool> cmd_started_;
     static Time time_;
 
     static void insertObserver(DataVarObserver* observer, int index = -1) {
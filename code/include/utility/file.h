@@ -2,20 +2,22 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef UTILITY_FILE_H
 #define UTILITY_FILE_H
 
 #include <string>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #ifdef WIN32
 #include <direct.h>
 #include <io.h>
 #else
 #include <dirent.h>
 #include <unistd.h>
-#include <sys/stat.h>
 #endif
 
 
@@ -44,6 +46,17 @@ namespace eda {
     static int rename(const char* old_file_name, const char* new_file_name) {
       return ::rename(old_file_name, new_file_name);
     }
+    // returns -1 if the file does not exist
+    static long long size(const char* file_name) {
+#ifdef WIN32
+      struct _stati64 info;
+      if (_stati64(file_name, &info) != 0) return -1;
+#else
+      struct stat info;
+      if (::stat(file_name, &info) != 0) return -1;
+#endif
+      return static_cast<long long>(info.st_size);
+    }
   };
 }
 
@@ -0,0 +1,25 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* 64-bit content hashes (xxHash64) of memory ranges and files.
+//******************************************************************************
+
+#ifndef UTILITY_HASH_H
+#define UTILITY_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace eda {
+
+  uint64_t xxHash64(const void* data, size_t length, uint64_t seed = 0);
+
+  // hash of the whole content of a file, false if it cannot be read
+  bool hashFile(const std::string& file_name, uint64_t seed, uint64_t& hash);
+
+}
+
+#endif // !UTILITY_HASH_H
@@ -0,0 +1,95 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Output file of the log. Plain text is written straight to the file.
+//* Compressed text is collected in blocks of kBufferSize and gzip-compressed
+//* by a background thread, so the writer of the log never waits for zlib
+//* unless kMaxPending blocks are queued. Once a generation holds max_bytes
+//* of text it can be moved aside with rotate().
+//******************************************************************************
+
+#ifndef UTILITY_LOG_FILE_H
+#define UTILITY_LOG_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class LogFile {
+  public:
+    static const size_t kBufferSize = 1024 * 1024;
+    static const size_t kMaxPending = 4;
+    // zlib level, the fast end still shrinks log text about 5 times
+    static const int kCompressionLevel = 1;
+
+    LogFile();
+    ~LogFile();
+
+    // false if the build has no zlib
+    static bool canCompress();
+
+    // Creates file_name, max_bytes of 0 never asks for rotation.
+    bool open(const std::string& file_name, bool compress, uint64_t max_bytes);
+    void write(const char* text, size_t length);
+    // Hands everything written so far to the file. Compressed text is only
+    // queued for the compressor.
+    void flush();
+    void close();
+
+    bool isOpen() const { return plain_ != NULL || compressed_ != NULL; }
+    bool compressed() const { return compressed_ != NULL; }
+    const std::string& file_name() const { return file_name_; }
+    // text written to the current generation, before compression
+    uint64_t size() const { return size_; }
+    bool full() const { return max_bytes_ > 0 && size_ >= max_bytes_; }
+    // Closes the current generation, moves it aside with
+    // App::avoidOverwrite() and starts a new one under the same name.
+    // Returns the name it was moved to, empty if it could not be moved, the
+    // file is appended to and not rotated anymore then.
+    std::string rotate();
+
+  private:
+    LogFile(const LogFile&);
+    LogFile& operator=(const LogFile&);
+
+    static void* compressorThread(void* data);
+    void compressBlocks();
+    void queueBuffer();
+    // waits until the compressor is done with all queued blocks
+    void drain();
+    bool openFile(const char* mode);
+    void closeFile();
+
+    std::string file_name_;
+    uint64_t max_bytes_;
+    uint64_t size_;
+    bool compress_;
+    FILE* plain_;
+    // gzFile, kept opaque to keep zlib.h out of the header
+    void* compressed_;
+
+    std::vector<char> buffer_;
+    std::mutex mutex_;
+    std::condition_variable work_;
+    std::condition_variable done_;
+    std::deque<std::vector<char> > pending_;
+    std::vector<std::vector<char> > free_buffers_;
+    bool busy_;
+    bool stopping_;
+    bool thread_started_;
+    pthread_t thread_;
+  };
+
+}
+
+#endif // !UTILITY_LOG_FILE_H
@@ -0,0 +1,117 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Trigram index over a log file. The file is cut into blocks of whole lines
+//* of about kBlockSize bytes, and for every lower-cased trigram the index
+//* keeps the varint-coded deltas of the blocks containing it. A query only
+//* reads the blocks holding all trigrams that any match must contain, also
+//* for regular expressions, where they are taken from the literal parts.
+//******************************************************************************
+
+#ifndef UTILITY_LOG_INDEX_H
+#define UTILITY_LOG_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eda {
+
+  class LogIndex {
+  public:
+    static const uint32_t kVersion = 1;
+    static const size_t kBlockSize = 32 * 1024;
+
+    enum SearchFlag {
+      SEARCH_REGEX = 1,
+      SEARCH_IGNORE_CASE = 2
+    };
+
+    class Match {
+    public:
+      // 0-based line in the log file
+      uint32_t line;
+      std::string text;
+    };
+
+    LogIndex();
+
+    // the index of a log file is kept in <log file>.idx
+    static std::string indexFile(const std::string& log_file) { return log_file + ".idx"; }
+
+    // Starts over for a new, empty log file.
+    void reset(const std::string& log_file);
+    // Indexes text appended to the log file, may be called from another
+    // thread than the searches.
+    void append(const char* text, size_t length);
+    // Loads the saved index of an existing log file and indexes what was
+    // appended since. The file is indexed from scratch if there is no saved
+    // index or it belongs to another file. Returns true if the saved index
+    // was used.
+    bool open(const std::string& log_file);
+    bool save();
+
+    // Lines matching pattern in file order, at most max_matches of them.
+    // Returns false with a message in error if the pattern is not a valid
+    // regular expression or the log file cannot be read. Text that is not
+    // flushed to the file yet is not found.
+    bool search(const std::string& pattern, int flags, size_t max_matches,
+      std::vector<Match>& matches, std::string& error);
+
+    const std::string& log_file() const { return log_file_; }
+    uint32_t numLines();
+    uint64_t numBytes();
+    size_t memoryUsage();
+
+  private:
+    LogIndex(const LogIndex&);
+    LogIndex& operator=(const LogIndex&);
+
+    class Posting {
+    public:
+      uint32_t last_block;
+      uint32_t count;
+      std::vector<uint8_t> deltas;
+    };
+    // a block to be read by a search
+    class Candidate {
+    public:
+      uint64_t begin;
+      uint64_t end;
+      uint32_t first_line;
+    };
+
+    void clear();
+    void appendLocked(const char* text, size_t length);
+    void closeBlock();
+    void decode(const Posting& posting, std::vector<uint32_t>& blocks) const;
+    bool findCandidates(const std::vector<uint32_t>& trigrams, std::vector<Candidate>& candidates);
+
+    std::mutex mutex_;
+    std::string log_file_;
+    // file offset and first line of each closed block
+    std::vector<uint64_t> block_offsets_;
+    std::vector<uint32_t> block_lines_;
+    std::unordered_map<uint32_t, uint32_t> posting_index_;
+    std::vector<Posting> postings_;
+    // the open block: its trigrams and one bit per trigram for the ones in it
+    std::vector<uint32_t> block_trigrams_;
+    std::vector<uint64_t> block_seen_;
+    uint64_t block_offset_;
+    uint32_t block_line_;
+    uint64_t num_bytes_;
+    uint32_t num_lines_;
+    // last two lower-cased bytes of the current line and how many of them
+    // there are
+    uint32_t window_;
+    int window_length_;
+  };
+
+}
+
+#endif // !UTILITY_LOG_INDEX_H
@@ -0,0 +1,82 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Asynchronous log backend. Callers format their message straight into a
+//* record of a bounded multi-producer ring buffer and return; one writer
+//* thread hands the records in order to a sink and flushes the sink once per
+//* batch. A producer only waits when the ring is full. Each message is
+//* stamped with its time, thread and command when it is pushed.
+//******************************************************************************
+
+#ifndef UTILITY_LOG_QUEUE_H
+#define UTILITY_LOG_QUEUE_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace eda {
+
+  class LogQueue {
+  public:
+    // records in the ring, a power of two
+    static const size_t kCapacity = 4096;
+    // messages up to this size are kept inside the record, longer ones are
+    // copied to the heap
+    static const size_t kInlineSize = 240;
+    // records written between two flushes of the sink at most
+    static const size_t kBatchSize = 256;
+
+    // a message as handed to the sink
+    class Entry {
+    public:
+      int type;
+      const char* text;
+      size_t length;
+      // microseconds since the epoch when it was printed
+      int64_t time_us;
+      // small number of the printing thread, 1 for the first one
+      uint32_t thread_id;
+      // the Tcl command running at that time, 0 between commands
+      uint32_t command_id;
+    };
+
+    class Sink {
+    public:
+      virtual ~Sink() {}
+      virtual void write(const Entry& entry) = 0;
+      virtual void flush() = 0;
+    };
+
+    // starts the writer thread, the sink has to outlive it
+    static bool start(Sink* sink);
+    // writes all queued records and stops the writer thread
+    static void stop();
+    static bool running();
+
+    // Queues prefix followed by the formatted message. Returns false if the
+    // writer is not running or the caller is the writer itself, the caller
+    // has to write the message on its own then.
+    static bool push(int type, const char* prefix, const char* format, va_list args);
+    static bool push(int type, const char* text);
+
+    // waits until everything queued so far is written and flushed
+    static void flush();
+
+    // Fills in the time, thread and command of an entry, for messages that
+    // are written without the queue.
+    static void stamp(Entry& entry);
+    // Numbers the messages until the matching endCommand() with a new
+    // command id. Nested commands keep the id of the outer one.
+    static void beginCommand();
+    static void endCommand();
+
+  private:
+    LogQueue() {}
+  };
+
+}
+
+#endif // !UTILITY_LOG_QUEUE_H
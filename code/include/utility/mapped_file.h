@@ -0,0 +1,47 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Read-only memory mapping of a whole file. The pages are shared between all
+//* processes mapping the same file, so databases opened this way cost nothing
+//* extra when many editor sessions run on one host.
+//******************************************************************************
+
+#ifndef UTILITY_MAPPED_FILE_H
+#define UTILITY_MAPPED_FILE_H
+
+#include <stddef.h>
+#include <string>
+
+namespace eda {
+
+  class MappedFile {
+  public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& file_name);
+    void close();
+
+    bool isOpen() const { return data_ != NULL; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& file_name() const { return file_name_; }
+
+  private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data_;
+    size_t size_;
+    std::string file_name_;
+#ifdef WIN32
+    void* file_handle_;
+    void* map_handle_;
+#endif
+  };
+
+}
+
+#endif // !UTILITY_MAPPED_FILE_H
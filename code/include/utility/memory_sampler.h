@@ -0,0 +1,74 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Background sampler of the resident memory of the process. The sampler
+//* thread wakes every kBusyIntervalMs while a command runs and every
+//* kIdleIntervalMs otherwise, the start of a command wakes it at once. The
+//* counters of DataVar are updated on every sample and the samples taken
+//* during a command are kept as its memory trace.
+//******************************************************************************
+
+#ifndef UTILITY_MEMORY_SAMPLER_H
+#define UTILITY_MEMORY_SAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class MemorySampler {
+  public:
+    static const int kBusyIntervalMs = 1;
+    static const int kIdleIntervalMs = 250;
+    // traces of the last commands kept
+    static const size_t kMaxTraces = 32;
+    // a trace holds at most this many samples, every other sample is dropped
+    // and the stride doubled when it is full
+    static const size_t kMaxSamples = 4096;
+
+    class Sample {
+    public:
+      // since the start of the command
+      uint32_t time_ms;
+      uint32_t rss_kb;
+    };
+
+    class Trace {
+    public:
+      std::string command;
+      uint32_t begin_kb;
+      uint32_t peak_kb;
+      uint32_t end_kb;
+      uint32_t elapsed_ms;
+      // a sample is kept every stride sampler ticks
+      uint32_t stride;
+      std::vector<Sample> samples;
+    };
+
+    // starts and stops the sampler thread
+    static bool start();
+    static void stop();
+
+    // Take a synchronous sample and open or close the trace of a command,
+    // cmd_started_ of DataVar follows them.
+    static void beginCommand(const std::string& command);
+    static void endCommand();
+
+    // Reads the memory of the process right now and updates DataVar. Returns
+    // the resident size in KB.
+    static uint32_t sample();
+
+    // finished traces, oldest first
+    static std::vector<Trace> traces();
+
+  private:
+    MemorySampler() {}
+  };
+
+}
+
+#endif // !UTILITY_MEMORY_SAMPLER_H
@@ -0,0 +1,77 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Heap accounting per subsystem. When the process is started with the
+//* environment variable EDA_MEMORY_TRACKING set, the global operator new and
+//* delete put a small header in front of every block that records its size
+//* and the tag of the allocating thread. Every thread counts into its own
+//* counters, usage() merges them. Memory allocated with malloc, e.g. by Tcl,
+//* is not seen.
+//******************************************************************************
+
+#ifndef UTILITY_MEMORY_TRACKER_H
+#define UTILITY_MEMORY_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace eda {
+
+  class MemoryTracker {
+  public:
+    enum Tag {
+      TAG_OTHER,
+      TAG_DEVICE,
+      TAG_DESIGN,
+      TAG_GUI,
+      TAG_LOG,
+      NUM_TAGS
+    };
+
+    class Usage {
+    public:
+      int64_t bytes;
+      int64_t peak_bytes;
+      uint64_t allocations;
+      uint64_t frees;
+    };
+
+    // fixed for the lifetime of the process
+    static bool enabled();
+    static const char* tagName(Tag tag);
+
+    // tag of the allocations of the calling thread
+    static Tag tag();
+    static void set_tag(Tag tag);
+
+    // usage per tag, indexed by Tag
+    static void usage(std::vector<Usage>& usage);
+
+    static void* allocate(size_t size);
+    static void release(void* ptr);
+
+  private:
+    MemoryTracker() {}
+  };
+
+  // Tags the allocations of the calling thread until the end of the scope.
+  class MemoryTagScope {
+  public:
+    explicit MemoryTagScope(MemoryTracker::Tag tag) : previous_(MemoryTracker::tag()) {
+      MemoryTracker::set_tag(tag);
+    }
+    ~MemoryTagScope() { MemoryTracker::set_tag(previous_); }
+
+  private:
+    MemoryTagScope(const MemoryTagScope&);
+    MemoryTagScope& operator=(const MemoryTagScope&);
+
+    MemoryTracker::Tag previous_;
+  };
+
+}
+
+#endif // !UTILITY_MEMORY_TRACKER_H
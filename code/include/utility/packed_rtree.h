@@ -0,0 +1,90 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Static R-tree over boxes, bulk loaded in Hilbert order. All nodes are kept
+//* in two flat arrays, leaves first and the root last, so a tree of millions
+//* of boxes is a few allocations and a search touches contiguous memory.
+//*
+//* Edits after build() do not touch the packed nodes: insert() keeps new
+//* boxes in a small overflow list that is searched linearly, remove() hides
+//* a leaf. Once the overflow or the removed leaves grow past a fraction of
+//* the tree it is packed again. IDs are expected to be dense, e.g. indices
+//* into an array of objects.
+//******************************************************************************
+
+#ifndef UTILITY_PACKED_RTREE_H
+#define UTILITY_PACKED_RTREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace eda {
+
+  class PackedRTree {
+  public:
+    static const uint32_t kInvalidId = 0xffffffff;
+
+    class Box {
+    public:
+      Box() : x0(0), y0(0), x1(0), y1(0) {}
+      Box(float left, float top, float right, float bottom) : x0(left), y0(top), x1(right), y1(bottom) {}
+      bool intersects(const Box& box) const { return x0 <= box.x1 && box.x0 <= x1 && y0 <= box.y1 && box.y0 <= y1; }
+      void expand(const Box& box);
+      float x0;
+      float y0;
+      float x1;
+      float y1;
+    };
+
+    explicit PackedRTree(uint32_t node_size = 16);
+    ~PackedRTree() {}
+
+    void clear();
+    // bulk loading: add() every box, then build()
+    void add(uint32_t id, const Box& box);
+    void build();
+
+    // edits of a built tree
+    void insert(uint32_t id, const Box& box);
+    // false if there is no such ID
+    bool remove(uint32_t id);
+
+    // appends the IDs of all boxes intersecting box
+    void search(const Box& box, std::vector<uint32_t>& ids) const;
+
+    uint32_t size() const { return num_leaves_ - num_removed_ + static_cast<uint32_t>(overflow_.size() + items_.size()); }
+    size_t memoryUsage() const;
+
+  private:
+    class Item {
+    public:
+      Box box;
+      uint32_t id;
+    };
+
+    void pack();
+
+    uint32_t node_size_;
+    // added but not built yet
+    std::vector<Item> items_;
+    // all nodes, level by level starting with the leaves
+    std::vector<Box> boxes_;
+    // the ID of a leaf, the position of the first child of an inner node
+    std::vector<uint32_t> indices_;
+    // end of every level in boxes_
+    std::vector<uint32_t> level_end_;
+    uint32_t num_leaves_;
+
+    // position of the leaf of an ID, kInvalidId if it has none
+    std::vector<uint32_t> leaf_of_;
+    std::vector<uint8_t> removed_;
+    uint32_t num_removed_;
+    std::vector<Item> overflow_;
+  };
+
+}
+
+#endif // !UTILITY_PACKED_RTREE_H
@@ -0,0 +1,30 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Fork-join helper on top of pthreads: a range of independent work items is
+//* cut into contiguous chunks and every chunk runs in its own thread.
+//******************************************************************************
+
+#ifndef UTILITY_PARALLEL_H
+#define UTILITY_PARALLEL_H
+
+#include <stddef.h>
+#include <functional>
+
+namespace eda {
+
+  // number of online processors, at least 1
+  int numProcessors();
+  // Caps numProcessors() for processes that share the host, 0 removes the
+  // cap.
+  void set_max_processors(int count);
+
+  // Calls fn(begin, end) on disjoint chunks covering [0, count) and returns
+  // when all of them are done. num_threads <= 0 uses numProcessors().
+  void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn, int num_threads = 0);
+
+}
+
+#endif // !UTILITY_PARALLEL_H
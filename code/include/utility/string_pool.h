@@ -0,0 +1,75 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Append-only string storage. Strings are copied into large blocks and
+//* addressed by 32-bit IDs, so a netlist with millions of names needs one
+//* allocation per block instead of one per name, and blocks never move, so
+//* growing the pool never copies what is already stored.
+//*
+//* intern() returns the same ID for equal strings, add() always stores a new
+//* copy and is meant for long unique values such as cfg strings.
+//******************************************************************************
+
+#ifndef UTILITY_STRING_POOL_H
+#define UTILITY_STRING_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace eda {
+
+  class StringPool {
+  public:
+    typedef uint32_t Id;
+    static const Id kInvalidId = 0xffffffff;
+    static const size_t kBlockSize = 1024 * 1024;
+
+    StringPool();
+    ~StringPool();
+
+    Id intern(const char* str, size_t length);
+    Id intern(const std::string& str) { return intern(str.data(), str.size()); }
+    Id add(const char* str, size_t length);
+    // returns kInvalidId if the string was never interned
+    Id find(const char* str, size_t length) const;
+    Id find(const std::string& str) const { return find(str.data(), str.size()); }
+
+    uint32_t size() const { return static_cast<uint32_t>(strings_.size()); }
+    const char* str(Id id) const { return strings_[id]; }
+    size_t length(Id id) const { return lengths_[id]; }
+    void clear();
+    size_t memoryUsage() const;
+
+    // The strings are written in ID order together with the hash table, so
+    // load() restores the same IDs without hashing anything again. load()
+    // reads from memory and advances p.
+    bool save(FILE* fp) const;
+    bool load(const char*& p, const char* end);
+
+  private:
+    StringPool(const StringPool&);
+    StringPool& operator=(const StringPool&);
+
+    static uint32_t hash(const char* str, size_t length);
+    const char* store(const char* str, size_t length);
+    void rehash(size_t num_slots);
+
+    std::vector<char*> blocks_;
+    char* block_end_;
+    char* block_free_;
+    size_t block_bytes_;
+    std::vector<const char*> strings_;
+    std::vector<uint32_t> lengths_;
+    // open addressing table of interned IDs, kInvalidId marks a free slot
+    std::vector<Id> slots_;
+    size_t num_interned_;
+  };
+
+}
+
+#endif // !UTILITY_STRING_POOL_H
@@ -0,0 +1,73 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//* Timeline of the process for chrome://tracing and the Perfetto UI. Every
+//* thread records its zones, counters and markers into its own buffer, only
+//* the owning thread writes to it and a chunk is published by a release
+//* store of its event count, so recording takes no lock. The buffers of
+//* finished threads are reused by new ones and writeChromeTrace() reads all
+//* of them while they are being written.
+//******************************************************************************
+
+#ifndef UTILITY_TRACER_H
+#define UTILITY_TRACER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace eda {
+
+  class Tracer {
+  public:
+    // events in one chunk of a thread buffer
+    static const size_t kChunkEvents = 4096;
+    // a thread stops recording after this many chunks, 16MB of events
+    static const size_t kMaxChunks = 128;
+
+    static bool enabled();
+    static void set_enabled(bool enabled);
+
+    // Names have to stay valid until the trace is written, pass literals
+    // or what intern() returns.
+    static void begin(const char* name, const char* category = "zone");
+    static void end();
+    static void counter(const char* name, double value);
+    static void instant(const char* name, const char* category = "marker");
+    static const char* intern(const std::string& name);
+
+    // small number of the calling thread, 1 for the first one that asks
+    static uint32_t threadId();
+    static void set_thread_name(const char* name);
+
+    // Writes everything recorded so far in the Chrome trace event format.
+    // Zones that are still open are closed at the time of writing.
+    static bool writeChromeTrace(const std::string& file_name, size_t& num_events);
+    // drops the events recorded so far
+    static void clear();
+    // events dropped because a thread buffer was full
+    static uint64_t numDropped();
+
+  private:
+    Tracer() {}
+  };
+
+  class TraceScope {
+  public:
+    TraceScope(const char* name, const char* category = "zone") {
+      Tracer::begin(name, category);
+    }
+    ~TraceScope() {
+      Tracer::end();
+    }
+
+  private:
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+  };
+
+}
+
+#endif // !UTILITY_TRACER_H
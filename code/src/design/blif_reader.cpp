@@ -0,0 +1,549 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+
+#include "design/blif_reader.h"
+#include "gui/command_context.h"
+#include "utility/log.h"
+#include "utility/mapped_file.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  namespace {
+
+    inline bool isSpace(char c) {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool equals(const char* text, size_t length, const char* word) {
+      return strncmp(text, word, length) == 0 && word[length] == '\0';
+    }
+
+    // A signal used by an instance pin or a model port. BLIF has no net
+    // statements, the nets of a model are built from these once it is merged.
+    class Connection {
+    public:
+      Design::StringId signal;
+      // kInvalidIndex for a port of the model
+      uint32_t instance;
+      Design::StringId pin;
+      uint8_t direction;
+    };
+
+    bool operator<(const Connection& a, const Connection& b) {
+      return a.signal < b.signal;
+    }
+
+    // Parser for one unit, the result goes to a private design so that
+    // workers never share state.
+    class BlifUnitParser {
+    public:
+      BlifUnitParser(const char* begin, const char* end, uint32_t line, Design* design, std::vector<Connection>* connections);
+
+      bool parse(bool header);
+      const std::string& error() const { return error_; }
+      uint32_t line() const { return statement_line_; }
+      uint32_t numIgnored() const { return num_ignored_; }
+
+    private:
+      class Token {
+      public:
+        const char* text;
+        size_t length;
+      };
+
+      bool nextStatement();
+      bool is(size_t i, const char* word) const { return equals(tokens_[i].text, tokens_[i].length, word); }
+      Design::StringId intern(size_t i) { return design_->strings().intern(tokens_[i].text, tokens_[i].length); }
+      Design::StringId inputPin(size_t i);
+      void connect(Design::StringId signal, uint32_t instance, Design::StringId pin, Design::PinDirection direction);
+      void parsePorts(Design::PinDirection direction);
+      bool parseNames();
+      void addCoverLine();
+      void finishNames();
+      bool parseLatch();
+      bool parseSubckt();
+      bool fail(const char* message) {
+        error_ = message;
+        return false;
+      }
+
+      const char* p_;
+      const char* end_;
+      uint32_t line_;
+      uint32_t statement_line_;
+      std::vector<Token> tokens_;
+      Design* design_;
+      std::vector<Connection>* connections_;
+      // the .names block being read, added once its cover is complete
+      bool in_names_;
+      Design::Instance names_;
+      std::string cover_;
+      uint32_t num_ignored_;
+      std::string error_;
+      std::string scratch_;
+      Design::StringId names_type_;
+      Design::StringId latch_type_;
+      std::vector<Design::StringId> input_pins_;
+      Design::StringId output_pin_;
+      Design::StringId d_pin_;
+      Design::StringId q_pin_;
+      Design::StringId clock_pin_;
+    };
+
+    BlifUnitParser::BlifUnitParser(const char* begin, const char* end, uint32_t line, Design* design, std::vector<Connection>* connections) {
+      p_ = begin;
+      end_ = end;
+      line_ = line;
+      statement_line_ = line;
+      design_ = design;
+      connections_ = connections;
+      in_names_ = false;
+      num_ignored_ = 0;
+      StringPool& strings = design_->strings();
+      names_type_ = strings.intern("names");
+      latch_type_ = strings.intern("latch");
+      output_pin_ = strings.intern("out");
+      d_pin_ = strings.intern("D");
+      q_pin_ = strings.intern("Q");
+      clock_pin_ = strings.intern("clk");
+    }
+
+    // Reads the next non-empty logical line, lines ending with '\' are
+    // continued on the next one. Returns false at the end of the unit.
+    bool BlifUnitParser::nextStatement() {
+      tokens_.clear();
+      while (p_ < end_) {
+        const char* eol = static_cast<const char*>(memchr(p_, '\n', static_cast<size_t>(end_ - p_)));
+        if (eol == NULL) eol = end_;
+        if (tokens_.empty()) statement_line_ = line_;
+        line_++;
+        const char* stop = static_cast<const char*>(memchr(p_, '#', static_cast<size_t>(eol - p_)));
+        if (stop == NULL) stop = eol;
+        while (stop > p_ && isSpace(stop[-1])) stop--;
+        bool continued = stop > p_ && stop[-1] == '\\';
+        if (continued) stop--;
+        const char* p = p_;
+        while (p < stop) {
+          while (p < stop && isSpace(*p)) p++;
+          if (p == stop) break;
+          Token token;
+          token.text = p;
+          while (p < stop && !isSpace(*p)) p++;
+          token.length = static_cast<size_t>(p - token.text);
+          tokens_.push_back(token);
+        }
+        p_ = eol < end_ ? eol + 1 : end_;
+        if (!continued && !tokens_.empty()) {
+          return true;
+        }
+      }
+      return !tokens_.empty();
+    }
+
+    // "in[i]", interned once per unit
+    Design::StringId BlifUnitParser::inputPin(size_t i) {
+      while (input_pins_.size() <= i) {
+        char name[32];
+        sprintf(name, "in[%u]", static_cast<unsigned int>(input_pins_.size()));
+        input_pins_.push_back(design_->strings().intern(name));
+      }
+      return input_pins_[i];
+    }
+
+    void BlifUnitParser::connect(Design::StringId signal, uint32_t instance, Design::StringId pin, Design::PinDirection direction) {
+      Connection connection;
+      connection.signal = signal;
+      connection.instance = instance;
+      connection.pin = pin;
+      connection.direction = static_cast<uint8_t>(direction);
+      connections_->push_back(connection);
+    }
+
+    bool BlifUnitParser::parse(bool header) {
+      if (header) {
+        if (!nextStatement() || !is(0, ".model")) {
+          return fail("'.model' expected");
+        }
+        if (tokens_.size() < 2) {
+          return fail("model name expected");
+        }
+        design_->addCell(intern(1), StringPool::kInvalidId);
+      }
+      while (nextStatement()) {
+        if (tokens_[0].text[0] != '.') {
+          if (!in_names_) {
+            return fail("cover line outside of .names");
+          }
+          addCoverLine();
+          continue;
+        }
+        finishNames();
+        if (is(0, ".names")) {
+          if (!parseNames()) return false;
+        } else if (is(0, ".latch")) {
+          if (!parseLatch()) return false;
+        } else if (is(0, ".subckt") || is(0, ".gate")) {
+          if (!parseSubckt()) return false;
+        } else if (is(0, ".inputs") || is(0, ".clock")) {
+          parsePorts(Design::PIN_INPUT);
+        } else if (is(0, ".outputs")) {
+          parsePorts(Design::PIN_OUTPUT);
+        } else if (is(0, ".cname")) {
+          // VTR extension naming the preceding instance
+          if (tokens_.size() >= 2 && design_->numInstances() > 0) {
+            design_->set_instance_name(design_->numInstances() - 1, intern(1));
+          }
+        } else if (is(0, ".end")) {
+          return true;
+        } else if (is(0, ".exdc")) {
+          // external don't cares up to .end are not part of the netlist
+          while (nextStatement() && !is(0, ".end")) {}
+          return true;
+        } else if (is(0, ".model")) {
+          return fail("'.end' expected before '.model'");
+        } else {
+          // .blackbox, .param, .attr, SIS timing directives, ...
+          num_ignored_++;
+        }
+      }
+      finishNames();
+      return true;
+    }
+
+    // .inputs|.outputs <signal> ...
+    void BlifUnitParser::parsePorts(Design::PinDirection direction) {
+      for (size_t i = 1; i < tokens_.size(); i++) {
+        Design::StringId signal = intern(i);
+        design_->addPort(signal, 1, direction);
+        connect(signal, Design::kInvalidIndex, signal, direction);
+      }
+    }
+
+    // .names <input> ... <output>, followed by the cover lines. The instance
+    // is named after its output signal.
+    bool BlifUnitParser::parseNames() {
+      if (tokens_.size() < 2) {
+        return fail("output signal expected after '.names'");
+      }
+      uint32_t index = design_->numInstances();
+      size_t num_inputs = tokens_.size() - 2;
+      for (size_t i = 0; i < num_inputs; i++) {
+        connect(intern(i + 1), index, inputPin(i), Design::PIN_INPUT);
+      }
+      Design::StringId output = intern(tokens_.size() - 1);
+      connect(output, index, output_pin_, Design::PIN_OUTPUT);
+      names_.name = output;
+      names_.type = names_type_;
+      names_.tile = StringPool::kInvalidId;
+      names_.site = StringPool::kInvalidId;
+      names_.config = StringPool::kInvalidId;
+      in_names_ = true;
+      cover_.clear();
+      return true;
+    }
+
+    // the cover is kept as the config string, one cube per line
+    void BlifUnitParser::addCoverLine() {
+      if (!cover_.empty()) cover_ += '\n';
+      for (size_t i = 0; i < tokens_.size(); i++) {
+        if (i > 0) cover_ += ' ';
+        cover_.append(tokens_[i].text, tokens_[i].length);
+      }
+    }
+
+    void BlifUnitParser::finishNames() {
+      if (!in_names_) {
+        return;
+      }
+      if (!cover_.empty()) {
+        names_.config = design_->strings().add(cover_.data(), cover_.size());
+      }
+      design_->addInstance(names_);
+      in_names_ = false;
+    }
+
+    // .latch <input> <output> [<type> <control>] [<init>]
+    bool BlifUnitParser::parseLatch() {
+      if (tokens_.size() < 3) {
+        return fail("input and output signals expected after '.latch'");
+      }
+      uint32_t index = design_->numInstances();
+      connect(intern(1), index, d_pin_, Design::PIN_INPUT);
+      connect(intern(2), index, q_pin_, Design::PIN_OUTPUT);
+      scratch_.clear();
+      size_t init = 3;
+      if (tokens_.size() >= 5) {
+        scratch_ = "type=";
+        scratch_.append(tokens_[3].text, tokens_[3].length);
+        if (!is(4, "NIL")) {
+          connect(intern(4), index, clock_pin_, Design::PIN_INPUT);
+        }
+        init = 5;
+      }
+      if (init < tokens_.size()) {
+        if (!scratch_.empty()) scratch_ += ' ';
+        scratch_ += "init=";
+        scratch_.append(tokens_[init].text, tokens_[init].length);
+      }
+      Design::Instance instance;
+      instance.name = intern(2);
+      instance.type = latch_type_;
+      instance.tile = StringPool::kInvalidId;
+      instance.site = StringPool::kInvalidId;
+      instance.config = scratch_.empty() ? StringPool::kInvalidId : design_->strings().add(scratch_.data(), scratch_.size());
+      design_->addInstance(instance);
+      return true;
+    }
+
+    // .subckt <model> <formal>=<actual> ..., the instance is named when the
+    // unit is merged unless a .cname follows
+    bool BlifUnitParser::parseSubckt() {
+      if (tokens_.size() < 2) {
+        return fail("model name expected after '.subckt'");
+      }
+      uint32_t index = design_->numInstances();
+      for (size_t i = 2; i < tokens_.size(); i++) {
+        const Token& token = tokens_[i];
+        const char* equal = static_cast<const char*>(memchr(token.text, '=', token.length));
+        if (equal == NULL || equal == token.text) {
+          return fail("'<formal>=<actual>' expected");
+        }
+        size_t formal_length = static_cast<size_t>(equal - token.text);
+        if (formal_length + 1 == token.length) {
+          continue;
+        }
+        StringPool& strings = design_->strings();
+        connect(strings.intern(equal + 1, token.length - formal_length - 1), index,
+          strings.intern(token.text, formal_length), Design::PIN_UNKNOWN);
+      }
+      Design::Instance instance;
+      instance.name = StringPool::kInvalidId;
+      instance.type = intern(1);
+      instance.tile = StringPool::kInvalidId;
+      instance.site = StringPool::kInvalidId;
+      instance.config = StringPool::kInvalidId;
+      design_->addInstance(instance);
+      return true;
+    }
+
+    // Adds one net per signal of the model, with the pins in file order. The
+    // instances are known here, so the pins are added resolved.
+    void buildNets(Design* design, std::vector<Connection>& connections) {
+      std::stable_sort(connections.begin(), connections.end());
+      for (size_t i = 0; i < connections.size(); i++) {
+        const Connection& connection = connections[i];
+        if (i == 0 || connection.signal != connections[i - 1].signal) {
+          design->addNet(connection.signal, Design::NET_WIRE);
+        }
+        design->addPin(connection.instance, connection.pin, static_cast<Design::PinDirection>(connection.direction));
+      }
+      connections.clear();
+    }
+
+  }
+
+  const size_t BlifReader::kUnitSize;
+
+  BlifReader::BlifReader(Design* design) {
+    design_ = design;
+  }
+
+  // Scans the lines of the whole file once and cuts it at every .model line
+  // and, every kUnitSize bytes, at a .names, .latch or .subckt line.
+  bool BlifReader::split(const char* begin, const char* end) {
+    const size_t kProgressStep = 64 * 1024 * 1024;
+    const char* next_progress = begin + kProgressStep;
+    const char* unit_begin = NULL;
+    uint32_t unit_line = 0;
+    bool unit_header = false;
+    auto cut = [&](const char* at, uint32_t at_line, bool header) {
+      if (unit_begin != NULL) {
+        Unit unit;
+        unit.begin = unit_begin;
+        unit.end = at;
+        unit.line = unit_line;
+        unit.header = unit_header;
+        units_.push_back(unit);
+      }
+      unit_begin = at;
+      unit_line = at_line;
+      unit_header = header;
+    };
+
+    uint32_t line = 1;
+    bool continued = false;
+    bool in_exdc = false;
+    const char* p = begin;
+    while (p < end) {
+      const char* eol = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+      if (eol == NULL) eol = end;
+      if (!continued) {
+        const char* q = p;
+        while (q < eol && isSpace(*q)) q++;
+        if (q < eol && *q == '.') {
+          const char* word = q;
+          while (q < eol && !isSpace(*q) && *q != '#') q++;
+          size_t length = static_cast<size_t>(q - word);
+          if (equals(word, length, ".model")) {
+            cut(p, line, true);
+            in_exdc = false;
+          } else if (equals(word, length, ".exdc")) {
+            in_exdc = true;
+          } else if (equals(word, length, ".end")) {
+            in_exdc = false;
+          } else if (unit_begin != NULL && !in_exdc && p - unit_begin >= static_cast<ptrdiff_t>(kUnitSize) &&
+            (equals(word, length, ".names") || equals(word, length, ".latch") || equals(word, length, ".subckt"))) {
+            cut(p, line, false);
+          }
+        }
+      }
+      const char* stop = eol;
+      while (stop > p && isSpace(stop[-1])) stop--;
+      continued = stop > p && stop[-1] == '\\' && memchr(p, '#', static_cast<size_t>(stop - p)) == NULL;
+
+      if (eol >= next_progress) {
+        next_progress = eol + kProgressStep;
+        CommandContext::setProgress(static_cast<int>(30 * (eol - begin) / (end - begin)));
+        if (CommandContext::threadStopped()) {
+          return false;
+        }
+      }
+      p = eol < end ? eol + 1 : end;
+      line++;
+    }
+    if (unit_begin == NULL) {
+      eda_error("%s: no '.model' found.\n", file_name_.c_str());
+      return false;
+    }
+    cut(end, line, false);
+    return true;
+  }
+
+  bool BlifReader::read(const std::string& file_name, int num_threads) {
+    file_name_ = file_name;
+    MappedFile file;
+    if (!file.open(file_name)) {
+      eda_error("Cannot open BLIF file '%s'.\n", file_name.c_str());
+      return false;
+    }
+    CommandContext::startProgressIndicator(0, 100);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    if (!split(begin, end)) {
+      if (CommandContext::threadStopped()) {
+        eda_warning("Reading '%s' is cancelled.\n", file_name.c_str());
+      }
+      return false;
+    }
+
+    // workers take the next unit until none is left
+    std::vector<Design*> parts(units_.size(), NULL);
+    std::vector<std::vector<Connection> > connections(units_.size());
+    std::vector<std::string> errors(units_.size());
+    std::vector<uint32_t> error_lines(units_.size(), 0);
+    std::atomic<size_t> next_unit(0);
+    std::atomic<size_t> num_done(0);
+    std::atomic<uint32_t> num_ignored(0);
+    std::atomic<bool> failed(false);
+    int workers = num_threads > 0 ? num_threads : numProcessors();
+    // the workers only count, the calling thread runs the first chunk and
+    // is the one that reports, so the progress never goes backwards
+    parallelFor(static_cast<size_t>(workers), [&](size_t chunk, size_t) {
+      int progress = 30;
+      size_t u;
+      while ((u = next_unit++) < units_.size() && !failed) {
+        if (CommandContext::threadStopped()) {
+          failed = true;
+          break;
+        }
+        const Unit& unit = units_[u];
+        parts[u] = new Design();
+        BlifUnitParser parser(unit.begin, unit.end, unit.line, parts[u], &connections[u]);
+        if (!parser.parse(unit.header)) {
+          errors[u] = parser.error();
+          error_lines[u] = parser.line();
+          failed = true;
+        }
+        num_ignored += parser.numIgnored();
+        size_t done = ++num_done;
+        if (chunk == 0 && 30 + static_cast<int>(done * 60 / units_.size()) != progress) {
+          progress = 30 + static_cast<int>(done * 60 / units_.size());
+          CommandContext::setProgress(progress);
+        }
+      }
+    }, workers);
+
+    bool ok = !failed;
+    std::vector<Connection> model_connections;
+    std::vector<Design::StringId> ids;
+    uint32_t num_subckts = 0;
+    for (size_t u = 0; u < units_.size(); u++) {
+      if (ok) {
+        if (units_[u].header) {
+          buildNets(design_, model_connections);
+          num_subckts = 0;
+        }
+        uint32_t instance_offset = design_->numInstances();
+        design_->append(*parts[u], &ids);
+        // '#' starts a comment, so these names never clash with a signal
+        char name[32];
+        for (uint32_t i = instance_offset; i < design_->numInstances(); i++) {
+          if (design_->instance(i).name == StringPool::kInvalidId) {
+            sprintf(name, "#%u", num_subckts++);
+            std::string instance_name = design_->str(design_->instance(i).type);
+            instance_name += name;
+            design_->set_instance_name(i, design_->strings().intern(instance_name));
+          }
+        }
+        // pin names only used by connections are not interned by append()
+        const StringPool& part_strings = parts[u]->strings();
+        auto map = [&](Design::StringId id) -> Design::StringId {
+          if (ids[id] == StringPool::kInvalidId) ids[id] = design_->strings().intern(part_strings.str(id), part_strings.length(id));
+          return ids[id];
+        };
+        for (size_t c = 0; c < connections[u].size(); c++) {
+          Connection connection = connections[u][c];
+          connection.signal = map(connection.signal);
+          connection.pin = map(connection.pin);
+          if (connection.instance != Design::kInvalidIndex) {
+            connection.instance += instance_offset;
+          }
+          model_connections.push_back(connection);
+        }
+      } else if (!errors[u].empty()) {
+        eda_error("%s:%u: %s.\n", file_name.c_str(), error_lines[u], errors[u].c_str());
+      }
+      delete parts[u];
+      parts[u] = NULL;
+      std::vector<Connection>().swap(connections[u]);
+    }
+    if (!ok) {
+      if (CommandContext::threadStopped()) {
+        eda_warning("Reading '%s' is cancelled.\n", file_name.c_str());
+      }
+      return false;
+    }
+    buildNets(design_, model_connections);
+
+    // the first model is the top one
+    design_->set_name(design_->cell(0).name);
+    design_->set_top(design_->cell(0).name);
+    design_->resolvePinDirections();
+    if (num_ignored > 0) {
+      eda_warning("%s: %u unsupported directives are ignored.\n", file_name.c_str(), static_cast<uint32_t>(num_ignored));
+    }
+    CommandContext::setProgress(100);
+    return true;
+  }
+
+}
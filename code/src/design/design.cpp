@@ -0,0 +1,390 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#include <algorithm>
+
+#include "design/design.h"
+#include "tcl/completion.h"
+#include "utility/binary_io.h"
+#include "utility/log.h"
+#include "utility/mapped_file.h"
+
+namespace eda {
+
+  namespace {
+    const char kSnapshotMagic[8] = { 'E', 'D', 'A', 'D', 'S', 'N', 'A', 'P' };
+    const uint32_t kSnapshotVersion = 1;
+  }
+
+  const uint32_t Design::kInvalidIndex;
+  Design* Design::design_ = NULL;
+
+  Design::Design() {
+    name_ = StringPool::kInvalidId;
+    part_ = StringPool::kInvalidId;
+    config_ = StringPool::kInvalidId;
+    top_ = StringPool::kInvalidId;
+  }
+
+  void Design::set_design(Design* design) {
+    if (design_ != NULL && design_ != design) delete design_;
+    design_ = design;
+    // the names are copied, so completion never reads a deleted design
+    gCompletion.indexDesign(design);
+  }
+
+  uint32_t Design::addCell(StringId name, StringId library) {
+    Cell cell;
+    cell.name = name;
+    cell.library = library;
+    cell.port_begin = numPorts();
+    cell.instance_begin = numInstances();
+    cell.net_begin = numNets();
+    cells_.push_back(cell);
+    return static_cast<uint32_t>(cells_.size() - 1);
+  }
+
+  void Design::addPort(StringId name, uint32_t width, PinDirection direction) {
+    Port port;
+    port.name = name;
+    port.width = width;
+    port.direction = static_cast<uint8_t>(direction);
+    ports_.push_back(port);
+  }
+
+  uint32_t Design::addInstance(const Instance& instance) {
+    instances_.push_back(instance);
+    return static_cast<uint32_t>(instances_.size() - 1);
+  }
+
+  uint32_t Design::addNet(StringId name, NetType type) {
+    Net net;
+    net.name = name;
+    net.config = StringPool::kInvalidId;
+    net.pin_begin = numPins();
+    net.pip_begin = numPips();
+    net.type = static_cast<uint8_t>(type);
+    nets_.push_back(net);
+    return static_cast<uint32_t>(nets_.size() - 1);
+  }
+
+  void Design::addPin(StringId instance_name, StringId pin, PinDirection direction) {
+    Pin p;
+    p.instance = instance_name;
+    p.name = pin;
+    p.direction = static_cast<uint8_t>(direction);
+    pins_.push_back(p);
+  }
+
+  void Design::addPip(const Pip& pip) {
+    pips_.push_back(pip);
+  }
+
+  void Design::append(const Design& part, std::vector<StringId>* string_ids) {
+    const StringPool& part_strings = part.strings();
+    std::vector<StringId> local_ids;
+    std::vector<StringId>& ids = string_ids != NULL ? *string_ids : local_ids;
+    ids.assign(part_strings.size(), StringPool::kInvalidId);
+    auto map = [&](StringId id) -> StringId {
+      if (id == StringPool::kInvalidId) return id;
+      if (ids[id] == StringPool::kInvalidId) ids[id] = strings_.intern(part_strings.str(id), part_strings.length(id));
+      return ids[id];
+    };
+
+    for (uint32_t c = 0; c < part.numCells(); c++) {
+      addCell(map(part.cell(c).name), map(part.cell(c).library));
+    }
+    for (uint32_t p = 0; p < part.numPorts(); p++) {
+      const Port& port = part.port(p);
+      addPort(map(port.name), port.width, static_cast<PinDirection>(port.direction));
+    }
+    for (uint32_t i = 0; i < part.numInstances(); i++) {
+      Instance instance = part.instance(i);
+      instance.name = map(instance.name);
+      instance.type = map(instance.type);
+      if (instance.config != StringPool::kInvalidId) {
+        instance.config = strings_.add(part_strings.str(instance.config), part_strings.length(instance.config));
+      }
+      addInstance(instance);
+    }
+    for (uint32_t n = 0; n < part.numNets(); n++) {
+      addNet(map(part.net(n).name), static_cast<NetType>(part.net(n).type));
+      if (part.net(n).config != StringPool::kInvalidId) {
+        setNetConfig(strings_.add(part_strings.str(part.net(n).config), part_strings.length(part.net(n).config)));
+      }
+      for (uint32_t p = part.netPinBegin(n); p < part.netPinEnd(n); p++) {
+        const Pin& pin = part.pin(p);
+        addPin(map(pin.instance), map(pin.name), static_cast<PinDirection>(pin.direction));
+      }
+      for (uint32_t p = part.netPipBegin(n); p < part.netPipEnd(n); p++) {
+        Pip pip = part.pip(p);
+        pip.tile = map(pip.tile);
+        pip.from = map(pip.from);
+        pip.to = map(pip.to);
+        pip.direction = map(pip.direction);
+        addPip(pip);
+      }
+    }
+  }
+
+  uint32_t Design::resolvePins() {
+    instance_index_.resize(instances_.size());
+    for (uint32_t i = 0; i < instances_.size(); i++) {
+      instance_index_[i] = std::make_pair(instances_[i].name, i);
+    }
+    std::sort(instance_index_.begin(), instance_index_.end());
+
+    uint32_t num_unresolved = 0;
+    for (size_t p = 0; p < pins_.size(); p++) {
+      std::vector<std::pair<StringId, uint32_t> >::const_iterator iter =
+        std::lower_bound(instance_index_.begin(), instance_index_.end(), std::make_pair(pins_[p].instance, 0u));
+      if (iter != instance_index_.end() && iter->first == pins_[p].instance) {
+        pins_[p].instance = iter->second;
+      } else {
+        pins_[p].instance = kInvalidIndex;
+        num_unresolved++;
+      }
+    }
+    return num_unresolved;
+  }
+
+  uint32_t Design::resolveCellPins() {
+    typedef std::pair<StringId, uint32_t> NameIndex;
+    uint32_t num_unresolved = 0;
+    std::vector<NameIndex> instance_index;
+    for (uint32_t c = 0; c < cells_.size(); c++) {
+      instance_index.clear();
+      for (uint32_t i = cellInstanceBegin(c); i < cellInstanceEnd(c); i++) {
+        instance_index.push_back(std::make_pair(instances_[i].name, i));
+      }
+      std::sort(instance_index.begin(), instance_index.end());
+      uint32_t net_begin = cellNetBegin(c);
+      uint32_t net_end = cellNetEnd(c);
+      if (net_begin == net_end) {
+        continue;
+      }
+      for (uint32_t p = netPinBegin(net_begin); p < netPinEnd(net_end - 1); p++) {
+        Pin& pin = pins_[p];
+        if (pin.instance == kInvalidIndex) {
+          continue;
+        }
+        auto iter = std::lower_bound(instance_index.begin(), instance_index.end(), std::make_pair(pin.instance, 0u));
+        if (iter == instance_index.end() || iter->first != pin.instance) {
+          pin.instance = kInvalidIndex;
+          num_unresolved++;
+          continue;
+        }
+        pin.instance = iter->second;
+      }
+    }
+    resolvePinDirections();
+    return num_unresolved;
+  }
+
+  void Design::resolvePinDirections() {
+    typedef std::pair<StringId, uint32_t> NameIndex;
+    std::vector<NameIndex> cell_index(cells_.size());
+    for (uint32_t c = 0; c < cells_.size(); c++) {
+      cell_index[c] = std::make_pair(cells_[c].name, c);
+    }
+    std::sort(cell_index.begin(), cell_index.end());
+    // (cell << 32 | port name) -> direction
+    std::vector<std::pair<uint64_t, uint8_t> > port_directions(ports_.size());
+    for (uint32_t c = 0; c < cells_.size(); c++) {
+      for (uint32_t p = cellPortBegin(c); p < cellPortEnd(c); p++) {
+        port_directions[p] = std::make_pair(static_cast<uint64_t>(c) << 32 | ports_[p].name, ports_[p].direction);
+      }
+    }
+    std::sort(port_directions.begin(), port_directions.end());
+
+    auto findDirection = [&](uint32_t c, StringId name, uint8_t& direction) {
+      uint64_t key = static_cast<uint64_t>(c) << 32 | name;
+      auto iter = std::lower_bound(port_directions.begin(), port_directions.end(), std::make_pair(key, static_cast<uint8_t>(0)));
+      if (iter == port_directions.end() || iter->first != key) {
+        // a bus member "name[i]", look up the bus
+        const char* bracket = strchr(strings_.str(name), '[');
+        if (bracket == NULL) return;
+        StringId bus = strings_.find(strings_.str(name), static_cast<size_t>(bracket - strings_.str(name)));
+        if (bus == StringPool::kInvalidId) return;
+        key = static_cast<uint64_t>(c) << 32 | bus;
+        iter = std::lower_bound(port_directions.begin(), port_directions.end(), std::make_pair(key, static_cast<uint8_t>(0)));
+        if (iter == port_directions.end() || iter->first != key) return;
+      }
+      direction = iter->second;
+    };
+
+    // the cell instantiated by the previous pin, instances of one cell
+    // usually come in runs
+    StringId last_type = StringPool::kInvalidId;
+    uint32_t last_cell = kInvalidIndex;
+    for (uint32_t c = 0; c < cells_.size(); c++) {
+      uint32_t net_begin = cellNetBegin(c);
+      uint32_t net_end = cellNetEnd(c);
+      if (net_begin == net_end) {
+        continue;
+      }
+      for (uint32_t p = netPinBegin(net_begin); p < netPinEnd(net_end - 1); p++) {
+        Pin& pin = pins_[p];
+        if (pin.instance == kInvalidIndex) {
+          findDirection(c, pin.name, pin.direction);
+          continue;
+        }
+        StringId type = instances_[pin.instance].type;
+        if (type != last_type) {
+          last_type = type;
+          auto cell_iter = std::lower_bound(cell_index.begin(), cell_index.end(), std::make_pair(type, 0u));
+          last_cell = cell_iter != cell_index.end() && cell_iter->first == type ? cell_iter->second : kInvalidIndex;
+        }
+        if (last_cell != kInvalidIndex) {
+          findDirection(last_cell, pin.name, pin.direction);
+        }
+      }
+    }
+  }
+
+  uint32_t Design::findCell(StringId name) const {
+    for (uint32_t c = 0; c < cells_.size(); c++) {
+      if (cells_[c].name == name) {
+        return c;
+      }
+    }
+    return kInvalidIndex;
+  }
+
+  uint32_t Design::findInstance(const std::string& name) const {
+    StringId id = strings_.find(name);
+    if (id == StringPool::kInvalidId) {
+      return kInvalidIndex;
+    }
+    std::vector<std::pair<StringId, uint32_t> >::const_iterator iter =
+      std::lower_bound(instance_index_.begin(), instance_index_.end(), std::make_pair(id, 0u));
+    if (iter == instance_index_.end() || iter->first != id) {
+      return kInvalidIndex;
+    }
+    return iter->second;
+  }
+
+  size_t Design::memoryUsage() const {
+    return strings_.memoryUsage() +
+      instances_.capacity() * sizeof(Instance) +
+      nets_.capacity() * sizeof(Net) +
+      pins_.capacity() * sizeof(Pin) +
+      pips_.capacity() * sizeof(Pip) +
+      cells_.capacity() * sizeof(Cell) +
+      ports_.capacity() * sizeof(Port) +
+      instance_index_.capacity() * sizeof(std::pair<StringId, uint32_t>);
+  }
+
+  bool Design::save(const std::string& file_name, uint64_t source_key) const {
+    // written under a temporary name so that a crash never leaves a
+    // truncated snapshot behind
+    std::string temp_name = file_name + ".tmp";
+    FILE* fp = fopen(temp_name.c_str(), "wb");
+    if (fp == NULL) {
+      eda_error("Cannot open '%s' for writing.\n", temp_name.c_str());
+      return false;
+    }
+    StringId header[4] = { name_, part_, config_, top_ };
+    bool ok = fwrite(kSnapshotMagic, sizeof(kSnapshotMagic), 1, fp) == 1 &&
+      fwrite(&kSnapshotVersion, sizeof(kSnapshotVersion), 1, fp) == 1 &&
+      fwrite(&source_key, sizeof(source_key), 1, fp) == 1 &&
+      strings_.save(fp) && fwrite(header, sizeof(header), 1, fp) == 1 &&
+      writeVector(fp, cells_) && writeVector(fp, ports_) && writeVector(fp, instances_) &&
+      writeVector(fp, nets_) && writeVector(fp, pins_) && writeVector(fp, pips_) &&
+      writeVector(fp, instance_index_);
+    if (fclose(fp) != 0) ok = false;
+    remove(file_name.c_str());
+    if (!ok || rename(temp_name.c_str(), file_name.c_str()) != 0) {
+      eda_error("Failed to write design snapshot '%s'.\n", file_name.c_str());
+      remove(temp_name.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool Design::load(const std::string& file_name, uint64_t source_key) {
+    MappedFile file;
+    if (!file.open(file_name)) {
+      return false;
+    }
+    const char* p = file.data();
+    const char* end = p + file.size();
+    if (file.size() < sizeof(kSnapshotMagic) || memcmp(p, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+      return false;
+    }
+    p += sizeof(kSnapshotMagic);
+    uint32_t version = 0;
+    uint64_t key = 0;
+    // a snapshot of another netlist or reader version is simply stale
+    if (!readValue(p, end, version) || version != kSnapshotVersion || !readValue(p, end, key) || key != source_key) {
+      return false;
+    }
+    StringId header[4];
+    bool ok = strings_.load(p, end) && readValue(p, end, header) &&
+      readVector(p, end, cells_) && readVector(p, end, ports_) && readVector(p, end, instances_) &&
+      readVector(p, end, nets_) && readVector(p, end, pins_) && readVector(p, end, pips_) &&
+      readVector(p, end, instance_index_) && p == end;
+
+    // reject anything that would index out of the tables
+    uint32_t num_strings = strings_.size();
+    auto validString = [&](StringId id) { return id == StringPool::kInvalidId || id < num_strings; };
+    for (size_t i = 0; ok && i < 4; i++) {
+      ok = validString(header[i]);
+    }
+    for (size_t c = 0; ok && c < cells_.size(); c++) {
+      const Cell& cell = cells_[c];
+      const Cell* next = c + 1 < cells_.size() ? &cells_[c + 1] : NULL;
+      ok = validString(cell.name) && validString(cell.library) &&
+        cell.port_begin <= (next != NULL ? next->port_begin : numPorts()) &&
+        cell.instance_begin <= (next != NULL ? next->instance_begin : numInstances()) &&
+        cell.net_begin <= (next != NULL ? next->net_begin : numNets());
+    }
+    for (size_t i = 0; ok && i < ports_.size(); i++) {
+      ok = validString(ports_[i].name);
+    }
+    for (size_t i = 0; ok && i < instances_.size(); i++) {
+      const Instance& instance = instances_[i];
+      ok = validString(instance.name) && validString(instance.type) && validString(instance.tile) &&
+        validString(instance.site) && validString(instance.config);
+    }
+    for (size_t n = 0; ok && n < nets_.size(); n++) {
+      const Net& net = nets_[n];
+      ok = validString(net.name) && validString(net.config) &&
+        net.pin_begin <= (n + 1 < nets_.size() ? nets_[n + 1].pin_begin : numPins()) &&
+        net.pip_begin <= (n + 1 < nets_.size() ? nets_[n + 1].pip_begin : numPips());
+    }
+    for (size_t i = 0; ok && i < pins_.size(); i++) {
+      ok = validString(pins_[i].name) && (pins_[i].instance == kInvalidIndex || pins_[i].instance < numInstances());
+    }
+    for (size_t i = 0; ok && i < pips_.size(); i++) {
+      const Pip& pip = pips_[i];
+      ok = validString(pip.tile) && validString(pip.from) && validString(pip.to) && validString(pip.direction);
+    }
+    for (size_t i = 0; ok && i < instance_index_.size(); i++) {
+      ok = instance_index_[i].second < numInstances();
+    }
+    if (!ok) {
+      eda_warning("Design snapshot '%s' is corrupted and ignored.\n", file_name.c_str());
+      strings_.clear();
+      cells_.clear();
+      ports_.clear();
+      instances_.clear();
+      nets_.clear();
+      pins_.clear();
+      pips_.clear();
+      instance_index_.clear();
+      return false;
+    }
+    name_ = header[0];
+    part_ = header[1];
+    config_ = header[2];
+    top_ = header[3];
+    return true;
+  }
+
+}
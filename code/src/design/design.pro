@@ -0,0 +1,28 @@
+!include($$top_srcdir/common.pri) {
+    error("Couldn't find the common.pri file!")
+}
+
+TEMPLATE = lib
+CONFIG += staticlib
+
+unix {
+    QMAKE_CXXFLAGS -= -Werror
+}
+win32 {
+    QMAKE_CXXFLAGS -= /WX
+}
+
+HEADERS += $$top_srcdir/include/design/blif_reader.h \
+           $$top_srcdir/include/design/design.h \
+           $$top_srcdir/include/design/design_snapshot.h \
+           $$top_srcdir/include/design/edif_reader.h \
+           $$top_srcdir/include/design/edif_tokenizer.h \
+           $$top_srcdir/include/design/xdl_reader.h \
+
+SOURCES += blif_reader.cpp \
+           design.cpp \
+           design_commands.cpp \
+           design_snapshot.cpp \
+           edif_reader.cpp \
+           edif_tokenizer.cpp \
+           xdl_reader.cpp \
@@ -0,0 +1,143 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include "tcl/commands.h"
+#include "design/blif_reader.h"
+#include "design/design.h"
+#include "design/design_snapshot.h"
+#include "design/edif_reader.h"
+#include "design/xdl_reader.h"
+#include "gui/project/project.h"
+#include "utility/log.h"
+#include "utility/memory_tracker.h"
+
+namespace eda {
+
+  // read_xdl [-file <string>]
+  // Reads the XDL file, by default the one of the open project, and makes it
+  // the current design.
+  int ReadXdl(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DESIGN);
+    std::string file_name;
+    if (!Commands::getStringOption(objc, objv, "-file", file_name) &&
+      Project::project() != NULL && Project::project()->hasXdlFile()) {
+      file_name = Project::project()->xdl_file().toStdString();
+    }
+    if (file_name.empty()) {
+      eda_error("No XDL file is given and the current project has none.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+
+    Design* design = new Design();
+    XdlReader reader(design);
+    if (!reader.read(file_name)) {
+      delete design;
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    Design::set_design(design);
+    DesignSnapshot::save(Project::project(), *design, file_name);
+    eda_info("Design '%s': %u instances, %u nets, %u pins, %u pips, %dMB.\n", design->str(design->name()),
+      design->numInstances(), design->numNets(), design->numPins(), design->numPips(),
+      static_cast<int>(design->memoryUsage() >> 20));
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // read_edif [-file <string>] [-threads <int>]
+  // Reads the EDIF netlist, by default the one of the open project, with the
+  // given number of threads (all processors by default).
+  int ReadEdif(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DESIGN);
+    std::string file_name;
+    if (!Commands::getStringOption(objc, objv, "-file", file_name) &&
+      Project::project() != NULL && Project::project()->hasEdifFile()) {
+      file_name = Project::project()->edif_file().toStdString();
+    }
+    int num_threads = 0;
+    Commands::getIntOption(objc, objv, "-threads", num_threads);
+    if (file_name.empty()) {
+      eda_error("No EDIF file is given and the current project has none.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+
+    Design* design = new Design();
+    EdifReader reader(design);
+    if (!reader.read(file_name, num_threads)) {
+      delete design;
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    Design::set_design(design);
+    DesignSnapshot::save(Project::project(), *design, file_name);
+    eda_info("Design '%s': %u cells, %u instances, %u nets, %u pins, %dMB.\n", design->str(design->name()),
+      design->numCells(), design->numInstances(), design->numNets(), design->numPins(),
+      static_cast<int>(design->memoryUsage() >> 20));
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // read_blif [-file <string>] [-threads <int>]
+  // Reads the BLIF netlist, by default the one of the open project, with the
+  // given number of threads (all processors by default).
+  int ReadBlif(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DESIGN);
+    std::string file_name;
+    if (!Commands::getStringOption(objc, objv, "-file", file_name) &&
+      Project::project() != NULL && Project::project()->hasBlifFile()) {
+      file_name = Project::project()->blif_file().toStdString();
+    }
+    int num_threads = 0;
+    Commands::getIntOption(objc, objv, "-threads", num_threads);
+    if (file_name.empty()) {
+      eda_error("No BLIF file is given and the current project has none.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+
+    Design* design = new Design();
+    BlifReader reader(design);
+    if (!reader.read(file_name, num_threads)) {
+      delete design;
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    Design::set_design(design);
+    DesignSnapshot::save(Project::project(), *design, file_name);
+    eda_info("Design '%s': %u cells, %u instances, %u nets, %u pins, %dMB.\n", design->str(design->name()),
+      design->numCells(), design->numInstances(), design->numNets(), design->numPins(),
+      static_cast<int>(design->memoryUsage() >> 20));
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // read_snapshot
+  // Drops the current design and loads the snapshot of the open project if
+  // it is up to date. Run when a project is opened, so hashing the netlist
+  // and loading the snapshot happen on the command thread.
+  int ReadSnapshot(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    Design::release();
+    DesignSnapshot::open(Project::project());
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+}
@@ -0,0 +1,73 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include "design/design.h"
+#include "design/design_snapshot.h"
+#include "gui/project/project.h"
+#include "utility/file.h"
+#include "utility/hash.h"
+#include "utility/log.h"
+#include "utility/memory_tracker.h"
+
+namespace eda {
+
+  const uint32_t DesignSnapshot::kReaderVersion;
+
+  std::string DesignSnapshot::fileName(Project* project) {
+    return (project->project_path() + "/" + project->project_name() + ".dsnap").toStdString();
+  }
+
+  std::string DesignSnapshot::netlistFile(Project* project) {
+    if (project->hasXdlFile()) return project->xdl_file().toStdString();
+    if (project->hasEdifFile()) return project->edif_file().toStdString();
+    if (project->hasBlifFile()) return project->blif_file().toStdString();
+    return std::string();
+  }
+
+  // The original file is hashed if it still exists, the copy in the
+  // project otherwise.
+  bool DesignSnapshot::sourceKey(Project* project, uint64_t& key) {
+    std::string source;
+    if (project->hasXdlFile()) {
+      source = project->ori_xdl_file().toStdString();
+    } else if (project->hasEdifFile()) {
+      source = project->ori_edif_file().toStdString();
+    } else if (project->hasBlifFile()) {
+      source = project->ori_blif_file().toStdString();
+    }
+    if (source.empty() || File::access(source.c_str(), 0) != 0) {
+      source = netlistFile(project);
+    }
+    return !source.empty() && hashFile(source, kReaderVersion, key);
+  }
+
+  bool DesignSnapshot::open(Project* project) {
+    MemoryTagScope scope(MemoryTracker::TAG_DESIGN);
+    uint64_t key = 0;
+    if (project == NULL || !sourceKey(project, key)) {
+      return false;
+    }
+    Design* design = new Design();
+    if (!design->load(fileName(project), key)) {
+      delete design;
+      return false;
+    }
+    Design::set_design(design);
+    eda_info("Design '%s' is loaded from its snapshot: %u instances, %u nets, %dMB.\n", design->str(design->name()),
+      design->numInstances(), design->numNets(), static_cast<int>(design->memoryUsage() >> 20));
+    return true;
+  }
+
+  bool DesignSnapshot::save(Project* project, const Design& design, const std::string& netlist_file) {
+    uint64_t key = 0;
+    if (project == NULL || netlist_file != netlistFile(project) || !sourceKey(project, key)) {
+      return false;
+    }
+    return design.save(fileName(project), key);
+  }
+
+}
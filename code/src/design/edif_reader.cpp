@@ -0,0 +1,480 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdlib.h>
+#include <atomic>
+
+#include "design/edif_reader.h"
+#include "design/edif_tokenizer.h"
+#include "gui/command_context.h"
+#include "utility/log.h"
+#include "utility/mapped_file.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  namespace {
+
+    // Recursive descent parser for one unit, the result goes to a private
+    // design so that workers never share state.
+    class EdifUnitParser {
+    public:
+      EdifUnitParser(const char* begin, const char* end, Design* design)
+        : tokenizer_(begin, end), design_(design) {}
+
+      bool parseCell(const std::string& library);
+      bool parseContents();
+      const std::string& error() const { return error_; }
+      const char* position() const { return tokenizer_.position(); }
+
+    private:
+      Design::StringId intern() { return design_->strings().intern(tokenizer_.text(), tokenizer_.length()); }
+      Design::StringId parseName(uint32_t* width);
+      bool parseView();
+      bool parseInterface();
+      bool parsePort();
+      bool parseInstance();
+      bool parseNet();
+      bool parsePortRef();
+      bool fail(const char* message) {
+        error_ = message;
+        return false;
+      }
+
+      EdifTokenizer tokenizer_;
+      Design* design_;
+      std::string error_;
+      std::string scratch_;
+    };
+
+    // <name> | (rename <name> "<original>") | (array <name> <width>)
+    Design::StringId EdifUnitParser::parseName(uint32_t* width) {
+      if (width != NULL) *width = 1;
+      if (tokenizer_.kind() == EdifTokenizer::TOKEN_ATOM) {
+        return intern();
+      }
+      if (tokenizer_.kind() != EdifTokenizer::TOKEN_OPEN) {
+        return StringPool::kInvalidId;
+      }
+      tokenizer_.next();
+      if (tokenizer_.is("rename")) {
+        if (tokenizer_.next() != EdifTokenizer::TOKEN_ATOM) return StringPool::kInvalidId;
+        Design::StringId name = intern();
+        tokenizer_.skipForm();
+        return name;
+      }
+      if (tokenizer_.is("array")) {
+        tokenizer_.next();
+        Design::StringId name = parseName(NULL);
+        if (tokenizer_.next() == EdifTokenizer::TOKEN_ATOM && width != NULL) {
+          *width = static_cast<uint32_t>(strtoul(std::string(tokenizer_.text(), tokenizer_.length()).c_str(), NULL, 10));
+        }
+        if (tokenizer_.kind() != EdifTokenizer::TOKEN_CLOSE) tokenizer_.skipForm();
+        return name;
+      }
+      return StringPool::kInvalidId;
+    }
+
+    // (cell <name> (cellType ...) (view ...) ...), the unit may end anywhere
+    // inside the contents of the view
+    bool EdifUnitParser::parseCell(const std::string& library) {
+      if (tokenizer_.next() != EdifTokenizer::TOKEN_OPEN || tokenizer_.next() != EdifTokenizer::TOKEN_ATOM || !tokenizer_.is("cell")) {
+        return fail("'(cell' expected");
+      }
+      tokenizer_.next();
+      Design::StringId name = parseName(NULL);
+      if (name == StringPool::kInvalidId) {
+        return fail("cell name expected");
+      }
+      design_->addCell(name, design_->strings().intern(library));
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("view")) {
+          if (!parseView()) return false;
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      return true;
+    }
+
+    bool EdifUnitParser::parseView() {
+      tokenizer_.next();
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("interface")) {
+          if (!parseInterface()) return false;
+        } else if (tokenizer_.is("contents")) {
+          if (!parseContents()) return false;
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      return true;
+    }
+
+    bool EdifUnitParser::parseInterface() {
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("port")) {
+          if (!parsePort()) return false;
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      return true;
+    }
+
+    // (port <name> (direction INPUT|OUTPUT|INOUT) ...)
+    bool EdifUnitParser::parsePort() {
+      tokenizer_.next();
+      uint32_t width = 1;
+      Design::StringId name = parseName(&width);
+      if (name == StringPool::kInvalidId) {
+        return fail("port name expected");
+      }
+      Design::PinDirection direction = Design::PIN_UNKNOWN;
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("direction")) {
+          tokenizer_.next();
+          if (tokenizer_.is("input")) {
+            direction = Design::PIN_INPUT;
+          } else if (tokenizer_.is("output")) {
+            direction = Design::PIN_OUTPUT;
+          } else if (tokenizer_.is("inout")) {
+            direction = Design::PIN_INOUT;
+          }
+        }
+        tokenizer_.skipForm();
+      }
+      design_->addPort(name, width, direction);
+      return true;
+    }
+
+    // instance and net forms up to the end of the contents or of the unit
+    bool EdifUnitParser::parseContents() {
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("instance")) {
+          if (!parseInstance()) return false;
+        } else if (tokenizer_.is("net")) {
+          if (!parseNet()) return false;
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      return true;
+    }
+
+    // (instance <name> (viewRef <view> (cellRef <cell> (libraryRef <lib>)))
+    //   (property <name> (string "<value>")) ...)
+    // The properties are kept as "name=value" pairs in the config string.
+    bool EdifUnitParser::parseInstance() {
+      tokenizer_.next();
+      Design::Instance instance;
+      instance.name = parseName(NULL);
+      instance.type = StringPool::kInvalidId;
+      instance.tile = StringPool::kInvalidId;
+      instance.site = StringPool::kInvalidId;
+      instance.config = StringPool::kInvalidId;
+      if (instance.name == StringPool::kInvalidId) {
+        return fail("instance name expected");
+      }
+      scratch_.clear();
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("viewRef")) {
+          tokenizer_.next();
+          while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+            tokenizer_.next();
+            if (tokenizer_.is("cellRef") && tokenizer_.next() == EdifTokenizer::TOKEN_ATOM) {
+              instance.type = intern();
+            }
+            tokenizer_.skipForm();
+          }
+        } else if (tokenizer_.is("cellRef")) {
+          if (tokenizer_.next() == EdifTokenizer::TOKEN_ATOM) {
+            instance.type = intern();
+          }
+          tokenizer_.skipForm();
+        } else if (tokenizer_.is("property")) {
+          tokenizer_.next();
+          Design::StringId name = parseName(NULL);
+          if (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+            // (string "<value>"), (integer <value>), (boolean (true)) ...
+            tokenizer_.next();
+            EdifTokenizer::TokenKind value = tokenizer_.next();
+            if (name != StringPool::kInvalidId && (value == EdifTokenizer::TOKEN_STRING || value == EdifTokenizer::TOKEN_ATOM)) {
+              if (!scratch_.empty()) scratch_ += ' ';
+              scratch_.append(design_->strings().str(name));
+              scratch_ += '=';
+              scratch_.append(tokenizer_.text(), tokenizer_.length());
+            }
+            if (value == EdifTokenizer::TOKEN_OPEN) tokenizer_.skipForm();
+            if (value != EdifTokenizer::TOKEN_CLOSE) tokenizer_.skipForm();
+            tokenizer_.skipForm();
+          } else if (tokenizer_.kind() != EdifTokenizer::TOKEN_CLOSE) {
+            tokenizer_.skipForm();
+          }
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      if (!scratch_.empty()) {
+        instance.config = design_->strings().add(scratch_.data(), scratch_.size());
+      }
+      design_->addInstance(instance);
+      return true;
+    }
+
+    // (net <name> (joined (portRef ...) ...) ...)
+    bool EdifUnitParser::parseNet() {
+      tokenizer_.next();
+      Design::StringId name = parseName(NULL);
+      if (name == StringPool::kInvalidId) {
+        return fail("net name expected");
+      }
+      design_->addNet(name, Design::NET_WIRE);
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("joined")) {
+          while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+            tokenizer_.next();
+            if (tokenizer_.is("portRef")) {
+              if (!parsePortRef()) return false;
+            } else {
+              tokenizer_.skipForm();
+            }
+          }
+        } else {
+          tokenizer_.skipForm();
+        }
+      }
+      return true;
+    }
+
+    // (portRef <port> | (member <port> <index>) [(instanceRef <instance>)])
+    // A member is named "<port>[<index>]" with the EDIF member index.
+    bool EdifUnitParser::parsePortRef() {
+      Design::StringId pin = StringPool::kInvalidId;
+      if (tokenizer_.next() == EdifTokenizer::TOKEN_ATOM) {
+        pin = intern();
+      } else if (tokenizer_.kind() == EdifTokenizer::TOKEN_OPEN && tokenizer_.next() == EdifTokenizer::TOKEN_ATOM && tokenizer_.is("member")) {
+        if (tokenizer_.next() != EdifTokenizer::TOKEN_ATOM) {
+          return fail("port name expected in member");
+        }
+        scratch_.assign(tokenizer_.text(), tokenizer_.length());
+        if (tokenizer_.next() != EdifTokenizer::TOKEN_ATOM) {
+          return fail("index expected in member");
+        }
+        scratch_ += '[';
+        scratch_.append(tokenizer_.text(), tokenizer_.length());
+        scratch_ += ']';
+        pin = design_->strings().intern(scratch_);
+        tokenizer_.skipForm();
+      }
+      if (pin == StringPool::kInvalidId) {
+        return fail("port reference expected");
+      }
+      Design::StringId instance = Design::kInvalidIndex;
+      while (tokenizer_.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer_.next();
+        if (tokenizer_.is("instanceRef") && tokenizer_.next() == EdifTokenizer::TOKEN_ATOM) {
+          instance = intern();
+        }
+        tokenizer_.skipForm();
+      }
+      design_->addPin(instance, pin, Design::PIN_UNKNOWN);
+      return true;
+    }
+
+    // the name of a library or design form, the tokenizer is behind the keyword
+    std::string readFormName(EdifTokenizer& tokenizer) {
+      if (tokenizer.next() == EdifTokenizer::TOKEN_OPEN) {
+        tokenizer.next();
+        tokenizer.next();
+      }
+      return tokenizer.kind() == EdifTokenizer::TOKEN_ATOM ? std::string(tokenizer.text(), tokenizer.length()) : std::string();
+    }
+
+  }
+
+  const size_t EdifReader::kUnitSize;
+
+  EdifReader::EdifReader(Design* design) {
+    design_ = design;
+  }
+
+  // Walks the parentheses of the whole file once. The forms are at depth
+  // (edif 0 (library 1 (cell 2 (view 3 (contents 4 (instance/net 5.
+  bool EdifReader::split(const char* begin, const char* end) {
+    const size_t kProgressStep = 64 * 1024 * 1024;
+    const char* next_progress = begin + kProgressStep;
+    int depth = 0;
+    const char* cell_begin = NULL;
+    const char* unit_begin = NULL;
+    bool in_contents = false;
+    uint32_t library = 0;
+    // the form at depth 1 is a library or external, cells belong to it
+    bool in_library = false;
+    const char* p = begin;
+    while (true) {
+      const char* q = EdifTokenizer::findStructural(p, end);
+      if (q >= next_progress) {
+        next_progress = q + kProgressStep;
+        CommandContext::setProgress(static_cast<int>(30 * (q - begin) / (end - begin)));
+        if (CommandContext::threadStopped()) {
+          return false;
+        }
+      }
+      if (q >= end) {
+        break;
+      }
+      p = q + 1;
+      if (*q == '"') {
+        const char* quote = static_cast<const char*>(memchr(p, '"', static_cast<size_t>(end - p)));
+        p = quote == NULL ? end : quote + 1;
+        continue;
+      }
+      if (*q == ')') {
+        depth--;
+        if (depth == 4) {
+          in_contents = false;
+        } else if (depth == 2 && cell_begin != NULL) {
+          Unit unit;
+          unit.begin = unit_begin;
+          unit.end = q + 1;
+          unit.library = library;
+          unit.header = unit_begin == cell_begin;
+          units_.push_back(unit);
+          cell_begin = NULL;
+        }
+        continue;
+      }
+      if (depth == 5 && in_contents && q - unit_begin >= static_cast<ptrdiff_t>(kUnitSize)) {
+        Unit unit;
+        unit.begin = unit_begin;
+        unit.end = q;
+        unit.library = library;
+        unit.header = unit_begin == cell_begin;
+        units_.push_back(unit);
+        unit_begin = q;
+      } else if (depth >= 1 && depth <= 4) {
+        EdifTokenizer tokenizer(p, end);
+        tokenizer.next();
+        if (depth == 1) {
+          in_library = tokenizer.is("library") || tokenizer.is("external");
+        }
+        if (depth == 1 && in_library) {
+          library = static_cast<uint32_t>(libraries_.size());
+          libraries_.push_back(readFormName(tokenizer));
+        } else if (depth == 1 && tokenizer.is("design")) {
+          design_name_ = readFormName(tokenizer);
+          if (tokenizer.next() == EdifTokenizer::TOKEN_OPEN && tokenizer.next() == EdifTokenizer::TOKEN_ATOM && tokenizer.is("cellRef")) {
+            top_cell_ = readFormName(tokenizer);
+          }
+        } else if (depth == 2 && tokenizer.is("cell")) {
+          if (!in_library) {
+            eda_error("%s: byte %llu: cell outside of a library.\n", file_name_.c_str(),
+              static_cast<unsigned long long>(q - begin));
+            return false;
+          }
+          cell_begin = q;
+          unit_begin = q;
+        } else if (depth == 4 && cell_begin != NULL && tokenizer.is("contents")) {
+          in_contents = true;
+        }
+      }
+      depth++;
+    }
+    if (depth != 0) {
+      eda_error("%s: unbalanced parentheses.\n", file_name_.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  bool EdifReader::read(const std::string& file_name, int num_threads) {
+    file_name_ = file_name;
+    MappedFile file;
+    if (!file.open(file_name)) {
+      eda_error("Cannot open EDIF file '%s'.\n", file_name.c_str());
+      return false;
+    }
+    CommandContext::startProgressIndicator(0, 100);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    if (!split(begin, end)) {
+      return false;
+    }
+
+    // workers take the next unit until none is left
+    std::vector<Design*> parts(units_.size(), NULL);
+    std::vector<std::string> errors(units_.size());
+    std::vector<size_t> error_offsets(units_.size(), 0);
+    std::atomic<size_t> next_unit(0);
+    std::atomic<size_t> num_done(0);
+    std::atomic<bool> failed(false);
+    int workers = num_threads > 0 ? num_threads : numProcessors();
+    // the workers only count, the calling thread runs the first chunk and
+    // is the one that reports, so the progress never goes backwards
+    parallelFor(static_cast<size_t>(workers), [&](size_t chunk, size_t) {
+      int progress = 30;
+      size_t u;
+      while ((u = next_unit++) < units_.size() && !failed) {
+        if (CommandContext::threadStopped()) {
+          failed = true;
+          break;
+        }
+        const Unit& unit = units_[u];
+        parts[u] = new Design();
+        EdifUnitParser parser(unit.begin, unit.end, parts[u]);
+        bool ok = unit.header ? parser.parseCell(libraries_[unit.library]) : parser.parseContents();
+        if (!ok) {
+          errors[u] = parser.error();
+          error_offsets[u] = static_cast<size_t>(parser.position() - begin);
+          failed = true;
+        }
+        size_t done = ++num_done;
+        if (chunk == 0 && 30 + static_cast<int>(done * 65 / units_.size()) != progress) {
+          progress = 30 + static_cast<int>(done * 65 / units_.size());
+          CommandContext::setProgress(progress);
+        }
+      }
+    }, workers);
+
+    bool ok = !failed;
+    for (size_t u = 0; u < units_.size(); u++) {
+      if (ok) {
+        design_->append(*parts[u]);
+      } else if (!errors[u].empty()) {
+        eda_error("%s: byte %llu: %s.\n", file_name.c_str(), static_cast<unsigned long long>(error_offsets[u]), errors[u].c_str());
+      }
+      delete parts[u];
+      parts[u] = NULL;
+    }
+    if (!ok) {
+      if (CommandContext::threadStopped()) {
+        eda_warning("Reading '%s' is cancelled.\n", file_name.c_str());
+      }
+      return false;
+    }
+
+    design_->set_name(design_->strings().intern(design_name_));
+    if (!top_cell_.empty()) {
+      design_->set_top(design_->strings().intern(top_cell_));
+    }
+    uint32_t num_unresolved = design_->resolveCellPins();
+    if (num_unresolved > 0) {
+      eda_warning("%s: %u pins refer to unknown instances.\n", file_name.c_str(), num_unresolved);
+    }
+    CommandContext::setProgress(100);
+    return true;
+  }
+
+}
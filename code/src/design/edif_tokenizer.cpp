@@ -0,0 +1,269 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <ctype.h>
+
+#include "design/edif_tokenizer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDA_EDIF_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// the AVX2 code is compiled with a target attribute, so the rest of the
+// program does not need -mavx2
+#if defined(EDA_EDIF_SSE2) && defined(__GNUC__)
+#define EDA_EDIF_AVX2
+#include <immintrin.h>
+#endif
+
+namespace eda {
+
+  namespace {
+
+    inline bool isSpace(char c) {
+      return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    inline bool isDelimiter(char c) {
+      return isSpace(c) || c == '(' || c == ')' || c == '"';
+    }
+
+    const char* skipSpaceScalar(const char* p, const char* end) {
+      while (p < end && isSpace(*p)) p++;
+      return p;
+    }
+
+    const char* findDelimiterScalar(const char* p, const char* end) {
+      while (p < end && !isDelimiter(*p)) p++;
+      return p;
+    }
+
+    const char* findStructuralScalar(const char* p, const char* end) {
+      while (p < end && *p != '(' && *p != ')' && *p != '"') p++;
+      return p;
+    }
+
+#ifdef EDA_EDIF_SSE2
+    inline int firstBit(unsigned int mask) {
+#ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<int>(index);
+#else
+      return __builtin_ctz(mask);
+#endif
+    }
+
+    inline __m128i spaceMask16(__m128i v) {
+      return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))));
+    }
+
+    inline __m128i structuralMask16(__m128i v) {
+      return _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('(')), _mm_cmpeq_epi8(v, _mm_set1_epi8(')'))),
+        _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    }
+
+    const char* skipSpaceSse2(const char* p, const char* end) {
+      for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(spaceMask16(v))) ^ 0xffffu;
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return skipSpaceScalar(p, end);
+    }
+
+    const char* findDelimiterSse2(const char* p, const char* end) {
+      for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(spaceMask16(v), structuralMask16(v))));
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return findDelimiterScalar(p, end);
+    }
+
+    const char* findStructuralSse2(const char* p, const char* end) {
+      for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(structuralMask16(v)));
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return findStructuralScalar(p, end);
+    }
+#endif // EDA_EDIF_SSE2
+
+#ifdef EDA_EDIF_AVX2
+    __attribute__((target("avx2"))) inline __m256i spaceMask32(__m256i v) {
+      return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i structuralMask32(__m256i v) {
+      return _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('(')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(')'))),
+        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+    }
+
+    __attribute__((target("avx2"))) const char* skipSpaceAvx2(const char* p, const char* end) {
+      for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(spaceMask32(v)));
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return skipSpaceSse2(p, end);
+    }
+
+    __attribute__((target("avx2"))) const char* findDelimiterAvx2(const char* p, const char* end) {
+      for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_or_si256(spaceMask32(v), structuralMask32(v))));
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return findDelimiterSse2(p, end);
+    }
+
+    __attribute__((target("avx2"))) const char* findStructuralAvx2(const char* p, const char* end) {
+      for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(structuralMask32(v)));
+        if (mask != 0) return p + firstBit(mask);
+      }
+      return findStructuralSse2(p, end);
+    }
+#endif // EDA_EDIF_AVX2
+
+    class ScanFunctions {
+    public:
+      const char* (*skip_space)(const char*, const char*);
+      const char* (*find_delimiter)(const char*, const char*);
+      const char* (*find_structural)(const char*, const char*);
+      const char* name;
+    };
+
+    ScanFunctions selectScanFunctions() {
+      ScanFunctions functions;
+      functions.skip_space = skipSpaceScalar;
+      functions.find_delimiter = findDelimiterScalar;
+      functions.find_structural = findStructuralScalar;
+      functions.name = "scalar";
+#ifdef EDA_EDIF_SSE2
+      functions.skip_space = skipSpaceSse2;
+      functions.find_delimiter = findDelimiterSse2;
+      functions.find_structural = findStructuralSse2;
+      functions.name = "SSE2";
+#endif
+#ifdef EDA_EDIF_AVX2
+      if (__builtin_cpu_supports("avx2")) {
+        functions.skip_space = skipSpaceAvx2;
+        functions.find_delimiter = findDelimiterAvx2;
+        functions.find_structural = findStructuralAvx2;
+        functions.name = "AVX2";
+      }
+#endif
+      return functions;
+    }
+
+    const ScanFunctions& scanFunctions() {
+      static const ScanFunctions functions = selectScanFunctions();
+      return functions;
+    }
+
+  }
+
+  const char* EdifTokenizer::findStructural(const char* p, const char* end) {
+    return scanFunctions().find_structural(p, end);
+  }
+
+  const char* EdifTokenizer::instructionSet() {
+    return scanFunctions().name;
+  }
+
+  EdifTokenizer::TokenKind EdifTokenizer::next() {
+    // most separators are a single blank, indentation is scanned in blocks
+    if (p_ < end_ && isSpace(*p_)) {
+      p_++;
+      if (p_ < end_ && isSpace(*p_)) {
+        p_ = scanFunctions().skip_space(p_, end_);
+      }
+    }
+    if (p_ >= end_) {
+      kind_ = TOKEN_END;
+      text_ = end_;
+      length_ = 0;
+      return kind_;
+    }
+    char c = *p_;
+    if (c == '(' || c == ')') {
+      kind_ = c == '(' ? TOKEN_OPEN : TOKEN_CLOSE;
+      text_ = p_++;
+      length_ = 1;
+    } else if (c == '"') {
+      // EDIF escapes quotes inside strings as %34%
+      text_ = p_ + 1;
+      const char* quote = static_cast<const char*>(memchr(text_, '"', static_cast<size_t>(end_ - text_)));
+      if (quote == NULL) quote = end_;
+      length_ = static_cast<size_t>(quote - text_);
+      p_ = quote < end_ ? quote + 1 : end_;
+      kind_ = TOKEN_STRING;
+    } else {
+      text_ = p_;
+      const char* q = p_ + 1;
+      const char* short_end = end_ - q > 16 ? q + 16 : end_;
+      while (q < short_end && !isDelimiter(*q)) q++;
+      if (q == short_end && q < end_) {
+        q = scanFunctions().find_delimiter(q, end_);
+      }
+      length_ = static_cast<size_t>(q - text_);
+      p_ = q;
+      kind_ = TOKEN_ATOM;
+    }
+    return kind_;
+  }
+
+  bool EdifTokenizer::is(const char* keyword) const {
+    if (kind_ != TOKEN_ATOM) {
+      return false;
+    }
+    size_t i = 0;
+    for (; i < length_ && keyword[i] != '\0'; i++) {
+      if (tolower(static_cast<unsigned char>(text_[i])) != tolower(static_cast<unsigned char>(keyword[i]))) {
+        return false;
+      }
+    }
+    return i == length_ && keyword[i] == '\0';
+  }
+
+  bool EdifTokenizer::skipForm() {
+    int depth = 1;
+    while (true) {
+      const char* q = findStructural(p_, end_);
+      if (q >= end_) {
+        p_ = end_;
+        kind_ = TOKEN_END;
+        return false;
+      }
+      if (*q == '"') {
+        const char* quote = static_cast<const char*>(memchr(q + 1, '"', static_cast<size_t>(end_ - q - 1)));
+        p_ = quote == NULL ? end_ : quote + 1;
+        continue;
+      }
+      p_ = q + 1;
+      if (*q == '(') {
+        depth++;
+      } else if (--depth == 0) {
+        kind_ = TOKEN_CLOSE;
+        text_ = q;
+        length_ = 1;
+        return true;
+      }
+    }
+  }
+
+}
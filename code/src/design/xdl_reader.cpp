@@ -0,0 +1,319 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <ctype.h>
+
+#include "design/xdl_reader.h"
+#include "gui/command_context.h"
+#include "utility/file.h"
+#include "utility/log.h"
+
+namespace eda {
+
+  const size_t XdlReader::kChunkSize;
+
+  XdlReader::XdlReader(Design* design) {
+    design_ = design;
+    line_ = 1;
+    token_line_ = 1;
+    in_module_ = false;
+    num_modules_ = 0;
+  }
+
+  bool XdlReader::read(const std::string& file_name) {
+    file_name_ = file_name;
+    long long file_size = File::size(file_name.c_str());
+    FILE* fp = fopen(file_name.c_str(), "rb");
+    if (fp == NULL || file_size < 0) {
+      if (fp != NULL) fclose(fp);
+      eda_error("Cannot open XDL file '%s'.\n", file_name.c_str());
+      return false;
+    }
+    scan_ = ScanState();
+    line_ = 1;
+    in_module_ = false;
+    num_modules_ = 0;
+    CommandContext::startProgressIndicator(0, 100);
+
+    std::vector<char> buffer(kChunkSize);
+    size_t filled = 0;
+    long long bytes_read = 0;
+    int percent = 0;
+    bool ok = true;
+    while (ok) {
+      if (CommandContext::threadStopped()) {
+        eda_warning("Reading '%s' is cancelled.\n", file_name.c_str());
+        ok = false;
+        break;
+      }
+      // a single statement larger than the buffer, e.g. a huge routed net
+      if (filled == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+      }
+      size_t count = fread(&buffer[filled], 1, buffer.size() - filled, fp);
+      filled += count;
+      bytes_read += static_cast<long long>(count);
+
+      size_t start = 0;
+      size_t length = 0;
+      while (ok && findStatementEnd(&buffer[start], &buffer[0] + filled, length)) {
+        tokenize(&buffer[start], &buffer[start] + length);
+        ok = parseStatement();
+        line_ += scan_.lines;
+        scan_.lines = 0;
+        start += length + 1;
+      }
+      // keep the incomplete statement for the next chunk
+      filled -= start;
+      memmove(&buffer[0], &buffer[start], filled);
+      if (buffer.size() > kChunkSize && filled < kChunkSize) {
+        std::vector<char> chunk(buffer.begin(), buffer.begin() + filled);
+        chunk.resize(kChunkSize);
+        buffer.swap(chunk);
+      }
+
+      if (file_size > 0) {
+        int new_percent = static_cast<int>(bytes_read * 100 / file_size);
+        if (new_percent != percent) {
+          percent = new_percent;
+          CommandContext::setProgress(percent);
+        }
+      }
+      if (count == 0) {
+        if (ferror(fp)) {
+          eda_error("Failed to read '%s'.\n", file_name.c_str());
+          ok = false;
+        }
+        break;
+      }
+    }
+    fclose(fp);
+
+    if (ok && filled > 0) {
+      tokenize(&buffer[0], &buffer[0] + filled);
+      if (!tokens_.empty()) {
+        ok = syntaxError("unexpected end of file, ';' expected");
+      }
+    }
+    if (!ok) {
+      return false;
+    }
+    uint32_t num_unresolved = design_->resolvePins();
+    if (num_unresolved > 0) {
+      eda_warning("%s: %u pins refer to unknown instances.\n", file_name.c_str(), num_unresolved);
+    }
+    if (num_modules_ > 0) {
+      eda_warning("%s: %d module definitions are skipped.\n", file_name.c_str(), num_modules_);
+    }
+    return true;
+  }
+
+  bool XdlReader::findStatementEnd(const char* begin, const char* end, size_t& length) {
+    const char* p = begin + scan_.offset;
+    for (; p < end; p++) {
+      char c = *p;
+      if (c == '\n') {
+        scan_.lines++;
+        scan_.in_comment = false;
+        continue;
+      }
+      if (scan_.in_comment) {
+        continue;
+      }
+      if (scan_.in_quote) {
+        if (scan_.escaped) {
+          scan_.escaped = false;
+        } else if (c == '\\') {
+          scan_.escaped = true;
+        } else if (c == '"') {
+          scan_.in_quote = false;
+        }
+        continue;
+      }
+      if (c == '"') {
+        scan_.in_quote = true;
+      } else if (c == '#') {
+        scan_.in_comment = true;
+      } else if (c == ';') {
+        length = static_cast<size_t>(p - begin);
+        scan_.offset = 0;
+        return true;
+      }
+    }
+    scan_.offset = static_cast<size_t>(p - begin);
+    return false;
+  }
+
+  void XdlReader::tokenize(const char* begin, const char* end) {
+    tokens_.clear();
+    token_line_ = line_;
+    const char* p = begin;
+    while (p < end) {
+      char c = *p;
+      if (isspace(static_cast<unsigned char>(c))) {
+        if (c == '\n' && tokens_.empty()) token_line_++;
+        p++;
+        continue;
+      }
+      if (c == '#') {
+        while (p < end && *p != '\n') p++;
+        continue;
+      }
+      Token token;
+      if (c == ',') {
+        token.text = p++;
+        token.length = 1;
+        token.kind = TOKEN_COMMA;
+      } else if (c == '"') {
+        token.text = ++p;
+        bool escaped = false;
+        for (; p < end; p++) {
+          if (escaped) {
+            escaped = false;
+          } else if (*p == '\\') {
+            escaped = true;
+          } else if (*p == '"') {
+            break;
+          }
+        }
+        token.length = static_cast<size_t>(p - token.text);
+        token.kind = TOKEN_QUOTED;
+        if (p < end) p++;
+      } else {
+        token.text = p;
+        while (p < end && !isspace(static_cast<unsigned char>(*p)) && *p != ',' && *p != '"') p++;
+        token.length = static_cast<size_t>(p - token.text);
+        token.kind = TOKEN_WORD;
+      }
+      tokens_.push_back(token);
+    }
+  }
+
+  bool XdlReader::syntaxError(const char* message) {
+    eda_error("%s:%d: %s.\n", file_name_.c_str(), token_line_, message);
+    return false;
+  }
+
+  bool XdlReader::parseStatement() {
+    if (tokens_.empty()) {
+      return true;
+    }
+    const Token& keyword = tokens_[0];
+    if (in_module_) {
+      if (keyword.is("endmodule")) {
+        in_module_ = false;
+      }
+      return true;
+    }
+    if (keyword.is("inst")) {
+      return parseInstance();
+    }
+    if (keyword.is("net")) {
+      return parseNet();
+    }
+    if (keyword.is("design")) {
+      return parseDesign();
+    }
+    if (keyword.is("module")) {
+      in_module_ = true;
+      num_modules_++;
+      return true;
+    }
+    eda_warning("%s:%d: unknown statement '%.*s' is ignored.\n", file_name_.c_str(), token_line_,
+      static_cast<int>(keyword.length), keyword.text);
+    return true;
+  }
+
+  // design "<name>" <part> [<ncd version>] [, cfg "<config>"] ;
+  bool XdlReader::parseDesign() {
+    if (tokens_.size() < 3 || tokens_[1].kind != TOKEN_QUOTED) {
+      return syntaxError("design name and part expected");
+    }
+    design_->set_name(intern(tokens_[1]));
+    design_->set_part(intern(tokens_[2]));
+    for (size_t i = 3; i + 1 < tokens_.size(); i++) {
+      if (tokens_[i].is("cfg") && tokens_[i + 1].kind == TOKEN_QUOTED) {
+        design_->set_config(add(tokens_[i + 1]));
+      }
+    }
+    return true;
+  }
+
+  // inst "<name>" "<type>" , placed <tile> <site> | unplaced [bonded] ,
+  //   [module "<instance>" "<module>" "<instance>" ,] cfg "<config>" ;
+  bool XdlReader::parseInstance() {
+    if (tokens_.size() < 3 || tokens_[1].kind != TOKEN_QUOTED || tokens_[2].kind != TOKEN_QUOTED) {
+      return syntaxError("instance name and type expected");
+    }
+    Design::Instance instance;
+    instance.name = intern(tokens_[1]);
+    instance.type = intern(tokens_[2]);
+    instance.tile = StringPool::kInvalidId;
+    instance.site = StringPool::kInvalidId;
+    instance.config = StringPool::kInvalidId;
+    for (size_t i = 3; i < tokens_.size(); i++) {
+      if (tokens_[i].is("placed")) {
+        if (i + 2 >= tokens_.size()) {
+          return syntaxError("tile and site expected after 'placed'");
+        }
+        instance.tile = intern(tokens_[i + 1]);
+        instance.site = intern(tokens_[i + 2]);
+        i += 2;
+      } else if (tokens_[i].is("cfg") && i + 1 < tokens_.size() && tokens_[i + 1].kind == TOKEN_QUOTED) {
+        instance.config = add(tokens_[i + 1]);
+        i++;
+      }
+    }
+    design_->addInstance(instance);
+    return true;
+  }
+
+  // net "<name>" [wire|power|vcc|ground|gnd] ,
+  //   { outpin "<instance>" <pin> | inpin "<instance>" <pin> |
+  //     pip <tile> <wire> <direction> <wire> | cfg "<config>" } , ... ;
+  bool XdlReader::parseNet() {
+    if (tokens_.size() < 2 || tokens_[1].kind != TOKEN_QUOTED) {
+      return syntaxError("net name expected");
+    }
+    Design::NetType type = Design::NET_WIRE;
+    if (tokens_.size() > 2) {
+      if (tokens_[2].is("power") || tokens_[2].is("vcc")) {
+        type = Design::NET_POWER;
+      } else if (tokens_[2].is("ground") || tokens_[2].is("gnd")) {
+        type = Design::NET_GROUND;
+      }
+    }
+    design_->addNet(intern(tokens_[1]), type);
+    for (size_t i = 2; i < tokens_.size(); i++) {
+      const Token& token = tokens_[i];
+      if (token.is("outpin") || token.is("inpin")) {
+        if (i + 2 >= tokens_.size() || tokens_[i + 1].kind != TOKEN_QUOTED) {
+          return syntaxError("instance and pin expected");
+        }
+        design_->addPin(intern(tokens_[i + 1]), intern(tokens_[i + 2]),
+          token.is("outpin") ? Design::PIN_OUTPUT : Design::PIN_INPUT);
+        i += 2;
+      } else if (token.is("pip")) {
+        if (i + 4 >= tokens_.size()) {
+          return syntaxError("tile, wires and direction expected after 'pip'");
+        }
+        Design::Pip pip;
+        pip.tile = intern(tokens_[i + 1]);
+        pip.from = intern(tokens_[i + 2]);
+        pip.direction = intern(tokens_[i + 3]);
+        pip.to = intern(tokens_[i + 4]);
+        design_->addPip(pip);
+        i += 4;
+      } else if (token.is("cfg") && i + 1 < tokens_.size() && tokens_[i + 1].kind == TOKEN_QUOTED) {
+        design_->setNetConfig(add(tokens_[i + 1]));
+        i++;
+      }
+    }
+    return true;
+  }
+
+}
@@ -13,6 +13,13 @@ win32 {
 }
 
 HEADERS += $$top_srcdir/include/device/device_manager.h \
+           $$top_srcdir/include/device/device_db.h \
+           $$top_srcdir/include/device/device_fabric.h \
+           $$top_srcdir/include/device/routing_graph.h \
 
 SOURCES += device_manager.cpp \
+           device_db.cpp \
+           device_fabric.cpp \
+           routing_graph.cpp \
+           device_commands.cpp \
            
\ No newline at end of file
@@ -0,0 +1,262 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdlib.h>
+#include <fstream>
+
+#include "tcl/commands.h"
+#include "device/device_db.h"
+#include "device/device_fabric.h"
+#include "device/routing_graph.h"
+#include "device/device_manager.h"
+#include "utility/log.h"
+#include "utility/memory_tracker.h"
+#include "utility/utility.h"
+
+namespace eda {
+
+  // build_device_db -input <string> [-output <string>]
+  // Each non-empty line of the input describes one device:
+  //   <family> <device> <package,package,...> <speed,speed,...>
+  // a single '-' stands for an empty list, '#' starts a comment.
+  int BuildDeviceDB(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    std::string input;
+    std::string output;
+    Commands::getStringOption(objc, objv, "-input", input);
+    if (!Commands::getStringOption(objc, objv, "-output", output)) {
+      output = DeviceManager::databaseFile();
+    }
+
+    std::ifstream in(input.c_str());
+    if (!in.good()) {
+      eda_error("Cannot open device list '%s'.\n", input.c_str());
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    DeviceDatabaseWriter writer;
+    std::string line;
+    int line_no = 0;
+    int num_devices = 0;
+    while (std::getline(in, line)) {
+      line_no++;
+      size_t comment = line.find('#');
+      if (comment != std::string::npos) {
+        line.erase(comment);
+      }
+      std::vector<std::string> fields = splitStringWithDelim(line, ' ');
+      if (fields.empty()) {
+        continue;
+      }
+      if (fields.size() != 4) {
+        eda_warning("%s:%d: 4 fields are expected, line ignored.\n", input.c_str(), line_no);
+        continue;
+      }
+      std::vector<std::string> packages;
+      std::vector<std::string> speeds;
+      if (fields[2] != "-") {
+        packages = splitStringWithDelim(fields[2], ',');
+      }
+      if (fields[3] != "-") {
+        speeds = splitStringWithDelim(fields[3], ',');
+      }
+      writer.addDevice(fields[0], fields[1], packages, speeds);
+      num_devices++;
+    }
+
+    bool ok = writer.write(output);
+    if (ok) {
+      eda_info("%d devices written to '%s'.\n", num_devices, output.c_str());
+      if (output == DeviceManager::databaseFile()) {
+        DeviceManager::load();
+      }
+    }
+    gCommands.postRun(objc, objv);
+    return ok ? TCL_OK : TCL_ERROR;
+  }
+
+  // set_device_cache -size <int>
+  // Limits the memory used by the resident device families, in KB.
+  int SetDeviceCache(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    DeviceManager* manager = DeviceManager::manager();
+    int size_kb = 0;
+    if (Commands::getIntOption(objc, objv, "-size", size_kb)) {
+      if (size_kb < 0) {
+        eda_error("The device cache size must not be negative.\n");
+        gCommands.postRun(objc, objv);
+        return TCL_ERROR;
+      }
+      manager->set_memory_budget(static_cast<size_t>(size_kb) * 1024);
+    }
+    eda_info("Device cache: %d of %d families resident, %dKB used, %dKB budget.\n",
+      static_cast<int>(manager->numResidentFamilies()), static_cast<int>(manager->numFamilies()),
+      static_cast<int>(manager->resident_bytes() / 1024), static_cast<int>(manager->memory_budget() / 1024));
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // build_device_fabric -input <string> -output <string> [-routing <string>]
+  // The input describes the templates and the tile grid, '#' starts a comment:
+  //   site_type <name> <bel> <bel> ...
+  //   tile_type <name> <site_type> <site_type> ...
+  //   grid <rows> <cols>
+  //   row <row> <tile_type> <tile_type>*<count> ...
+  // Rows that are not listed are left empty. The routing templates are given
+  // per tile type and written next to the fabric (.rrg) unless -routing is set:
+  //   wires <tile_type> <wire> <wire> ...
+  //   pip <tile_type> <from_wire> <to_wire>
+  //   connect <tile_type> <from_wire> <drow> <dcol> <to_tile_type> <to_wire>
+  int BuildDeviceFabric(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    std::string input;
+    std::string output;
+    Commands::getStringOption(objc, objv, "-input", input);
+    Commands::getStringOption(objc, objv, "-output", output);
+    std::string routing;
+    if (!Commands::getStringOption(objc, objv, "-routing", routing)) {
+      routing = output;
+      if (routing.size() > 4 && routing.compare(routing.size() - 4, 4, ".fab") == 0) {
+        routing.erase(routing.size() - 4);
+      }
+      routing += ".rrg";
+    }
+
+    std::ifstream in(input.c_str());
+    if (!in.good()) {
+      eda_error("Cannot open fabric description '%s'.\n", input.c_str());
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    DeviceFabric fabric;
+    RoutingGraph routing_graph;
+    bool has_routing = false;
+    bool has_grid = false;
+    bool ok = true;
+    std::string line;
+    int line_no = 0;
+    while (ok && std::getline(in, line)) {
+      line_no++;
+      size_t comment = line.find('#');
+      if (comment != std::string::npos) {
+        line.erase(comment);
+      }
+      std::vector<std::string> fields = splitStringWithDelim(line, ' ');
+      if (fields.empty()) {
+        continue;
+      }
+      if (fields[0] == "site_type" && fields.size() >= 2) {
+        std::vector<std::string> bels(fields.begin() + 2, fields.end());
+        fabric.addSiteType(fields[1], bels);
+      } else if (fields[0] == "tile_type" && fields.size() >= 2) {
+        std::vector<DeviceFabric::TypeId> site_types;
+        for (size_t i = 2; ok && i < fields.size(); i++) {
+          DeviceFabric::TypeId type = fabric.findSiteType(fields[i]);
+          if (type >= fabric.numSiteTypes()) {
+            eda_error("%s:%d: unknown site type '%s'.\n", input.c_str(), line_no, fields[i].c_str());
+            ok = false;
+          }
+          site_types.push_back(type);
+        }
+        fabric.addTileType(fields[1], site_types);
+      } else if (fields[0] == "grid" && fields.size() == 3 && !has_grid) {
+        int rows = atoi(fields[1].c_str());
+        int cols = atoi(fields[2].c_str());
+        if (rows <= 0 || cols <= 0) {
+          eda_error("%s:%d: invalid grid size.\n", input.c_str(), line_no);
+          ok = false;
+        } else {
+          fabric.resize(rows, cols);
+          has_grid = true;
+        }
+      } else if (fields[0] == "row" && fields.size() >= 2 && has_grid) {
+        int row = atoi(fields[1].c_str());
+        int col = 0;
+        if (row < 0 || row >= fabric.rows()) {
+          eda_error("%s:%d: row %d is outside of the grid.\n", input.c_str(), line_no, row);
+          ok = false;
+        }
+        for (size_t i = 2; ok && i < fields.size(); i++) {
+          std::string name = fields[i];
+          int count = 1;
+          size_t star = name.find('*');
+          if (star != std::string::npos) {
+            count = atoi(name.c_str() + star + 1);
+            name.erase(star);
+          }
+          DeviceFabric::TypeId type = fabric.findTileType(name);
+          if (type >= fabric.numTileTypes() || count <= 0 || col + count > fabric.cols()) {
+            eda_error("%s:%d: invalid tile '%s'.\n", input.c_str(), line_no, fields[i].c_str());
+            ok = false;
+            break;
+          }
+          for (int c = 0; c < count; c++) {
+            fabric.setTileType(row, col++, type);
+          }
+        }
+      } else if (fields[0] == "wires" && fields.size() >= 2) {
+        DeviceFabric::TypeId tile_type = fabric.findTileType(fields[1]);
+        if (tile_type >= fabric.numTileTypes()) {
+          eda_error("%s:%d: unknown tile type '%s'.\n", input.c_str(), line_no, fields[1].c_str());
+          ok = false;
+        } else {
+          routing_graph.setTileTypeWires(tile_type, std::vector<std::string>(fields.begin() + 2, fields.end()));
+          has_routing = true;
+        }
+      } else if ((fields[0] == "pip" && fields.size() == 4) || (fields[0] == "connect" && fields.size() == 7)) {
+        bool is_pip = fields[0] == "pip";
+        DeviceFabric::TypeId tile_type = fabric.findTileType(fields[1]);
+        DeviceFabric::TypeId to_type = is_pip ? tile_type : fabric.findTileType(fields[5]);
+        uint32_t from = routing_graph.findWire(tile_type, fields[2]);
+        uint32_t to = routing_graph.findWire(to_type, fields[is_pip ? 3 : 6]);
+        if (from == DeviceFabric::kInvalidId || to == DeviceFabric::kInvalidId) {
+          eda_error("%s:%d: unknown tile type or wire.\n", input.c_str(), line_no);
+          ok = false;
+        } else if (is_pip) {
+          routing_graph.addPip(tile_type, from, to);
+        } else {
+          routing_graph.addTemplateEdge(tile_type, from, atoi(fields[3].c_str()), atoi(fields[4].c_str()), to_type, to);
+        }
+      } else {
+        eda_error("%s:%d: unexpected '%s'.\n", input.c_str(), line_no, fields[0].c_str());
+        ok = false;
+      }
+    }
+    if (ok && !has_grid) {
+      eda_error("No grid in '%s'.\n", input.c_str());
+      ok = false;
+    }
+    if (ok) {
+      fabric.finalize();
+      ok = fabric.save(output);
+    }
+    if (ok) {
+      eda_info("%d tiles, %d sites and %d BELs written to '%s'.\n", static_cast<int>(fabric.numTiles()),
+        static_cast<int>(fabric.numSites()), static_cast<int>(fabric.numBels()), output.c_str());
+    }
+    if (ok && has_routing) {
+      ok = routing_graph.saveTemplates(routing);
+      if (ok) {
+        routing_graph.build(fabric);
+        eda_info("Routing graph with %u nodes and %llu edges, templates written to '%s'.\n", routing_graph.numNodes(),
+          static_cast<unsigned long long>(routing_graph.numEdges()), routing.c_str());
+      }
+    }
+    gCommands.postRun(objc, objv);
+    return ok ? TCL_OK : TCL_ERROR;
+  }
+
+}
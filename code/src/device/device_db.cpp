@@ -0,0 +1,219 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#include <stdio.h>
+
+#include "device/device_db.h"
+#include "utility/log.h"
+
+namespace eda {
+
+  const char DeviceDatabase::kMagic[8] = { 'E', 'D', 'A', 'D', 'E', 'V', 'D', 'B' };
+
+  DeviceDatabase::DeviceDatabase() {
+    header_ = NULL;
+    families_ = NULL;
+    devices_ = NULL;
+    refs_ = NULL;
+    strings_ = NULL;
+  }
+
+  bool DeviceDatabase::open(const std::string& file_name) {
+    close();
+    if (!file_.open(file_name)) {
+      return false;
+    }
+    const char* base = file_.data();
+    size_t size = file_.size();
+    if (size < sizeof(DeviceDBHeader)) {
+      eda_error("Device database '%s' is truncated.\n", file_name.c_str());
+      file_.close();
+      return false;
+    }
+    const DeviceDBHeader* header = reinterpret_cast<const DeviceDBHeader*>(base);
+    if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+      eda_error("'%s' is not a device database.\n", file_name.c_str());
+      file_.close();
+      return false;
+    }
+    if (header->version != kVersion) {
+      eda_error("Device database '%s' has version %u, version %u is expected.\n", file_name.c_str(), header->version, kVersion);
+      file_.close();
+      return false;
+    }
+    // every table must lie inside the file and be 4-byte aligned
+    uint64_t families_end = uint64_t(header->families_offset) + uint64_t(header->num_families) * sizeof(DeviceDBFamilyRecord);
+    uint64_t devices_end = uint64_t(header->devices_offset) + uint64_t(header->num_devices) * sizeof(DeviceDBDeviceRecord);
+    uint64_t refs_end = uint64_t(header->refs_offset) + uint64_t(header->num_refs) * sizeof(uint32_t);
+    uint64_t strings_end = uint64_t(header->strings_offset) + uint64_t(header->strings_size);
+    if (families_end > size || devices_end > size || refs_end > size || strings_end > size ||
+      header->strings_size == 0 ||
+      (header->families_offset | header->devices_offset | header->refs_offset) % 4 != 0) {
+      eda_error("Device database '%s' is corrupted.\n", file_name.c_str());
+      file_.close();
+      return false;
+    }
+    header_ = header;
+    families_ = reinterpret_cast<const DeviceDBFamilyRecord*>(base + header->families_offset);
+    devices_ = reinterpret_cast<const DeviceDBDeviceRecord*>(base + header->devices_offset);
+    refs_ = reinterpret_cast<const uint32_t*>(base + header->refs_offset);
+    strings_ = base + header->strings_offset;
+    if (!validate()) {
+      eda_error("Device database '%s' is corrupted.\n", file_name.c_str());
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void DeviceDatabase::close() {
+    file_.close();
+    header_ = NULL;
+    families_ = NULL;
+    devices_ = NULL;
+    refs_ = NULL;
+    strings_ = NULL;
+  }
+
+  bool DeviceDatabase::validate() const {
+    const uint32_t strings_size = header_->strings_size;
+    if (strings_[strings_size - 1] != '\0') {
+      return false;
+    }
+    for (uint32_t f = 0; f < header_->num_families; f++) {
+      const DeviceDBFamilyRecord& family = families_[f];
+      if (family.name >= strings_size ||
+        uint64_t(family.device_begin) + family.device_count > header_->num_devices) {
+        return false;
+      }
+    }
+    for (uint32_t d = 0; d < header_->num_devices; d++) {
+      const DeviceDBDeviceRecord& device = devices_[d];
+      if (device.name >= strings_size || device.family >= header_->num_families ||
+        uint64_t(device.package_begin) + device.package_count > header_->num_refs ||
+        uint64_t(device.speed_begin) + device.speed_count > header_->num_refs) {
+        return false;
+      }
+    }
+    for (uint32_t r = 0; r < header_->num_refs; r++) {
+      if (refs_[r] >= strings_size) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void DeviceDatabaseWriter::addDevice(const std::string& family, const std::string& name,
+    const std::vector<std::string>& packages, const std::vector<std::string>& speeds) {
+    auto iter = family_index_map_.find(family);
+    size_t index = families_.size();
+    if (iter == family_index_map_.end()) {
+      family_index_map_.insert(std::make_pair(family, families_.size()));
+      families_.push_back(family);
+      devices_.push_back(std::vector<Device>());
+    } else {
+      index = iter->second;
+    }
+    Device device;
+    device.name = name;
+    device.packages = packages;
+    device.speeds = speeds;
+    devices_[index].push_back(device);
+  }
+
+  uint32_t DeviceDatabaseWriter::intern(const std::string& s) {
+    auto iter = string_offsets_.find(s);
+    if (iter != string_offsets_.end()) {
+      return iter->second;
+    }
+    uint32_t offset = static_cast<uint32_t>(strings_.size());
+    strings_.append(s);
+    strings_.push_back('\0');
+    string_offsets_.insert(std::make_pair(s, offset));
+    return offset;
+  }
+
+  bool DeviceDatabaseWriter::write(const std::string& file_name) {
+    strings_.clear();
+    string_offsets_.clear();
+    intern("");
+
+    std::vector<DeviceDBFamilyRecord> family_records;
+    std::vector<DeviceDBDeviceRecord> device_records;
+    std::vector<uint32_t> refs;
+    for (size_t f = 0; f < families_.size(); f++) {
+      DeviceDBFamilyRecord family;
+      family.name = intern(families_[f]);
+      family.device_begin = static_cast<uint32_t>(device_records.size());
+      family.device_count = static_cast<uint32_t>(devices_[f].size());
+      family_records.push_back(family);
+      for (size_t d = 0; d < devices_[f].size(); d++) {
+        const Device& def = devices_[f][d];
+        DeviceDBDeviceRecord device;
+        device.name = intern(def.name);
+        device.family = static_cast<uint32_t>(f);
+        device.package_begin = static_cast<uint32_t>(refs.size());
+        device.package_count = static_cast<uint32_t>(def.packages.size());
+        for (size_t p = 0; p < def.packages.size(); p++) {
+          refs.push_back(intern(def.packages[p]));
+        }
+        device.speed_begin = static_cast<uint32_t>(refs.size());
+        device.speed_count = static_cast<uint32_t>(def.speeds.size());
+        for (size_t s = 0; s < def.speeds.size(); s++) {
+          refs.push_back(intern(def.speeds[s]));
+        }
+        device_records.push_back(device);
+      }
+    }
+
+    // the offsets of the file are 32 bits, checked before they are narrowed
+    uint64_t families_offset = sizeof(DeviceDBHeader);
+    uint64_t devices_offset = families_offset + uint64_t(family_records.size()) * sizeof(DeviceDBFamilyRecord);
+    uint64_t refs_offset = devices_offset + uint64_t(device_records.size()) * sizeof(DeviceDBDeviceRecord);
+    uint64_t strings_offset = refs_offset + uint64_t(refs.size()) * sizeof(uint32_t);
+    if (strings_offset + uint64_t(strings_.size()) > UINT32_MAX) {
+      eda_error("The device database '%s' would exceed 4 GB.\n", file_name.c_str());
+      return false;
+    }
+
+    DeviceDBHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DeviceDatabase::kMagic, sizeof(header.magic));
+    header.version = DeviceDatabase::kVersion;
+    header.num_families = static_cast<uint32_t>(family_records.size());
+    header.num_devices = static_cast<uint32_t>(device_records.size());
+    header.num_refs = static_cast<uint32_t>(refs.size());
+    header.families_offset = static_cast<uint32_t>(families_offset);
+    header.devices_offset = static_cast<uint32_t>(devices_offset);
+    header.refs_offset = static_cast<uint32_t>(refs_offset);
+    header.strings_offset = static_cast<uint32_t>(strings_offset);
+    header.strings_size = static_cast<uint32_t>(strings_.size());
+
+    FILE* fp = fopen(file_name.c_str(), "wb");
+    if (fp == NULL) {
+      eda_error("Cannot open '%s' for writing.\n", file_name.c_str());
+      return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    if (ok && !family_records.empty())
+      ok = fwrite(&family_records[0], sizeof(DeviceDBFamilyRecord), family_records.size(), fp) == family_records.size();
+    if (ok && !device_records.empty())
+      ok = fwrite(&device_records[0], sizeof(DeviceDBDeviceRecord), device_records.size(), fp) == device_records.size();
+    if (ok && !refs.empty())
+      ok = fwrite(&refs[0], sizeof(uint32_t), refs.size(), fp) == refs.size();
+    if (ok)
+      ok = fwrite(strings_.data(), 1, strings_.size(), fp) == strings_.size();
+    if (fclose(fp) != 0)
+      ok = false;
+    if (!ok) {
+      eda_error("Failed to write device database '%s'.\n", file_name.c_str());
+    }
+    return ok;
+  }
+
+}
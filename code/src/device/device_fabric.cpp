@@ -0,0 +1,287 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "device/device_fabric.h"
+#include "utility/binary_io.h"
+#include "utility/log.h"
+
+namespace eda {
+
+  namespace {
+
+    const char kFabricMagic[8] = { 'E', 'D', 'A', 'F', 'A', 'B', 'R', 'C' };
+    const uint32_t kFabricVersion = 1;
+
+  }
+
+  const uint32_t DeviceFabric::kInvalidId;
+  const DeviceFabric::TypeId DeviceFabric::kEmptyTileType;
+
+  uint32_t DeviceFabric::NameTable::add(const std::string& name) {
+    offsets_.push_back(static_cast<uint32_t>(chars_.size()));
+    chars_.append(name);
+    chars_.push_back('\0');
+    return static_cast<uint32_t>(offsets_.size() - 1);
+  }
+
+  bool DeviceFabric::NameTable::valid() const {
+    // the last name ends the buffer, so every name that starts in it is
+    // terminated
+    if (offsets_.empty())
+      return chars_.empty();
+    if (chars_.empty() || chars_[chars_.size() - 1] != '\0')
+      return false;
+    for (size_t i = 0; i < offsets_.size(); i++) {
+      if (offsets_[i] >= chars_.size())
+        return false;
+    }
+    return true;
+  }
+
+  uint32_t DeviceFabric::NameTable::find(const std::string& name) const {
+    for (uint32_t i = 0; i < size(); i++) {
+      if (name == this->name(i)) {
+        return i;
+      }
+    }
+    return kInvalidId;
+  }
+
+  DeviceFabric::DeviceFabric() {
+    rows_ = 0;
+    cols_ = 0;
+    site_type_bel_begin_.push_back(0);
+    tile_type_site_begin_.push_back(0);
+    tile_type_names_.add("NULL");
+    tile_type_site_begin_.push_back(0);
+  }
+
+  DeviceFabric::TypeId DeviceFabric::addSiteType(const std::string& name, const std::vector<std::string>& bels) {
+    for (size_t b = 0; b < bels.size(); b++) {
+      bel_names_.add(bels[b]);
+    }
+    site_type_bel_begin_.push_back(bel_names_.size());
+    return static_cast<TypeId>(site_type_names_.add(name));
+  }
+
+  DeviceFabric::TypeId DeviceFabric::addTileType(const std::string& name, const std::vector<TypeId>& site_types) {
+    tile_type_sites_.insert(tile_type_sites_.end(), site_types.begin(), site_types.end());
+    tile_type_site_begin_.push_back(static_cast<uint32_t>(tile_type_sites_.size()));
+    return static_cast<TypeId>(tile_type_names_.add(name));
+  }
+
+  DeviceFabric::TypeId DeviceFabric::findSiteType(const std::string& name) const {
+    uint32_t type = site_type_names_.find(name);
+    return type == kInvalidId ? static_cast<TypeId>(0xffff) : static_cast<TypeId>(type);
+  }
+
+  DeviceFabric::TypeId DeviceFabric::findTileType(const std::string& name) const {
+    uint32_t type = tile_type_names_.find(name);
+    return type == kInvalidId ? static_cast<TypeId>(0xffff) : static_cast<TypeId>(type);
+  }
+
+  void DeviceFabric::resize(int rows, int cols) {
+    rows_ = rows;
+    cols_ = cols;
+    tile_types_.assign(static_cast<size_t>(rows) * static_cast<size_t>(cols), kEmptyTileType);
+    tile_site_begin_.clear();
+    site_tiles_.clear();
+    site_types_.clear();
+    site_x_.clear();
+    site_y_.clear();
+    site_bel_begin_.clear();
+  }
+
+  void DeviceFabric::finalize() {
+    const uint32_t num_tiles = numTiles();
+    tile_site_begin_.resize(num_tiles + 1);
+    uint32_t num_sites = 0;
+    for (TileId t = 0; t < num_tiles; t++) {
+      tile_site_begin_[t] = num_sites;
+      num_sites += numTileTypeSites(tile_types_[t]);
+    }
+    tile_site_begin_[num_tiles] = num_sites;
+
+    site_tiles_.resize(num_sites);
+    site_types_.resize(num_sites);
+    site_bel_begin_.resize(num_sites + 1);
+    uint32_t num_bels = 0;
+    for (TileId t = 0; t < num_tiles; t++) {
+      TypeId tile_type = tile_types_[t];
+      SiteId first = tile_site_begin_[t];
+      uint32_t count = numTileTypeSites(tile_type);
+      for (uint32_t i = 0; i < count; i++) {
+        TypeId site_type = tileTypeSite(tile_type, i);
+        site_tiles_[first + i] = t;
+        site_types_[first + i] = site_type;
+        site_bel_begin_[first + i] = num_bels;
+        num_bels += numSiteTypeBels(site_type);
+      }
+    }
+    site_bel_begin_[num_sites] = num_bels;
+    computeSiteCoordinates();
+  }
+
+  // Site coordinates follow the usual X/Y naming: X counts the columns that
+  // contain a site type (several per column if a tile holds more than one),
+  // Y counts the rows containing it from the bottom of the device.
+  void DeviceFabric::computeSiteCoordinates() {
+    const uint32_t num_types = numSiteTypes();
+    const uint32_t num_sites = numSites();
+    std::vector<uint16_t> col_mult(static_cast<size_t>(num_types) * cols_, 0);
+    std::vector<uint16_t> row_rank(static_cast<size_t>(num_types) * rows_, 0);
+    std::vector<uint16_t> index_in_tile(num_sites, 0);
+    std::vector<uint16_t> count(num_types, 0);
+
+    for (TileId t = 0; t < numTiles(); t++) {
+      SiteId begin = tile_site_begin_[t];
+      SiteId end = tile_site_begin_[t + 1];
+      if (begin == end) continue;
+      for (SiteId s = begin; s < end; s++) {
+        count[site_types_[s]] = 0;
+      }
+      for (SiteId s = begin; s < end; s++) {
+        index_in_tile[s] = count[site_types_[s]]++;
+      }
+      int col = tileCol(t);
+      int row = tileRow(t);
+      for (SiteId s = begin; s < end; s++) {
+        TypeId type = site_types_[s];
+        uint16_t& mult = col_mult[static_cast<size_t>(type) * cols_ + col];
+        if (mult < count[type]) mult = count[type];
+        row_rank[static_cast<size_t>(type) * rows_ + row] = 1;
+      }
+    }
+    // turn multiplicities and row flags into column offsets and row ranks
+    for (uint32_t type = 0; type < num_types; type++) {
+      uint16_t* mult = &col_mult[static_cast<size_t>(type) * cols_];
+      uint16_t offset = 0;
+      for (int c = 0; c < cols_; c++) {
+        uint16_t m = mult[c];
+        mult[c] = offset;
+        offset = static_cast<uint16_t>(offset + m);
+      }
+      uint16_t* rank = &row_rank[static_cast<size_t>(type) * rows_];
+      uint16_t y = 0;
+      for (int r = rows_ - 1; r >= 0; r--) {
+        uint16_t used = rank[r];
+        rank[r] = y;
+        y = static_cast<uint16_t>(y + used);
+      }
+    }
+    site_x_.resize(num_sites);
+    site_y_.resize(num_sites);
+    for (SiteId s = 0; s < num_sites; s++) {
+      TypeId type = site_types_[s];
+      TileId t = site_tiles_[s];
+      site_x_[s] = static_cast<uint16_t>(col_mult[static_cast<size_t>(type) * cols_ + tileCol(t)] + index_in_tile[s]);
+      site_y_[s] = row_rank[static_cast<size_t>(type) * rows_ + tileRow(t)];
+    }
+  }
+
+  std::string DeviceFabric::tileName(TileId tile) const {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "_X%dY%d", tileCol(tile), rows_ - 1 - tileRow(tile));
+    return std::string(tileTypeName(tile_types_[tile])) + buf;
+  }
+
+  std::string DeviceFabric::siteName(SiteId site) const {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "_X%dY%d", site_x_[site], site_y_[site]);
+    return std::string(siteTypeName(site_types_[site])) + buf;
+  }
+
+  size_t DeviceFabric::memoryUsage() const {
+    return tile_types_.capacity() * sizeof(TypeId) +
+      tile_site_begin_.capacity() * sizeof(uint32_t) +
+      site_tiles_.capacity() * sizeof(TileId) +
+      site_types_.capacity() * sizeof(TypeId) +
+      (site_x_.capacity() + site_y_.capacity()) * sizeof(uint16_t) +
+      site_bel_begin_.capacity() * sizeof(uint32_t);
+  }
+
+  // Only the templates and the grid are stored, the site and BEL arrays are
+  // rebuilt by finalize() after loading.
+  bool DeviceFabric::save(const std::string& file_name) const {
+    FILE* fp = fopen(file_name.c_str(), "wb");
+    if (fp == NULL) {
+      eda_error("Cannot open '%s' for writing.\n", file_name.c_str());
+      return false;
+    }
+    int32_t dims[2] = { rows_, cols_ };
+    bool ok = fwrite(kFabricMagic, sizeof(kFabricMagic), 1, fp) == 1 &&
+      fwrite(&kFabricVersion, sizeof(kFabricVersion), 1, fp) == 1 &&
+      fwrite(dims, sizeof(dims), 1, fp) == 1 &&
+      writeString(fp, site_type_names_.chars_) && writeVector(fp, site_type_names_.offsets_) &&
+      writeString(fp, bel_names_.chars_) && writeVector(fp, bel_names_.offsets_) &&
+      writeVector(fp, site_type_bel_begin_) &&
+      writeString(fp, tile_type_names_.chars_) && writeVector(fp, tile_type_names_.offsets_) &&
+      writeVector(fp, tile_type_sites_) && writeVector(fp, tile_type_site_begin_) &&
+      writeVector(fp, tile_types_);
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+      eda_error("Failed to write device fabric '%s'.\n", file_name.c_str());
+    }
+    return ok;
+  }
+
+  bool DeviceFabric::load(const std::string& file_name) {
+    FILE* fp = fopen(file_name.c_str(), "rb");
+    if (fp == NULL) {
+      return false;
+    }
+    char magic[8];
+    uint32_t version = 0;
+    int32_t dims[2] = { 0, 0 };
+    bool ok = fread(magic, sizeof(magic), 1, fp) == 1 && memcmp(magic, kFabricMagic, sizeof(magic)) == 0 &&
+      fread(&version, sizeof(version), 1, fp) == 1 && version == kFabricVersion &&
+      fread(dims, sizeof(dims), 1, fp) == 1 &&
+      readString(fp, site_type_names_.chars_) && readVector(fp, site_type_names_.offsets_) &&
+      readString(fp, bel_names_.chars_) && readVector(fp, bel_names_.offsets_) &&
+      readVector(fp, site_type_bel_begin_) &&
+      readString(fp, tile_type_names_.chars_) && readVector(fp, tile_type_names_.offsets_) &&
+      readVector(fp, tile_type_sites_) && readVector(fp, tile_type_site_begin_) &&
+      readVector(fp, tile_types_);
+    fclose(fp);
+
+    // reject anything that would index out of the tables
+    ok = ok && dims[0] >= 0 && dims[1] >= 0 &&
+      site_type_names_.valid() && bel_names_.valid() && tile_type_names_.valid() &&
+      tile_types_.size() == static_cast<size_t>(dims[0]) * static_cast<size_t>(dims[1]) &&
+      site_type_bel_begin_.size() == site_type_names_.offsets_.size() + 1 &&
+      tile_type_site_begin_.size() == tile_type_names_.offsets_.size() + 1 &&
+      site_type_bel_begin_.back() == bel_names_.offsets_.size() &&
+      tile_type_site_begin_.back() == tile_type_sites_.size();
+    // the ranges of the types must not overlap or underflow
+    for (size_t i = 1; ok && i < site_type_bel_begin_.size(); i++) {
+      ok = site_type_bel_begin_[i - 1] <= site_type_bel_begin_[i];
+    }
+    for (size_t i = 1; ok && i < tile_type_site_begin_.size(); i++) {
+      ok = tile_type_site_begin_[i - 1] <= tile_type_site_begin_[i];
+    }
+    for (size_t i = 0; ok && i < tile_types_.size(); i++) {
+      ok = tile_types_[i] < tile_type_names_.size();
+    }
+    for (size_t i = 0; ok && i < tile_type_sites_.size(); i++) {
+      ok = tile_type_sites_[i] < site_type_names_.size();
+    }
+    if (!ok) {
+      eda_error("Device fabric '%s' is corrupted.\n", file_name.c_str());
+      *this = DeviceFabric();
+      return false;
+    }
+    rows_ = dims[0];
+    cols_ = dims[1];
+    finalize();
+    return true;
+  }
+
+}
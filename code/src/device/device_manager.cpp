@@ -2,20 +2,57 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
-//* This is only a demo used for how to design the new project wizard pages
+//* Last updated: 2026-10-17
+//* The device catalogue is read from the binary database under the DB path.
+//* The two demo devices are only used when no database is installed.
 //******************************************************************************
 
 #include "device/device_manager.h"
+#include "utility/app.h"
+#include "utility/log.h"
+#include "utility/memory_tracker.h"
 
 namespace eda {
 
   DeviceManager* DeviceManager::manager_ = NULL;
 
+  std::string DeviceManager::databaseFile() {
+    return App::getDBPath() + "/device/device.db";
+  }
+
+  std::string DeviceManager::fabricFile(const std::string& family, const std::string& name) {
+    return App::getDBPath() + "/device/" + family + "/" + name + ".fab";
+  }
+
+  std::string DeviceManager::routingFile(const std::string& family, const std::string& name) {
+    return App::getDBPath() + "/device/" + family + "/" + name + ".rrg";
+  }
+
   void DeviceManager::load() {
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
     release();
     manager_ = new DeviceManager();
 
+    if (manager_->database_.open(databaseFile())) {
+      manager_->loadDatabase();
+    } else {
+      eda_warning("No device database found at '%s', only the demo devices are available.\n", databaseFile().c_str());
+      manager_->loadBuiltinDevices();
+    }
+  }
+
+  void DeviceManager::loadDatabase() {
+    // only the family index, devices are paged in by devices()
+    uint32_t num_families = database_.numFamilies();
+    families_.reserve(num_families);
+    family_data_.resize(num_families);
+    for (uint32_t f = 0; f < num_families; f++) {
+      families_.push_back(database_.familyName(f));
+      family_index_map_.insert(std::make_pair(families_.back(), static_cast<size_t>(f)));
+    }
+  }
+
+  void DeviceManager::loadBuiltinDevices() {
     DeviceDef device;
     device.family = "Kintex7";
     device.name = "325t";
@@ -23,7 +60,7 @@ namespace eda {
     device.speeds.push_back("-1");
     device.speeds.push_back("-2");
     device.speeds.push_back("-3");
-    manager_->addDevice(device);
+    addDevice(device);
 
     DeviceDef device_1;
     device_1.family = "Virtex7";
@@ -31,7 +68,167 @@ namespace eda {
     device_1.speeds.push_back("-1");
     device_1.speeds.push_back("-2");
     device_1.speeds.push_back("-3");
-    manager_->addDevice(device_1);
+    addDevice(device_1);
+  }
+
+  int DeviceManager::familyIndex(const std::string& family) const {
+    auto iter = family_index_map_.find(family);
+    if (iter == family_index_map_.end()) {
+      return -1;
+    }
+    return static_cast<int>(iter->second);
+  }
+
+  const std::vector<DeviceManager::DeviceDef>& DeviceManager::devices(size_t family_index) {
+    Family& family = family_data_[family_index];
+    if (!family.loaded) {
+      pageIn(family_index);
+      evict(family_index);
+    } else {
+      touch(family_index);
+    }
+    return family.devices;
+  }
+
+  const DeviceManager::DeviceDef* DeviceManager::device(const std::string& family, const std::string& name) {
+    int family_index = familyIndex(family);
+    if (family_index < 0) {
+      return NULL;
+    }
+    const std::vector<DeviceDef>& family_devices = devices(static_cast<size_t>(family_index));
+    for (size_t d = 0; d < family_devices.size(); d++) {
+      if (family_devices[d].name == name) {
+        return &family_devices[d];
+      }
+    }
+    return NULL;
+  }
+
+  const DeviceFabric* DeviceManager::fabric(const std::string& family, const std::string& name) {
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    std::string key = family + "/" + name;
+    if (key == fabric_key_) {
+      return &fabric_;
+    }
+    fabric_key_.clear();
+    fabric_ = DeviceFabric();
+    routing_graph_ = RoutingGraph();
+    routing_graph_built_ = false;
+    if (!fabric_.load(fabricFile(family, name))) {
+      return NULL;
+    }
+    fabric_key_ = key;
+    return &fabric_;
+  }
+
+  const RoutingGraph* DeviceManager::routingGraph(const std::string& family, const std::string& name) {
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    const DeviceFabric* device_fabric = fabric(family, name);
+    if (device_fabric == NULL) {
+      return NULL;
+    }
+    if (!routing_graph_built_) {
+      if (!routing_graph_.loadTemplates(routingFile(family, name))) {
+        return NULL;
+      }
+      routing_graph_.build(*device_fabric);
+      routing_graph_built_ = true;
+    }
+    return &routing_graph_;
+  }
+
+  void DeviceManager::addDevice(const DeviceDef& device) {
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    auto iter = family_index_map_.find(device.family);
+    size_t index = families_.size();
+    if (iter == family_index_map_.end()) {
+      family_index_map_.insert(std::make_pair(device.family, families_.size()));
+      families_.push_back(device.family);
+      family_data_.push_back(Family());
+      family_data_[index].loaded = true;
+      family_data_[index].pinned = true;
+      lru_.push_front(index);
+      family_data_[index].lru_pos = lru_.begin();
+    } else {
+      index = iter->second;
+      if (!family_data_[index].loaded) {
+        pageIn(index);
+      }
+      family_data_[index].pinned = true;
+    }
+    family_data_[index].devices.push_back(device);
+    size_t bytes = memoryUsage(device);
+    family_data_[index].bytes += bytes;
+    resident_bytes_ += bytes;
+  }
+
+  void DeviceManager::set_memory_budget(size_t bytes) {
+    memory_budget_ = bytes;
+    if (!lru_.empty()) {
+      evict(lru_.front());
+    }
+  }
+
+  void DeviceManager::pageIn(size_t family_index) {
+    MemoryTagScope scope(MemoryTracker::TAG_DEVICE);
+    Family& family = family_data_[family_index];
+    uint32_t f = static_cast<uint32_t>(family_index);
+    uint32_t begin = database_.familyDeviceBegin(f);
+    uint32_t count = database_.familyDeviceCount(f);
+    family.devices.resize(count);
+    family.bytes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t d = begin + i;
+      DeviceDef& device = family.devices[i];
+      device.family = families_[family_index];
+      device.name = database_.deviceName(d);
+      device.packages.reserve(database_.numPackages(d));
+      for (uint32_t p = 0; p < database_.numPackages(d); p++) {
+        device.packages.push_back(database_.packageName(d, p));
+      }
+      device.speeds.reserve(database_.numSpeeds(d));
+      for (uint32_t s = 0; s < database_.numSpeeds(d); s++) {
+        device.speeds.push_back(database_.speedName(d, s));
+      }
+      family.bytes += memoryUsage(device);
+    }
+    family.loaded = true;
+    resident_bytes_ += family.bytes;
+    lru_.push_front(family_index);
+    family.lru_pos = lru_.begin();
+  }
+
+  void DeviceManager::touch(size_t family_index) {
+    Family& family = family_data_[family_index];
+    lru_.splice(lru_.begin(), lru_, family.lru_pos);
+  }
+
+  void DeviceManager::evict(size_t keep_index) {
+    auto iter = lru_.end();
+    while (resident_bytes_ > memory_budget_ && iter != lru_.begin()) {
+      --iter;
+      size_t index = *iter;
+      Family& family = family_data_[index];
+      if (index == keep_index || family.pinned) {
+        continue;
+      }
+      resident_bytes_ -= family.bytes;
+      std::vector<DeviceDef>().swap(family.devices);
+      family.bytes = 0;
+      family.loaded = false;
+      iter = lru_.erase(iter);
+    }
+  }
+
+  size_t DeviceManager::memoryUsage(const DeviceDef& device) {
+    size_t bytes = sizeof(DeviceDef) + device.family.capacity() + device.name.capacity();
+    for (size_t p = 0; p < device.packages.size(); p++) {
+      bytes += sizeof(std::string) + device.packages[p].capacity();
+    }
+    for (size_t s = 0; s < device.speeds.size(); s++) {
+      bytes += sizeof(std::string) + device.speeds[s].capacity();
+    }
+    return bytes;
   }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,221 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+
+#include "device/routing_graph.h"
+#include "utility/binary_io.h"
+#include "utility/log.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  namespace {
+
+    const char kTemplateMagic[8] = { 'E', 'D', 'A', 'R', 'R', 'G', 'T', 'P' };
+    const uint32_t kTemplateVersion = 1;
+
+    bool edgeFromLess(const RoutingGraph::TemplateEdge& a, const RoutingGraph::TemplateEdge& b) {
+      return a.from < b.from;
+    }
+
+  }
+
+  const RoutingGraph::NodeId RoutingGraph::kInvalidNode;
+
+  void RoutingGraph::setTileTypeWires(TypeId tile_type, const std::vector<std::string>& wires) {
+    if (tile_type >= templates_.size()) {
+      templates_.resize(tile_type + 1);
+    }
+    TileTemplate& tile = templates_[tile_type];
+    tile.wires.clear();
+    for (size_t i = 0; i < wires.size(); i++) {
+      tile.wires.add(wires[i]);
+    }
+  }
+
+  uint32_t RoutingGraph::numTileTypeWires(TypeId tile_type) const {
+    return tile_type < templates_.size() ? templates_[tile_type].wires.size() : 0;
+  }
+
+  uint32_t RoutingGraph::findWire(TypeId tile_type, const std::string& name) const {
+    if (tile_type >= templates_.size()) {
+      return DeviceFabric::kInvalidId;
+    }
+    return templates_[tile_type].wires.find(name);
+  }
+
+  void RoutingGraph::addTemplateEdge(TypeId tile_type, uint32_t from, int drow, int dcol, TypeId to_type, uint32_t to) {
+    if (tile_type >= templates_.size()) {
+      templates_.resize(tile_type + 1);
+    }
+    TemplateEdge edge;
+    edge.from = from;
+    edge.to = to;
+    edge.drow = static_cast<int16_t>(drow);
+    edge.dcol = static_cast<int16_t>(dcol);
+    edge.to_type = to_type;
+    edge.reserved = 0;
+    templates_[tile_type].edges.push_back(edge);
+  }
+
+  void RoutingGraph::compileTemplates() {
+    for (size_t t = 0; t < templates_.size(); t++) {
+      TileTemplate& tile = templates_[t];
+      std::stable_sort(tile.edges.begin(), tile.edges.end(), edgeFromLess);
+      uint32_t num_wires = tile.wires.size();
+      tile.edge_begin.assign(num_wires + 1, 0);
+      // edges from unknown wires sort last and are left out
+      for (size_t e = 0; e < tile.edges.size(); e++) {
+        if (tile.edges[e].from < num_wires) tile.edge_begin[tile.edges[e].from + 1]++;
+      }
+      for (uint32_t w = 0; w < num_wires; w++) {
+        tile.edge_begin[w + 1] += tile.edge_begin[w];
+      }
+    }
+  }
+
+  bool RoutingGraph::resolveEdge(const DeviceFabric& fabric, int row, int col, const TemplateEdge& edge, NodeId& target) const {
+    int to_row = row + edge.drow;
+    int to_col = col + edge.dcol;
+    if (to_row < 0 || to_row >= fabric.rows() || to_col < 0 || to_col >= fabric.cols()) {
+      return false;
+    }
+    DeviceFabric::TileId to_tile = fabric.tileAt(to_row, to_col);
+    if (fabric.tileType(to_tile) != edge.to_type || edge.to >= numTileTypeWires(edge.to_type)) {
+      return false;
+    }
+    target = tile_node_begin_[to_tile] + edge.to;
+    return true;
+  }
+
+  void RoutingGraph::build(const DeviceFabric& fabric, int num_threads) {
+    if (templates_.size() < fabric.numTileTypes()) {
+      templates_.resize(fabric.numTileTypes());
+    }
+    compileTemplates();
+
+    const uint32_t num_tiles = fabric.numTiles();
+    tile_node_begin_.resize(num_tiles + 1);
+    NodeId num_nodes = 0;
+    for (DeviceFabric::TileId t = 0; t < num_tiles; t++) {
+      tile_node_begin_[t] = num_nodes;
+      num_nodes += numTileTypeWires(fabric.tileType(t));
+    }
+    tile_node_begin_[num_tiles] = num_nodes;
+
+    // only the count, the edges themselves are resolved when read
+    std::atomic<EdgeId> num_edges(0);
+    const int cols = fabric.cols();
+    parallelFor(static_cast<size_t>(fabric.rows()), [&](size_t row_begin, size_t row_end) {
+      EdgeId count = 0;
+      for (int row = static_cast<int>(row_begin); row < static_cast<int>(row_end); row++) {
+        for (int col = 0; col < cols; col++) {
+          const TileTemplate& tmpl = templates_[fabric.tileType(fabric.tileAt(row, col))];
+          NodeId target;
+          for (size_t e = 0; e < tmpl.edges.size(); e++) {
+            if (tmpl.edges[e].from < tmpl.wires.size() && resolveEdge(fabric, row, col, tmpl.edges[e], target)) count++;
+          }
+        }
+      }
+      num_edges += count;
+    }, num_threads);
+    num_edges_ = num_edges.load();
+  }
+
+  RoutingGraph::NodeId RoutingGraph::edgeTarget(const DeviceFabric& fabric, EdgeId edge) const {
+    DeviceFabric::TileId tile = static_cast<DeviceFabric::TileId>(edge >> 32);
+    const TileTemplate& tmpl = templates_[fabric.tileType(tile)];
+    NodeId target = kInvalidNode;
+    resolveEdge(fabric, fabric.tileRow(tile), fabric.tileCol(tile), tmpl.edges[static_cast<uint32_t>(edge)], target);
+    return target;
+  }
+
+  DeviceFabric::TileId RoutingGraph::nodeTile(NodeId node) const {
+    // the last tile whose first node is <= node, empty tiles are skipped
+    std::vector<NodeId>::const_iterator iter = std::upper_bound(tile_node_begin_.begin(), tile_node_begin_.end(), node);
+    return static_cast<DeviceFabric::TileId>(iter - tile_node_begin_.begin() - 1);
+  }
+
+  std::string RoutingGraph::nodeName(const DeviceFabric& fabric, NodeId node) const {
+    DeviceFabric::TileId tile = nodeTile(node);
+    return fabric.tileName(tile) + "/" + wireName(fabric.tileType(tile), node - tile_node_begin_[tile]);
+  }
+
+  RoutingGraph::NodeId RoutingGraph::findNode(const DeviceFabric& fabric, DeviceFabric::TileId tile, const std::string& wire) const {
+    uint32_t w = findWire(fabric.tileType(tile), wire);
+    if (w == DeviceFabric::kInvalidId) {
+      return kInvalidNode;
+    }
+    return tile_node_begin_[tile] + w;
+  }
+
+  size_t RoutingGraph::memoryUsage() const {
+    size_t bytes = tile_node_begin_.capacity() * sizeof(NodeId);
+    for (size_t t = 0; t < templates_.size(); t++) {
+      const TileTemplate& tile = templates_[t];
+      bytes += tile.wires.chars_.capacity() + tile.wires.offsets_.capacity() * sizeof(uint32_t) +
+        tile.edges.capacity() * sizeof(TemplateEdge) + tile.edge_begin.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+  }
+
+  bool RoutingGraph::saveTemplates(const std::string& file_name) const {
+    FILE* fp = fopen(file_name.c_str(), "wb");
+    if (fp == NULL) {
+      eda_error("Cannot open '%s' for writing.\n", file_name.c_str());
+      return false;
+    }
+    uint32_t num_types = static_cast<uint32_t>(templates_.size());
+    bool ok = fwrite(kTemplateMagic, sizeof(kTemplateMagic), 1, fp) == 1 &&
+      fwrite(&kTemplateVersion, sizeof(kTemplateVersion), 1, fp) == 1 &&
+      fwrite(&num_types, sizeof(num_types), 1, fp) == 1;
+    for (uint32_t t = 0; ok && t < num_types; t++) {
+      const TileTemplate& tile = templates_[t];
+      ok = writeString(fp, tile.wires.chars_) && writeVector(fp, tile.wires.offsets_) && writeVector(fp, tile.edges);
+    }
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) {
+      eda_error("Failed to write routing templates '%s'.\n", file_name.c_str());
+    }
+    return ok;
+  }
+
+  bool RoutingGraph::loadTemplates(const std::string& file_name) {
+    FILE* fp = fopen(file_name.c_str(), "rb");
+    if (fp == NULL) {
+      return false;
+    }
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t num_types = 0;
+    bool ok = fread(magic, sizeof(magic), 1, fp) == 1 && memcmp(magic, kTemplateMagic, sizeof(magic)) == 0 &&
+      fread(&version, sizeof(version), 1, fp) == 1 && version == kTemplateVersion &&
+      fread(&num_types, sizeof(num_types), 1, fp) == 1 && num_types <= 0x10000;
+    std::vector<TileTemplate> templates(ok ? num_types : 0);
+    for (uint32_t t = 0; ok && t < num_types; t++) {
+      TileTemplate& tile = templates[t];
+      ok = readString(fp, tile.wires.chars_) && readVector(fp, tile.wires.offsets_) && readVector(fp, tile.edges) &&
+        tile.wires.valid();
+      for (size_t e = 0; ok && e < tile.edges.size(); e++) {
+        ok = tile.edges[e].from < tile.wires.size();
+      }
+    }
+    fclose(fp);
+    if (!ok) {
+      eda_error("Routing templates '%s' are corrupted.\n", file_name.c_str());
+      return false;
+    }
+    templates_.swap(templates);
+    tile_node_begin_.clear();
+    num_edges_ = 0;
+    return true;
+  }
+
+}
@@ -20,6 +20,8 @@ HEADERS += $$top_srcdir/include/gui/gui.h \
            $$top_srcdir/include/gui/project/source_file_selector.h \
            $$top_srcdir/include/gui/console/console.h \
            $$top_srcdir/include/gui/console/main_console.h \
+           $$top_srcdir/include/gui/console/console_line_store.h \
+           $$top_srcdir/include/gui/console/console_find_dialog.h \
            $$top_srcdir/include/gui/console/command_executor.h \
            $$top_srcdir/include/gui/console/command_line.h \
            $$top_srcdir/include/gui/layout/layout_window.h \
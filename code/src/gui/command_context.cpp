@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #include <qevent.h>
 
@@ -10,6 +10,7 @@
 #include "gui/command_context.h"
 #include "gui/main_app.h"
 #include "gui/main_event.h"
+#include "utility/tracer.h"
 
 namespace eda {
 
@@ -105,6 +106,11 @@ namespace eda {
     if (threadStopped()) {
       return;
     }
+    // the command runs on the worker, only changes are posted to the GUI
+    if (value == current_) {
+      return;
+    }
+    Tracer::counter("progress", value);
     current_ = value;
     QEvent* event = new ProgressChangedEvent(value, QEvent::Type(PROGRESS_UPDATED));
     Gui::main_app()->postEvent(receiver_, event);
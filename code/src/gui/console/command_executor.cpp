@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <tcl.h>
@@ -17,6 +17,7 @@
 #include "gui/main_window.h"
 #include "gui/command_context.h"
 #include "gui/console/command_executor.h"
+#include "gui/console/command_worker.h"
 
 #include "utility/log.h"
 
@@ -136,6 +137,32 @@ namespace eda {
     return cmd;
   }
   void CommandExecutor::customEvent(QEvent* event) {
+    if (event->type() == CMD_QUEUE_DONE) {
+      int result = static_cast<CommandQueueDoneEvent*>(event)->result();
+      // restore the stopped flag after executing all commands;
+      if (CommandContext::threadStopped()) {
+        CommandContext::setThreadStopped(false);
+      }
+      onEnded();
+      onFinish(result == TCL_ERROR ? TCL_ERROR : TCL_OK);
+      return;
+    }
+    if (event->type() == PROGRESS_STARTED) {
+      ProgressEvent* progress = static_cast<ProgressEvent*>(event);
+      if (Gui::main_window())
+        Gui::main_window()->showProgress(progress->min(), progress->max(), progress->min());
+      return;
+    }
+    if (event->type() == PROGRESS_UPDATED) {
+      ProgressChangedEvent* progress = static_cast<ProgressChangedEvent*>(event);
+      if (Gui::main_window() && isRunning())
+        Gui::main_window()->showProgress(CommandContext::min(), CommandContext::max(), progress->value());
+      return;
+    }
+    if (event->type() == THREAD_STOPPED) {
+      repaint();
+      return;
+    }
     GlobalEvent* global_event = dynamic_cast<GlobalEvent*>(event);
     if (!global_event) return;
 
@@ -146,28 +173,21 @@ namespace eda {
     }
   }
   void CommandExecutor::run() {
-    std::vector<int> result_flags;
+    QStringList commands;
     QStringList cmd_list = command_.split(";", QString::SkipEmptyParts);
     foreach(QString s, cmd_list) {
-      if (CommandContext::threadStopped()) {
-        break;
-      }
-      int result = Gui::executeCmd(s, true);
-      result_flags.push_back(result);
-      if (result == TCL_ERROR) {
-        break;
+      if (Gui::prepareCmd(s)) {
+        commands.append(s);
       }
     }
-    // restore the stopped flag after executing all commands;
-    if (CommandContext::threadStopped()) {
-      CommandContext::setThreadStopped(false);
-    }
-    onEnded();
-    if (std::find(result_flags.begin(), result_flags.end(), TCL_ERROR) != result_flags.end()) {
+    if (Gui::command_worker() == NULL) {
+      eda_error("No Tcl Interpret specified.\n");
+      onEnded();
       onFinish(TCL_ERROR);
-    } else {
-      onFinish(TCL_OK);
+      return;
     }
+    // the result comes back as a CommandQueueDoneEvent
+    Gui::command_worker()->post(commands, this);
   }
   void CommandExecutor::runCommand() {
     if (command_.isEmpty()) {
@@ -188,7 +208,13 @@ namespace eda {
     emit sigStart();
   }
   void CommandExecutor::stop() {
+    if (!isRunning()) {
+      return;
+    }
     CommandContext::setThreadStopped(true);
+    if (Gui::command_worker()) {
+      Gui::command_worker()->cancel();
+    }
     state_ = State::kUserStopped;
     sector_ = 0;
   }
@@ -223,6 +249,10 @@ namespace eda {
       }
     }
     repaint();
+    // the session was opened by MainConsole::run()
+    if (CommandContext::inited()) {
+      CommandContext::reset();
+    }
     QMap<const char*, QVariant> attributes = { {GlobalEvent::key_result , tcl_result} };
     EventDispatcher::instance()->broadcastEvent(GlobalEvent::kEventLabelWorkFinish, this, attributes);
     emit sigFinish(tcl_result);
@@ -237,6 +267,8 @@ namespace eda {
     repaint();
   }
   void CommandExecutor::onEnded() {
+    if (Gui::main_window())
+      Gui::main_window()->showProgress(0, 0, -1);
     Gui::main_app()->setBusy(false);
     Gui::main_app()->removeExceptObject(this);
     timer_.stop();
@@ -2,18 +2,20 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
-#include <tcl.h>
+#include <qabstractitemview.h>
 #include <qcompleter.h>
 #include <qfile.h>
 #include <qchar.h>
 #include <qstringlist.h>
+#include <qstringlistmodel.h>
 
 #include "gui/gui.h"
 #include "gui/console/command_line.h"
 #include "gui/console/main_console.h"
+#include "tcl/completion.h"
 
 #include "utility/log.h"
 
@@ -21,18 +23,16 @@ namespace eda {
 
   CommandLine::CommandLine(MainConsole* main_console, QWidget* parent) : QLineEdit(parent) {
     main_console_ = main_console;
-    QStringList all_commands;
-    Tcl_Interp* interp = Gui::interp();
-    int res = Tcl_Eval(interp, qPrintable(QString("info commands")));
-    if (!res) {
-      //Get the string result of the executed command
-      QString result = Tcl_GetString(Tcl_GetObjResult(interp));
-      if (!result.isEmpty()) {
-        all_commands = result.split(" ");
-      }
-    }
-    QCompleter* completer = new QCompleter(all_commands, this);
-    this->setCompleter(completer);
+    // not setCompleter(), it would complete the whole line
+    completion_model_ = new QStringListModel(this);
+    completer_ = new QCompleter(completion_model_, this);
+    completer_->setWidget(this);
+    completer_->setCompletionMode(QCompleter::PopupCompletion);
+    completer_->setCaseSensitivity(Qt::CaseSensitive);
+    completer_->setModelSorting(QCompleter::CaseSensitivelySortedModel);
+    completion_start_ = 0;
+    connect(completer_, SIGNAL(activated(const QString&)), this, SLOT(insertCompletion(const QString&)));
+    connect(this, SIGNAL(textEdited(const QString&)), this, SLOT(onTextEdited(const QString&)));
   }
   CommandLine::~CommandLine() {
   
@@ -77,6 +77,20 @@ namespace eda {
     return (*current_iter_);
   }
   void CommandLine::keyPressEvent(QKeyEvent* event) {
+    if (completer_->popup()->isVisible()) {
+      // the popup takes these
+      switch (event->key()) {
+        case Qt::Key_Enter:
+        case Qt::Key_Return:
+        case Qt::Key_Escape:
+        case Qt::Key_Tab:
+        case Qt::Key_Backtab:
+          event->ignore();
+          return;
+        default:
+          break;
+      }
+    }
     switch (event->key()) {
       case Qt::Key_Up:
         keyUp();
@@ -89,6 +103,8 @@ namespace eda {
         keyEnter();
         break;
       case Qt::Key_Tab:
+        complete(true);
+        break;
       default:
         QLineEdit::keyPressEvent(event);
     }
@@ -126,5 +142,54 @@ namespace eda {
       setText("");
     }
   }
+  bool CommandLine::focusNextPrevChild(bool) {
+    return false;
+  }
+  void CommandLine::complete(bool tab) {
+    const QString line = text();
+    int end = cursorPosition();
+    int start = end;
+    while (start > 0 && !QString(" \t;[]{}\"").contains(line[start - 1])) {
+      start--;
+    }
+    if (!tab && !completer_->popup()->isVisible() && !line.left(start).trimmed().isEmpty())
+      return;
+    // the byte offsets of the word in UTF-8
+    std::string prefix = line.left(start).toStdString();
+    std::string text_to_cursor = line.left(end).toStdString();
+    CommandCompletion::Result result;
+    if (!gCompletion.complete(text_to_cursor, prefix.size(), text_to_cursor.size(), result)) {
+      completer_->popup()->hide();
+      return;
+    }
+    completion_start_ = start;
+    if (tab && result.num_matches == 1) {
+      completer_->popup()->hide();
+      insertCompletion(QString::fromStdString(result.matches[0]));
+      return;
+    }
+    QString word = line.mid(start, end - start);
+    if (tab) {
+      word = QString::fromStdString(result.common);
+      insertCompletion(word);
+    }
+    QStringList matches;
+    for (size_t i = 0; i < result.matches.size(); i++) {
+      matches.append(QString::fromStdString(result.matches[i]));
+    }
+    completion_model_->setStringList(matches);
+    completer_->setCompletionPrefix(word);
+    completer_->complete();
+  }
+  void CommandLine::insertCompletion(const QString& completion) {
+    QString line = text();
+    int end = cursorPosition();
+    line.replace(completion_start_, end - completion_start_, completion);
+    setText(line);
+    setCursorPosition(completion_start_ + completion.length());
+  }
+  void CommandLine::onTextEdited(const QString&) {
+    complete(false);
+  }
 
 }
\ No newline at end of file
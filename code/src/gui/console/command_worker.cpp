@@ -0,0 +1,112 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <qapplication.h>
+
+#include "gui/gui.h"
+#include "gui/main_event.h"
+#include "gui/command_context.h"
+#include "gui/console/command_worker.h"
+#include "gui/layout/layout_window.h"
+#include "tcl/completion.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  CommandWorker::CommandWorker(QObject* parent) : QThread(parent), canceled_(false) {
+    stopping_ = false;
+    busy_ = false;
+    cancel_handler_ = NULL;
+  }
+  CommandWorker::~CommandWorker() {
+    finish();
+  }
+  void CommandWorker::post(const QStringList& commands, QObject* receiver) {
+    QMutexLocker locker(&mutex_);
+    Job job;
+    job.commands = commands;
+    job.receiver = receiver;
+    jobs_.enqueue(job);
+    work_.wakeOne();
+  }
+  void CommandWorker::cancel() {
+    QMutexLocker locker(&mutex_);
+    if (!busy_ || cancel_handler_ == NULL)
+      return;
+    canceled_ = true;
+    // the Tcl library is built without threads, marking only sets flags
+    // that the interpreter checks between commands
+    Tcl_AsyncMark(cancel_handler_);
+  }
+  void CommandWorker::finish() {
+    {
+      QMutexLocker locker(&mutex_);
+      jobs_.clear();
+      stopping_ = true;
+      work_.wakeAll();
+    }
+    cancel();
+    wait();
+  }
+  bool CommandWorker::busy() {
+    QMutexLocker locker(&mutex_);
+    return busy_ || !jobs_.isEmpty();
+  }
+  int CommandWorker::onCancel(ClientData data, Tcl_Interp* interp, int code) {
+    CommandWorker* worker = static_cast<CommandWorker*>(data);
+    if (!worker->canceled_.load()) {
+      return code;
+    }
+    if (interp != NULL) {
+      Tcl_SetResult(interp, const_cast<char*>("canceled by user"), TCL_STATIC);
+    }
+    return TCL_ERROR;
+  }
+  void CommandWorker::run() {
+    Tracer::set_thread_name("tcl");
+    QMutexLocker locker(&mutex_);
+    cancel_handler_ = Tcl_AsyncCreate(onCancel, this);
+    while (true) {
+      while (jobs_.isEmpty() && !stopping_) {
+        work_.wait(&mutex_);
+      }
+      if (stopping_)
+        break;
+      Job job = jobs_.dequeue();
+      busy_ = true;
+      canceled_ = false;
+      locker.unlock();
+      int result = runJob(job);
+      locker.relock();
+      // busy() must be false by the time the receiver handles the event,
+      // its handlers reload what the commands changed
+      busy_ = false;
+      if (job.receiver != NULL)
+        QApplication::postEvent(job.receiver, new CommandQueueDoneEvent(result));
+    }
+    Tcl_AsyncDelete(cancel_handler_);
+    cancel_handler_ = NULL;
+  }
+  int CommandWorker::runJob(const Job& job) {
+    int result = TCL_OK;
+    foreach(const QString& command, job.commands) {
+      if (CommandContext::threadStopped() || canceled_.load()) {
+        break;
+      }
+      result = Gui::evalCmd(command, true);
+      if (result == TCL_ERROR) {
+        break;
+      }
+    }
+    // the commands may have defined procs and variables
+    gCompletion.indexInterp(Gui::interp());
+    // the design can only be read here, between the jobs
+    LayoutWindow::prepareScene();
+    return result;
+  }
+
+}
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #ifndef WIN32
@@ -16,12 +16,18 @@
 #include <Psapi.h>
 #endif
 
+#include <time.h>
+
 #include <qapplication.h>
 #include <qmessagebox.h>
 
 #include "utility/assert.h"
 #include "utility/file.h"
 #include "utility/app.h"
+#include "utility/log_file.h"
+#include "utility/log_index.h"
+#include "utility/log_queue.h"
+#include "utility/memory_tracker.h"
 #include "gui/gui.h"
 #include "gui/main_app.h"
 #include "gui/main_event.h"
@@ -32,19 +38,8 @@ namespace eda {
 #define LOG_BUF_SIZE 4096
 
   MainConsole* Console::console_ = NULL;
-  FILE* Console::fp_ = NULL;
   std::string Console::logfile_name_ = "";
 
-  FILE* Console::fp() { 
-    return fp_; 
-  }
-
-  void Console::set_fp(FILE* fp) {
-    if (fp_ != NULL)
-      fclose(fp_);
-    fp_ = fp;
-  }
-
   std::string Console::logfile_name() {
     return logfile_name_;
   }
@@ -63,166 +58,225 @@ namespace eda {
     console_ = console;
   }
 
+  namespace {
+
+    LogFile gLogFile;
+    LogIndex gLogIndex;
+    bool gLogIndexed = false;
+    bool gLogJson = false;
+
+    const char* severityName(int type) {
+      switch (type) {
+        case CONSOLE_INFO: return "INFO";
+        case CONSOLE_WARN: return "WARN";
+        case CONSOLE_ERROR: return "ERROR";
+        case CONSOLE_DEBUG: return "DEBUG";
+        default: return "PRINT";
+      }
+    }
+
+    // {"time":"2026-10-17T08:15:30.123456Z","severity":"INFO","thread":1,
+    //  "command":3,"message":"..."} and a newline
+    void formatJson(const LogQueue::Entry& entry, std::string& line) {
+      static int64_t cached_second = -1;
+      static char cached_time[32];
+      int64_t second = entry.time_us / 1000000;
+      if (second != cached_second) {
+        time_t t = static_cast<time_t>(second);
+        struct tm parts;
+#ifdef WIN32
+        gmtime_s(&parts, &t);
+#else
+        gmtime_r(&t, &parts);
+#endif
+        strftime(cached_time, sizeof(cached_time), "%Y-%m-%dT%H:%M:%S", &parts);
+        cached_second = second;
+      }
+      char head[160];
+      int length = snprintf(head, sizeof(head), "{\"time\":\"%s.%06dZ\",\"severity\":\"%s\",\"thread\":%u,\"command\":%u,\"message\":\"",
+        cached_time, static_cast<int>(entry.time_us % 1000000), severityName(entry.type), entry.thread_id, entry.command_id);
+      line.assign(head, static_cast<size_t>(length));
+      for (size_t i = 0; i < entry.length; i++) {
+        unsigned char c = static_cast<unsigned char>(entry.text[i]);
+        switch (c) {
+          case '"': line += "\\\""; break;
+          case '\\': line += "\\\\"; break;
+          case '\n': line += "\\n"; break;
+          case '\r': line += "\\r"; break;
+          case '\t': line += "\\t"; break;
+          default:
+            if (c < 0x20) {
+              char escaped[8];
+              snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+              line += escaped;
+            } else {
+              line += static_cast<char>(c);
+            }
+            break;
+        }
+      }
+      line += "\"}\n";
+    }
+
+    // Moves the full log file aside together with its index.
+    void rotateLogFile() {
+      gLogFile.flush();
+      if (gLogIndexed)
+        gLogIndex.save();
+      std::string moved_name = gLogFile.rotate();
+      if (moved_name.empty())
+        return;
+      if (gLogIndexed) {
+        File::rename(LogIndex::indexFile(gLogFile.file_name()).c_str(), LogIndex::indexFile(moved_name).c_str());
+        gLogIndex.reset(gLogFile.file_name());
+      }
+    }
+
+    // Writes the messages to the log file, and to the console window or the
+    // terminal. Runs on the writer thread of the LogQueue, or on the calling
+    // thread while the queue is not running.
+    class ConsoleSink : public LogQueue::Sink {
+    public:
+      void write(const LogQueue::Entry& entry) {
+        MainConsole* console = Console::console_window();
+        int type = entry.type;
+        const char* text = entry.text;
+        size_t length = entry.length;
+        if (type == CONSOLE_END) {
+          if (console != NULL)
+            QApplication::postEvent(console, new ConsoleEvent(CONSOLE_END, ""));
+          return;
+        }
+        if (gLogFile.isOpen()) {
+          if (gLogFile.full())
+            rotateLogFile();
+          const char* record = text;
+          size_t record_length = length;
+          if (gLogJson) {
+            formatJson(entry, json_line_);
+            record = json_line_.data();
+            record_length = json_line_.size();
+          }
+          gLogFile.write(record, record_length);
+          if (gLogIndexed)
+            gLogIndex.append(record, record_length);
+        }
+        // plain prints always go to the terminal
+        if (type != CONSOLE_PRINT && console != NULL) {
+          console->postOutput(type, text, length);
+          return;
+        }
+#ifdef WIN32
+        WORD color = 0x07;
+        switch (type) {
+        case CONSOLE_WARN: color = 0x06; break;  // yellow
+        case CONSOLE_ERROR: color = 0x04; break; // red
+        case CONSOLE_DEBUG: color = 0x02; break; // green
+        default: break;
+        }
+        if (color != 0x07) {
+          fflush(stdout);
+          SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+          fwrite(text, 1, length, stdout);
+          fflush(stdout);
+          SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x07);
+          return;
+        }
+#endif
+        fwrite(text, 1, length, stdout);
+      }
+
+      void flush() {
+        gLogFile.flush();
+        fflush(stdout);
+      }
+
+    private:
+      std::string json_line_;
+    };
+
+    ConsoleSink gConsoleSink;
+
+  }
+
+  LogIndex& Console::log_index() {
+    return gLogIndex;
+  }
+
   void Console::done() {
-    if (console_ != NULL) {
-      QApplication::postEvent(console_, new ConsoleEvent(CONSOLE_END, ""));
+    if (!LogQueue::push(CONSOLE_END, "")) {
+      LogQueue::Entry entry;
+      entry.type = CONSOLE_END;
+      entry.text = "";
+      entry.length = 0;
+      LogQueue::stamp(entry);
+      gConsoleSink.write(entry);
+    }
+  }
+
+  void Console::flush() {
+    LogQueue::flush();
+  }
+
+  void Console::write(int type, const char* prefix, const char* format, va_list args) {
+    if (LogQueue::push(type, prefix, format, args)) {
+      return;
     }
+    MemoryTagScope scope(MemoryTracker::TAG_LOG);
+    char buffer[LOG_BUF_SIZE];
+    size_t length = strlen(prefix);
+    if (length >= LOG_BUF_SIZE)
+      length = LOG_BUF_SIZE - 1;
+    memcpy(buffer, prefix, length);
+    int size = vsnprintf(buffer + length, LOG_BUF_SIZE - length, format, args);
+    length += static_cast<size_t>(size > 0 ? size : 0);
+    if (length >= LOG_BUF_SIZE)
+      length = LOG_BUF_SIZE - 1;
+    LogQueue::Entry entry;
+    entry.type = type;
+    entry.text = buffer;
+    entry.length = length;
+    LogQueue::stamp(entry);
+    gConsoleSink.write(entry);
+    gConsoleSink.flush();
   }
 
   void Console::print(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[LOG_BUF_SIZE] = { 0 };
-    vsnprintf(buffer, LOG_BUF_SIZE, format, args);
+    write(CONSOLE_PRINT, "", format, args);
     va_end(args);
-
-    if (fp_ != NULL) {
-      fprintf(fp_, "%s", buffer);
-#ifdef WIN32
-      fflush(fp_);
-#endif
-    }
-    printf("%s", buffer);
-    fflush(stdout);
   }
 
   void Console::printInfoMsg(const char* format, ...) {
-    bool output = false;
-
     va_list args;
     va_start(args, format);
-    char info_format[LOG_BUF_SIZE] = "*INFO*: ";
-    strcat(info_format, format);
-    char buffer[LOG_BUF_SIZE] = { 0 };
-    vsnprintf(buffer, LOG_BUF_SIZE, info_format, args);
+    write(CONSOLE_INFO, "*INFO*: ", format, args);
     va_end(args);
-
-    if (console_ != NULL) {
-      ConsoleEvent* event = new ConsoleEvent(CONSOLE_INFO, buffer);
-      QApplication::postEvent(console_, event);
-      output = true;
-    }
-
-    if (fp_ != NULL) {
-      fprintf(fp_, "%s", buffer);
-#ifdef WIN32
-      fflush(fp_);
-#endif
-    }
-    if (!output) {
-      printf("%s", buffer);
-      fflush(stdout);
-    }
   }
 
   void Console::printWarnMsg(const char* format, ...) {
-    bool output = false;
-
     va_list args;
     va_start(args, format);
-    char warn_format[LOG_BUF_SIZE] = "*WARN*: ";
-    strcat(warn_format, format);
-    char buffer[LOG_BUF_SIZE] = { 0 };
-    vsnprintf(buffer, LOG_BUF_SIZE, warn_format, args);
+    write(CONSOLE_WARN, "*WARN*: ", format, args);
     va_end(args);
-
-    if (console_ != NULL) {
-      ConsoleEvent* event = new ConsoleEvent(CONSOLE_WARN, buffer);
-      QApplication::postEvent(console_, event);
-      output = true;
-    }
-
-    if (fp_ != NULL) {
-      fprintf(fp_, "%s", buffer);
-#ifdef WIN32
-      fflush(fp_);
-#endif
-    }
-
-    if (!output) {
-#ifdef WIN32
-      //#define COLOR_YELLOW 6
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x06);
-      printf("%s", buffer);
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x07);
-#else
-      printf("%s", buffer);
-#endif
-      fflush(stdout);
-    }
   }
 
   void Console::printErrorMsg(const char* format, ...) {
-    bool output = false;
-
     va_list args;
     va_start(args, format);
-    char error_format[LOG_BUF_SIZE] = "*ERROR*: ";
-    strcat(error_format, format);
-    char buffer[LOG_BUF_SIZE] = { 0 };
-    vsnprintf(buffer, LOG_BUF_SIZE, error_format, args);
+    write(CONSOLE_ERROR, "*ERROR*: ", format, args);
     va_end(args);
-
-    if (console_ != NULL) {
-      ConsoleEvent* event = new ConsoleEvent(CONSOLE_ERROR, buffer);
-      QApplication::postEvent(console_, event);
-      output = true;
-    }
-
-    if (fp_ != NULL) {
-      fprintf(fp_, "%s", buffer);
-#ifdef WIN32
-      fflush(fp_);
-#endif
-    }
-
-    if (!output) {
-#ifdef WIN32
-      //#define COLOR_RED 4
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x04);
-      printf("%s", buffer);
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x07);
-#else
-      printf("%s", buffer);
-#endif
-      fflush(stdout);
-    }
   }
 
   void Console::printDebugMsg(const char* format, ...) {
 #ifdef DEBUG
-    bool output = false;
     va_list args;
     va_start(args, format);
-    char debug_format[LOG_BUF_SIZE] = "*DEBUG*: ";
-    strcat(debug_format, format);
-    char buffer[LOG_BUF_SIZE] = { 0 };
-    vsnprintf(buffer, LOG_BUF_SIZE, debug_format, args);
+    write(CONSOLE_DEBUG, "*DEBUG*: ", format, args);
     va_end(args);
-
-    if (console_ != NULL) {
-      ConsoleEvent* event = new ConsoleEvent(CONSOLE_DEBUG, buffer);
-      QApplication::postEvent(console_, event);
-      output = true;
-    }
-
-    if (fp_ != NULL) {
-      fprintf(fp_, "%s", buffer);
-#ifdef WIN32
-      fflush(fp_);
-#endif
-    }
-    if (!output) {
-#ifdef WIN32
-      //#define COLOR_GREEN 4
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x02);
-      printf("%s", buffer);
-      SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 0x07);
 #else
-      printf("%s", buffer);
-#endif
-      fflush(stdout);
-    }
+    (void)format;
 #endif // DEBUG
   }
 
@@ -262,13 +316,20 @@ namespace eda {
     return 0;
   }
 
-  void Console::startLogFile(std::string log_file) {
-    if (!App::avoidOverwrite(log_file)) {
+  void Console::startLogFile(std::string log_file, const LogOptions& options) {
+    bool compress = options.compress && LogFile::canCompress();
+    if (compress) {
+      log_file += ".gz";
+    }
+    std::string moved_name;
+    if (!App::avoidOverwrite(log_file, &moved_name)) {
       printErrorMsg("Failed to rename existing log file %s, it has to been overwriten!\n", log_file.c_str());
+    } else if (!moved_name.empty()) {
+      File::rename(LogIndex::indexFile(log_file).c_str(), LogIndex::indexFile(moved_name).c_str());
     }
     size_t path_index = log_file.find_last_of('/');
     std::string log_dir = ".";
-    if (path_index != -1) {
+    if (path_index != std::string::npos) {
       log_dir = log_file.substr(0, path_index + 1);
     }
     //check if log_dir can be accessed
@@ -276,25 +337,57 @@ namespace eda {
       File::mkdir(log_dir.c_str());
     }
     //check if log_dir can be written
-    if (File::access(log_dir.c_str(), 2) != -1) {
-      FILE* fp = fopen(log_file.c_str(), "w");
-      if (ferror(fp)) eda_assert(0);
-      
-      Console::set_fp(fp);
+    uint64_t max_bytes = static_cast<uint64_t>(options.max_size_mb > 0 ? options.max_size_mb : 0) << 20;
+    if (File::access(log_dir.c_str(), 2) != -1 && gLogFile.open(log_file, compress, max_bytes)) {
       Console::set_logfile_name(log_file);
-#ifdef WIN32
-      //setvbuf(fp, NULL, _IOLBF, 256); // no line buffer on windows
-#else
-      setlinebuf(fp);
-#endif
+      gLogJson = options.json;
+      // the index reads the lines back from the file
+      gLogIndexed = !compress;
+      if (gLogIndexed)
+        gLogIndex.reset(log_file);
+    }
+    // the file is flushed once per batch of messages, no line buffering
+    LogQueue::start(&gConsoleSink);
+    if (!gLogFile.isOpen()) {
+      printErrorMsg("Could not open the log file %s.\n", log_file.c_str());
+    }
+    if (options.compress && !compress) {
+      printWarnMsg("This build has no zlib, the log is not compressed.\n");
+    }
+    if (!moved_name.empty()) {
+      printInfoMsg("The existing log file was moved to %s.\n", moved_name.c_str());
     }
-    return;
   }
 
   void Console::endLogFile() {
-    if (fp_ != NULL)
-      fclose(fp_);
-    fp_ = NULL;
+    LogQueue::stop();
+    if (gLogFile.isOpen()) {
+      gLogFile.close();
+      if (gLogIndexed)
+        gLogIndex.save();
+    }
+    gLogIndexed = false;
     logfile_name_ = "";
   }
+  bool Console::appendLogFile(const std::string& file_name) {
+    FILE* fp = fopen(file_name.c_str(), "rb");
+    if (fp == NULL)
+      return false;
+    // the writer thread is stopped so the copy is not mixed with new messages
+    bool restart = LogQueue::running();
+    LogQueue::stop();
+    std::vector<char> buffer(64 * 1024);
+    size_t length = 0;
+    while (gLogFile.isOpen() && (length = fread(buffer.data(), 1, buffer.size(), fp)) > 0) {
+      if (gLogFile.full())
+        rotateLogFile();
+      gLogFile.write(buffer.data(), length);
+      if (gLogIndexed)
+        gLogIndex.append(buffer.data(), length);
+    }
+    fclose(fp);
+    if (restart)
+      LogQueue::start(&gConsoleSink);
+    return true;
+  }
 }
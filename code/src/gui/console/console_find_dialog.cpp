@@ -0,0 +1,93 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+#include <qboxlayout.h>
+#include <qelapsedtimer.h>
+#include <qfont.h>
+#include <qfontdatabase.h>
+
+#include <string>
+#include <vector>
+
+#include "gui/console/console.h"
+#include "gui/console/console_find_dialog.h"
+#include "utility/log_index.h"
+
+namespace eda {
+
+  ConsoleFindDialog::ConsoleFindDialog(QWidget* parent) : QDialog(parent) {
+    setWindowTitle("Find in Log");
+    resize(720, 420);
+    QVBoxLayout* vbox_layout = new QVBoxLayout(this);
+    vbox_layout->setSpacing(4);
+    setLayout(vbox_layout);
+    QHBoxLayout* hbox_layout = new QHBoxLayout();
+    pattern_edit_ = new QLineEdit(this);
+    regex_box_ = new QCheckBox("Regular expression", this);
+    case_box_ = new QCheckBox("Match case", this);
+    find_btn_ = new QPushButton("Find", this);
+    find_btn_->setDefault(true);
+    hbox_layout->addWidget(pattern_edit_, 1);
+    hbox_layout->addWidget(regex_box_);
+    hbox_layout->addWidget(case_box_);
+    hbox_layout->addWidget(find_btn_);
+    vbox_layout->addLayout(hbox_layout);
+    result_list_ = new QListWidget(this);
+    result_list_->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    result_list_->setUniformItemSizes(true);
+    vbox_layout->addWidget(result_list_, 1);
+    status_label_ = new QLabel(this);
+    vbox_layout->addWidget(status_label_);
+    connect(find_btn_, SIGNAL(clicked()), this, SLOT(onFind()));
+    connect(pattern_edit_, SIGNAL(returnPressed()), this, SLOT(onFind()));
+  }
+
+  ConsoleFindDialog::~ConsoleFindDialog() {}
+
+  void ConsoleFindDialog::set_pattern(const QString& pattern) {
+    pattern_edit_->setText(pattern);
+    pattern_edit_->selectAll();
+    pattern_edit_->setFocus();
+  }
+
+  void ConsoleFindDialog::onFind() {
+    QString pattern = pattern_edit_->text();
+    result_list_->clear();
+    if (pattern.isEmpty()) {
+      status_label_->clear();
+      return;
+    }
+    LogIndex& index = Console::log_index();
+    if (index.log_file().empty()) {
+      status_label_->setText("The log file is not open or compressed, it has no index.");
+      return;
+    }
+    int flags = 0;
+    if (regex_box_->isChecked())
+      flags |= LogIndex::SEARCH_REGEX;
+    if (!case_box_->isChecked())
+      flags |= LogIndex::SEARCH_IGNORE_CASE;
+    QElapsedTimer timer;
+    timer.start();
+    // everything printed so far has to be in the file
+    Console::flush();
+    std::vector<LogIndex::Match> matches;
+    std::string error;
+    if (!index.search(pattern.toStdString(), flags, kMaxMatches, matches, error)) {
+      status_label_->setText(QString::fromStdString(error));
+      return;
+    }
+    result_list_->setUpdatesEnabled(false);
+    for (size_t i = 0; i < matches.size(); i++) {
+      result_list_->addItem(QString::number(matches[i].line + 1) + ": " + QString::fromUtf8(matches[i].text.c_str()));
+    }
+    result_list_->setUpdatesEnabled(true);
+    QString count = matches.size() >= static_cast<size_t>(kMaxMatches) ?
+      QString("First %1 matching lines").arg(kMaxMatches) : QString("%1 matching lines").arg(matches.size());
+    status_label_->setText(count + QString(" in %1 (%2ms).").arg(QString::fromStdString(index.log_file())).arg(timer.elapsed()));
+  }
+
+}
@@ -0,0 +1,221 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#include <algorithm>
+
+#include "gui/console/console_line_store.h"
+
+namespace eda {
+
+  namespace {
+
+    bool seekFile(FILE* file, int64_t offset, int origin) {
+#ifdef WIN32
+      return _fseeki64(file, offset, origin) == 0;
+#else
+      return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+    }
+
+    int64_t tellFile(FILE* file) {
+#ifdef WIN32
+      return _ftelli64(file);
+#else
+      return static_cast<int64_t>(ftello(file));
+#endif
+    }
+
+  }
+
+  ConsoleLineStore::ConsoleLineStore() {
+    num_lines_ = 0;
+    line_open_ = false;
+    line_length_ = 0;
+    max_line_length_ = 0;
+    num_resident_ = 0;
+    use_clock_ = 0;
+    spill_ = NULL;
+    warn_type_ = -1;
+    error_type_ = -1;
+  }
+
+  ConsoleLineStore::~ConsoleLineStore() {
+    if (spill_ != NULL)
+      fclose(spill_);
+  }
+
+  void ConsoleLineStore::append(int type, const char* text, size_t length) {
+    if (length == 0)
+      return;
+    if (!line_open_)
+      startLine(type);
+    if (type == warn_type_) {
+      warn_lines_.push_back(num_lines_ - 1);
+    } else if (type == error_type_) {
+      error_lines_.push_back(num_lines_ - 1);
+    }
+    const char* p = text;
+    const char* end = text + length;
+    while (p < end) {
+      if (!line_open_)
+        startLine(type);
+      const char* newline = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+      const char* stop = newline != NULL ? newline + 1 : end;
+      Chunk& chunk = chunks_.back();
+      chunk.text.insert(chunk.text.end(), p, stop);
+      chunk.size = chunk.text.size();
+      line_length_ += static_cast<size_t>(stop - p);
+      if (newline != NULL) {
+        line_length_--;
+        line_open_ = false;
+      }
+      max_line_length_ = std::max(max_line_length_, line_length_);
+      p = stop;
+    }
+  }
+
+  void ConsoleLineStore::startLine(int type) {
+    if (chunks_.empty() || chunks_.back().size >= kChunkSize) {
+      chunks_.push_back(Chunk());
+      Chunk& chunk = chunks_.back();
+      chunk.first_line = num_lines_;
+      chunk.num_lines = 0;
+      chunk.file_offset = -1;
+      chunk.size = 0;
+      chunk.last_use = ++use_clock_;
+      chunk.text.reserve(kChunkSize + kChunkSize / 8);
+      num_resident_++;
+      evict();
+    }
+    Chunk& chunk = chunks_.back();
+    chunk.line_starts.push_back(static_cast<uint32_t>(chunk.text.size()));
+    chunk.text.push_back(static_cast<char>(type));
+    chunk.size = chunk.text.size();
+    chunk.num_lines++;
+    num_lines_++;
+    line_open_ = true;
+    line_length_ = 0;
+  }
+
+  void ConsoleLineStore::clear() {
+    std::vector<Chunk>().swap(chunks_);
+    std::vector<uint32_t>().swap(warn_lines_);
+    std::vector<uint32_t>().swap(error_lines_);
+    num_lines_ = 0;
+    line_open_ = false;
+    line_length_ = 0;
+    max_line_length_ = 0;
+    num_resident_ = 0;
+    if (spill_ != NULL) {
+      fclose(spill_);
+      spill_ = NULL;
+    }
+  }
+
+  bool ConsoleLineStore::line(uint32_t index, std::string& text, int& type) {
+    if (index >= num_lines_)
+      return false;
+    Chunk& chunk = chunks_[findChunk(index)];
+    if (!load(chunk))
+      return false;
+    chunk.last_use = ++use_clock_;
+    uint32_t local = index - chunk.first_line;
+    size_t begin = chunk.line_starts[local];
+    size_t end = local + 1 < chunk.line_starts.size() ? chunk.line_starts[local + 1] : chunk.text.size();
+    type = static_cast<unsigned char>(chunk.text[begin]);
+    begin++;
+    if (end > begin && chunk.text[end - 1] == '\n')
+      end--;
+    text.assign(chunk.text.data() + begin, end - begin);
+    return true;
+  }
+
+  const std::vector<uint32_t>& ConsoleLineStore::messageLines(int type) const {
+    static const std::vector<uint32_t> kNoLines;
+    if (type == warn_type_)
+      return warn_lines_;
+    if (type == error_type_)
+      return error_lines_;
+    return kNoLines;
+  }
+
+  size_t ConsoleLineStore::residentBytes() const {
+    size_t bytes = 0;
+    for (size_t i = 0; i < chunks_.size(); i++) {
+      bytes += chunks_[i].text.capacity() + chunks_[i].line_starts.capacity() * sizeof(uint32_t);
+    }
+    return bytes + (warn_lines_.capacity() + error_lines_.capacity()) * sizeof(uint32_t);
+  }
+
+  size_t ConsoleLineStore::findChunk(uint32_t line) const {
+    size_t lo = 0;
+    size_t hi = chunks_.size();
+    while (hi - lo > 1) {
+      size_t mid = (lo + hi) / 2;
+      if (chunks_[mid].first_line <= line) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  bool ConsoleLineStore::load(Chunk& chunk) {
+    if (!chunk.text.empty())
+      return true;
+    if (spill_ == NULL || chunk.file_offset < 0 || !seekFile(spill_, chunk.file_offset, SEEK_SET))
+      return false;
+    chunk.text.resize(chunk.size);
+    if (fread(chunk.text.data(), 1, chunk.size, spill_) != chunk.size) {
+      std::vector<char>().swap(chunk.text);
+      return false;
+    }
+    chunk.line_starts.reserve(chunk.num_lines);
+    chunk.line_starts.push_back(0);
+    const char* begin = chunk.text.data();
+    const char* end = begin + chunk.size;
+    const char* p = begin;
+    while ((p = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)))) != NULL && ++p < end) {
+      chunk.line_starts.push_back(static_cast<uint32_t>(p - begin));
+    }
+    chunk.last_use = ++use_clock_;
+    num_resident_++;
+    evict();
+    return true;
+  }
+
+  void ConsoleLineStore::evict() {
+    while (num_resident_ > kMaxResidentChunks) {
+      // the last chunk is still growing and always stays
+      size_t victim = chunks_.size();
+      for (size_t i = 0; i + 1 < chunks_.size(); i++) {
+        if (!chunks_[i].text.empty() && (victim == chunks_.size() || chunks_[i].last_use < chunks_[victim].last_use)) {
+          victim = i;
+        }
+      }
+      if (victim == chunks_.size())
+        return;
+      Chunk& chunk = chunks_[victim];
+      if (chunk.file_offset < 0) {
+        if (spill_ == NULL)
+          spill_ = tmpfile();
+        if (spill_ == NULL || !seekFile(spill_, 0, SEEK_END))
+          return;
+        int64_t offset = tellFile(spill_);
+        if (offset < 0 || fwrite(chunk.text.data(), 1, chunk.size, spill_) != chunk.size)
+          return;
+        chunk.file_offset = offset;
+      }
+      std::vector<char>().swap(chunk.text);
+      std::vector<uint32_t>().swap(chunk.line_starts);
+      num_resident_--;
+    }
+  }
+
+}
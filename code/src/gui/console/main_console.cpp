@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <qfile.h>
@@ -17,15 +17,23 @@
 #include <qapplication.h>
 #include <qclipboard.h>
 #include <qframe.h>
+#include <qpainter.h>
+#include <qfontdatabase.h>
+
+#include <limits.h>
+#include <algorithm>
+#include <string>
 
 #include <tcl.h>
 #include "gui/gui.h"
 #include "gui/gui_utility.h"
 #include "gui/command_context.h"
 #include "gui/console/console.h"
+#include "gui/console/console_find_dialog.h"
 #include "gui/console/main_console.h"
 #include "gui/console/command_executor.h"
 #include "utility/log.h"
+#include "utility/memory_tracker.h"
 
 
 namespace eda {
@@ -35,86 +43,315 @@ namespace eda {
   QColor MainConsole::errColor = QColor(255, 0, 0);
   QColor MainConsole::debugColor = QColor(255, 0, 255);
 
-  MainConsole::MainConsole(QWidget* parent) : QTextBrowser(parent) {
+  MainConsole::MainConsole(QWidget* parent) : QAbstractScrollArea(parent) {
     setFrameStyle(QFrame::NoFrame | QFrame::Plain);
-    setOpenLinks(false);
     setMinimumHeight(5);
     setContextMenuPolicy(Qt::ActionsContextMenu);
-    setReadOnly(true);
+    setFocusPolicy(Qt::StrongFocus);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    viewport()->setCursor(Qt::IBeamCursor);
     copy_text_ = new QAction(QIcon(Gui::resource_path() + "/save.png"), "Copy", this);
+    find_ = new QAction("Find...", this);
+    find_->setShortcut(QKeySequence::Find);
+    find_->setShortcutContext(Qt::WidgetWithChildrenShortcut);
     view_log_ = new QAction(QIcon(Gui::resource_path() + "/files.png"), "View log file", this);
     clear_ = new QAction("clear", this);
+    stop_ = new QAction(QIcon(Gui::resource_path() + "/stop.png"), "Stop", this);
+    stop_->setShortcut(QKeySequence(Qt::Key_Escape));
+    stop_->setShortcutContext(Qt::WindowShortcut);
     addAction(copy_text_);
+    addAction(find_);
     addAction(view_log_);
     addAction(clear_);
+    addAction(stop_);
     connect(copy_text_, SIGNAL(triggered()), this, SLOT(onCopy()));
+    connect(find_, SIGNAL(triggered()), this, SLOT(onFind()));
     connect(view_log_, SIGNAL(triggered()), this, SIGNAL(sigViewConsoleLog()));
     connect(clear_, SIGNAL(triggered()), this, SLOT(onClear()));
+    connect(stop_, SIGNAL(triggered()), this, SLOT(onStop()));
+    find_dialog_ = NULL;
     executor_ = new CommandExecutor(this);
     executor_->setObjectName("EXECUTOR_COMMANDLABEL");
     executor_->setVisible(false);
+    pending_posted_ = false;
+    flush_timer_.setSingleShot(true);
+    flush_timer_.setInterval(kFlushIntervalMs);
+    connect(&flush_timer_, SIGNAL(timeout()), this, SLOT(onFlushOutput()));
+    store_.set_indexed_types(CONSOLE_WARN, CONSOLE_ERROR);
+    select_anchor_ = -1;
+    select_end_ = -1;
+    updateScrollBars();
   }
   MainConsole::~MainConsole() {
     if (executor_) delete executor_;
   }
+  QString MainConsole::warning(int index) {
+    const std::vector<uint32_t>& lines = store_.messageLines(CONSOLE_WARN);
+    if (index < 0 || static_cast<size_t>(index) >= lines.size())
+      return QString();
+    return lineText(lines[static_cast<size_t>(index)]);
+  }
+  QString MainConsole::error(int index) {
+    const std::vector<uint32_t>& lines = store_.messageLines(CONSOLE_ERROR);
+    if (index < 0 || static_cast<size_t>(index) >= lines.size())
+      return QString();
+    return lineText(lines[static_cast<size_t>(index)]);
+  }
+  QString MainConsole::lineText(uint32_t index) {
+    std::string text;
+    int type = CONSOLE_INFO;
+    if (!store_.line(index, text, type))
+      return QString();
+    return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+  }
   void MainConsole::appendOutput(const QString& message, const int output_type) {
-    setCursorEnd();
-    switch (output_type) {
-      case CONSOLE_WARN:
-        setTextColor(warnColor);
-        warning_list_.append(message);
-        emit warningsCountChanged(warning_list_.count());
-        break;
-      case CONSOLE_ERROR:
-        setTextColor(errColor);
-        error_list_.append(message);
-        emit errorsCountChanged(error_list_.count());
-        break;
-      case CONSOLE_DEBUG:
-        setTextColor(debugColor);
-        break;
-      default:
-        setTextColor(fontColor);
+    MemoryTagScope scope(MemoryTracker::TAG_LOG);
+    bool at_end = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    int num_warnings = numWarnings();
+    int num_errors = numErrors();
+    QByteArray text = message.toUtf8();
+    store_.append(output_type, text.constData(), static_cast<size_t>(text.size()));
+    outputAppended(num_warnings, num_errors, at_end);
+  }
+  void MainConsole::postOutput(const int output_type, const char* text, const size_t length) {
+    bool post = false;
+    {
+      QMutexLocker locker(&pending_mutex_);
+      if (pending_.isEmpty() || pending_.back().type != output_type) {
+        OutputRun run;
+        run.type = output_type;
+        pending_.append(run);
+      }
+      pending_.back().text.append(text, static_cast<int>(length));
+      pending_.back().lengths.append(static_cast<int>(length));
+      post = !pending_posted_;
+      pending_posted_ = true;
+    }
+    if (post) {
+      QApplication::postEvent(this, new ConsoleEvent(CONSOLE_BATCH, QString()));
+    }
+  }
+  void MainConsole::onFlushOutput() {
+    QList<OutputRun> runs;
+    {
+      QMutexLocker locker(&pending_mutex_);
+      runs.swap(pending_);
+      pending_posted_ = false;
+    }
+    if (runs.isEmpty()) {
+      return;
+    }
+    MemoryTagScope scope(MemoryTracker::TAG_LOG);
+    bool at_end = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    int num_warnings = numWarnings();
+    int num_errors = numErrors();
+    for (int i = 0; i < runs.count(); i++) {
+      const OutputRun& run = runs[i];
+      const char* text = run.text.constData();
+      for (int m = 0; m < run.lengths.count(); m++) {
+        store_.append(run.type, text, static_cast<size_t>(run.lengths[m]));
+        text += run.lengths[m];
+      }
+    }
+    outputAppended(num_warnings, num_errors, at_end);
+  }
+  void MainConsole::outputAppended(int num_warnings, int num_errors, bool at_end) {
+    if (numWarnings() != num_warnings) {
+      emit warningsCountChanged(numWarnings());
+    }
+    if (numErrors() != num_errors) {
+      emit errorsCountChanged(numErrors());
+    }
+    updateScrollBars();
+    if (at_end) {
+      scrollToEnd();
+    }
+    viewport()->update();
+  }
+  void MainConsole::scrollToEnd() {
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+  }
+  void MainConsole::clear() {
+    store_.clear();
+    select_anchor_ = -1;
+    select_end_ = -1;
+    updateScrollBars();
+    viewport()->update();
+  }
+  int MainConsole::lineHeight() const {
+    return std::max(1, fontMetrics().lineSpacing());
+  }
+  int MainConsole::visibleLines() const {
+    return std::max(1, viewport()->height() / lineHeight());
+  }
+  int64_t MainConsole::lineAt(int y) const {
+    if (store_.numLines() == 0)
+      return -1;
+    int64_t line = static_cast<int64_t>(verticalScrollBar()->value()) + (y < 0 ? -1 : y / lineHeight());
+    return std::min(std::max(line, static_cast<int64_t>(0)), static_cast<int64_t>(store_.numLines()) - 1);
+  }
+  void MainConsole::updateScrollBars() {
+    int lines = static_cast<int>(std::min(store_.numLines(), static_cast<uint32_t>(INT_MAX)));
+    verticalScrollBar()->setRange(0, std::max(0, lines - visibleLines()));
+    verticalScrollBar()->setPageStep(visibleLines());
+    verticalScrollBar()->setSingleStep(1);
+    int char_width = fontMetrics().width(QLatin1Char('x'));
+    int chars = static_cast<int>(std::min(store_.max_line_length(), static_cast<size_t>(kMaxPaintedChars)));
+    horizontalScrollBar()->setRange(0, std::max(0, chars * char_width - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(char_width);
+  }
+  void MainConsole::paintEvent(QPaintEvent*) {
+    QPainter painter(viewport());
+    painter.setFont(font());
+    int height = lineHeight();
+    int ascent = fontMetrics().ascent();
+    int x = 2 - horizontalScrollBar()->value();
+    int64_t select_begin = std::min(select_anchor_, select_end_);
+    int64_t select_last = std::max(select_anchor_, select_end_);
+    uint32_t first = static_cast<uint32_t>(verticalScrollBar()->value());
+    std::string text;
+    for (int row = 0; row <= visibleLines(); row++) {
+      uint32_t index = first + static_cast<uint32_t>(row);
+      int type = CONSOLE_INFO;
+      if (!store_.line(index, text, type))
         break;
+      int y = row * height;
+      if (select_begin >= 0 && index >= select_begin && index <= select_last) {
+        painter.fillRect(0, y, viewport()->width(), height, palette().highlight());
+        painter.setPen(palette().highlightedText().color());
+      } else {
+        switch (type) {
+          case CONSOLE_WARN:
+            painter.setPen(warnColor);
+            break;
+          case CONSOLE_ERROR:
+            painter.setPen(errColor);
+            break;
+          case CONSOLE_DEBUG:
+            painter.setPen(debugColor);
+            break;
+          default:
+            painter.setPen(fontColor);
+            break;
+        }
+      }
+      int length = static_cast<int>(std::min(text.size(), static_cast<size_t>(kMaxPaintedChars)));
+      painter.drawText(x, y + ascent, QString::fromUtf8(text.data(), length));
+    }
+  }
+  void MainConsole::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    bool at_end = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+    updateScrollBars();
+    if (at_end) {
+      scrollToEnd();
+    }
+  }
+  void MainConsole::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) {
+      QAbstractScrollArea::mousePressEvent(event);
+      return;
+    }
+    int64_t line = lineAt(event->pos().y());
+    if ((event->modifiers() & Qt::ShiftModifier) && select_anchor_ >= 0) {
+      select_end_ = line;
+    } else {
+      select_anchor_ = line;
+      select_end_ = line;
     }
-    textCursor().insertText(message);
-    verticalScrollBar()->setValue(verticalScrollBar()->maximumHeight());
+    viewport()->update();
   }
-  void MainConsole::setCursorEnd() {
-    QTextCursor cursor = textCursor();
-    cursor.movePosition(QTextCursor::End, QTextCursor::MoveAnchor);
-    setTextCursor(cursor);
+  void MainConsole::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton) || select_anchor_ < 0)
+      return;
+    // dragging past the edges scrolls one line at a time
+    if (event->pos().y() < 0) {
+      verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepSub);
+    } else if (event->pos().y() >= viewport()->height()) {
+      verticalScrollBar()->triggerAction(QAbstractSlider::SliderSingleStepAdd);
+    }
+    select_end_ = lineAt(std::min(event->pos().y(), viewport()->height() - 1));
+    viewport()->update();
+  }
+  void MainConsole::keyPressEvent(QKeyEvent* event) {
+    if (event->matches(QKeySequence::Copy)) {
+      onCopy();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+      if (store_.numLines() > 0) {
+        select_anchor_ = 0;
+        select_end_ = static_cast<int64_t>(store_.numLines()) - 1;
+        viewport()->update();
+      }
+    } else if (event->matches(QKeySequence::MoveToEndOfDocument)) {
+      scrollToEnd();
+    } else if (event->matches(QKeySequence::MoveToStartOfDocument)) {
+      verticalScrollBar()->setValue(0);
+    } else {
+      QAbstractScrollArea::keyPressEvent(event);
+    }
   }
   void MainConsole::run(const QString& cmd) {
     if (cmd == "clear") {
       onClear();
       return;
     }
+    if (CommandContext::inited()) {
+      eda_warning("A command is still running.\n");
+      return;
+    }
     executor_->registerCommand(cmd);
-    CommandContext::init(NULL);
+    // progress and stop events go to the executor
+    CommandContext::init(executor_);
     executor_->runCommand();
   }
   void MainConsole::customEvent(QEvent* event) {
     if (event->type() == CONSOLE_EVENT) {
+      MemoryTagScope scope(MemoryTracker::TAG_LOG);
       ConsoleEvent* e = (ConsoleEvent*)event;
       QString msg = e->msg();
       if (e->msg_type() == CONSOLE_END) {
         //do nothing
+      } else if (e->msg_type() == CONSOLE_BATCH) {
+        if (!flush_timer_.isActive()) {
+          flush_timer_.start();
+        }
       } else {
         appendOutput(msg, e->msg_type());
       }
     }
   }
   void MainConsole::onCopy() {
-    if (textCursor().hasSelection()) {
-      QClipboard* clipboard = QApplication::clipboard();
-      clipboard->setText(textCursor().selectedText());
+    if (select_anchor_ < 0)
+      return;
+    uint32_t first = static_cast<uint32_t>(std::min(select_anchor_, select_end_));
+    uint32_t last = static_cast<uint32_t>(std::max(select_anchor_, select_end_));
+    QString text;
+    for (uint32_t i = first; i <= last; i++) {
+      text += lineText(i);
+      if (i != last)
+        text += '\n';
+    }
+    QClipboard* clipboard = QApplication::clipboard();
+    clipboard->setText(text);
+  }
+  void MainConsole::onFind() {
+    if (find_dialog_ == NULL) {
+      find_dialog_ = new ConsoleFindDialog(this);
+    }
+    // a single selected line is taken as the pattern
+    if (select_anchor_ >= 0 && select_anchor_ == select_end_) {
+      find_dialog_->set_pattern(lineText(static_cast<uint32_t>(select_anchor_)).trimmed());
     }
+    find_dialog_->show();
+    find_dialog_->raise();
+    find_dialog_->activateWindow();
+  }
+  void MainConsole::onStop() {
+    executor_->stop();
   }
   void MainConsole::onClear() {
     clear();
-    warning_list_.clear();
-    error_list_.clear();
     if (executor_) {
       executor_->setClear();
     }
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 #include <stdlib.h>
 #include <qsettings.h>
@@ -15,12 +15,16 @@
 #include "gui/main_app.h"
 #include "gui/main_window.h"
 #include "gui/gui_utility.h"
+#include "gui/command_context.h"
 #include "gui/console/command_line.h"
+#include "gui/console/command_worker.h"
 #include "gui/console/main_console.h"
 #include "tcl/commands.h"
+#include "tcl/completion.h"
 #include "utility/app.h"
 #include "utility/log.h"
 #include "utility/data_var.h"
+#include "utility/memory_tracker.h"
 
 namespace eda {
 
@@ -29,6 +33,8 @@ namespace eda {
 
   Tcl_Interp* Gui::interp_ = NULL;
 
+  CommandWorker* Gui::command_worker_ = NULL;
+
   bool Gui::gui_mode_ = false;
 
   QSettings* Gui::setting_ = NULL;
@@ -42,6 +48,8 @@ namespace eda {
     if (main_window() != NULL) return;
     if (argc < 1) return;
 
+    // everything the GUI thread allocates outside of commands and the console
+    MemoryTracker::set_tag(MemoryTracker::TAG_GUI);
     Tcl_FindExecutable(argv[0]);
 
     initGui(argc, argv);
@@ -106,11 +114,28 @@ namespace eda {
     eda_info("FPGA GUI is running.\n");
 
     registerAllCmds(interp);
+    gCompletion.indexInterp(interp);
+
+    // Commands of the GUI are evaluated on the worker so the event loop never
+    // waits for them. The Tcl library is built without threads, so the
+    // interpreter is not tied to this thread, it only must not be used by
+    // two threads at once.
+    command_worker_ = new CommandWorker();
+    command_worker_->start();
 
     main_window_ = new MainWindow();
     main_window_->show();
 
-    if (main_app_->exec()) {
+    int exit_code = main_app_->exec();
+    if (command_worker_->busy()) {
+      CommandContext::setThreadStopped(true);
+    }
+    command_worker_->finish();
+    delete command_worker_;
+    command_worker_ = NULL;
+    CommandContext::setThreadStopped(false);
+
+    if (exit_code) {
       EDAReadLineLoop(interp);
     } else {
       exit(0);
@@ -122,13 +147,15 @@ namespace eda {
 
 
   int Gui::executeCmd(QString cmd, const bool print_result) {
-    if (interp_ == NULL) {
-      eda_error("No Tcl Interpret specified.\n");
-      return -1;
+    if (!prepareCmd(cmd)) {
+      return TCL_OK;
     }
+    return evalCmd(cmd, print_result);
+  }
+  bool Gui::prepareCmd(const QString& cmd) {
     if (cmd == "exit") {
       Console::done();
-      return TCL_OK;
+      return false;
     }
     QStringList tokens = cmd.split(" ", QString::SkipEmptyParts);
     if (tokens.size()) {
@@ -137,22 +164,30 @@ namespace eda {
         head.compare("chdir", Qt::CaseInsensitive) == 0) {
         eda_info("Changing current directory is not allowed.\n");
         Console::done();
-        return TCL_OK;
+        return false;
       }
     }
-    if (Gui::main_window()->main_console()) {
+    if (Gui::main_window() && Gui::main_window()->main_console()) {
       Gui::main_window()->command_line()->append(cmd);
     }
-    const char* c_string_cmd = cmd.toLatin1().data();
+    return true;
+  }
+  int Gui::evalCmd(const QString& cmd, const bool print_result) {
+    if (interp_ == NULL) {
+      eda_error("No Tcl Interpret specified.\n");
+      return -1;
+    }
+    QByteArray latin_cmd = cmd.toLatin1();
+    const char* c_string_cmd = latin_cmd.constData();
     try {
       // send out notification before executing the command.
       if (Gui::main_app() && Gui::main_window()) {
-        Gui::main_app()->postEvent(Gui::main_window(), new ExecutedCommandEvent(c_string_cmd));
+        Gui::main_app()->postEvent(Gui::main_window(), new ExecutedCommandEvent(cmd));
       }
       int ret = Tcl_Eval(interp_, c_string_cmd);
       // send out notification after executing the command.
       if (Gui::main_app() && Gui::main_window()) {
-        Gui::main_app()->postEvent(Gui::main_window(), new ExecutedCommandEvent(c_string_cmd, CMD_FINISHED));
+        Gui::main_app()->postEvent(Gui::main_window(), new ExecutedCommandEvent(cmd, CMD_FINISHED));
       }
       const char* result = Tcl_GetStringResult(interp_);
       if (print_result && strlen(result) > 0) {
@@ -20,9 +20,16 @@ HEADERS += $$top_srcdir/include/gui/gui.h \
            $$top_srcdir/include/gui/project/source_file_selector.h \
            $$top_srcdir/include/gui/console/console.h \
            $$top_srcdir/include/gui/console/main_console.h \
+           $$top_srcdir/include/gui/console/console_line_store.h \
+           $$top_srcdir/include/gui/console/console_find_dialog.h \
            $$top_srcdir/include/gui/console/command_executor.h \
+           $$top_srcdir/include/gui/console/command_worker.h \
            $$top_srcdir/include/gui/console/command_line.h \
            $$top_srcdir/include/gui/layout/layout_window.h \
+           $$top_srcdir/include/gui/layout/fabric_scene.h \
+           $$top_srcdir/include/gui/layout/fabric_overlay.h \
+           $$top_srcdir/include/gui/layout/fabric_tile_renderer.h \
+           $$top_srcdir/include/gui/layout/fabric_view.h \
 
 SOURCES += gui.cpp \
            command_context.cpp \
@@ -37,6 +44,14 @@ SOURCES += gui.cpp \
            project/source_file_selector.cpp \
            console/console.cpp \
            console/main_console.cpp \
+           console/console_line_store.cpp \
+           console/console_find_dialog.cpp \
            console/command_executor.cpp \
+           console/command_worker.cpp \
            console/command_line.cpp \
-           layout/layout_window.cpp \
\ No newline at end of file
+           layout/layout_window.cpp \
+           layout/layout_commands.cpp \
+           layout/fabric_scene.cpp \
+           layout/fabric_overlay.cpp \
+           layout/fabric_tile_renderer.cpp \
+           layout/fabric_view.cpp \
\ No newline at end of file
@@ -0,0 +1,199 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "gui/layout/fabric_overlay.h"
+
+namespace eda {
+
+  namespace {
+
+    // IDs 0 .. count - 1 sorted by name(id)
+    template <typename NameFunction>
+    void sortByName(uint32_t count, NameFunction name, std::vector<uint32_t>& ids) {
+      ids.resize(count);
+      for (uint32_t i = 0; i < count; i++) {
+        ids[i] = i;
+      }
+      std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+        return strcmp(name(a), name(b)) < 0;
+      });
+    }
+
+    template <typename NameFunction>
+    uint32_t findByName(const std::vector<uint32_t>& ids, NameFunction name, const std::string& value) {
+      std::vector<uint32_t>::const_iterator iter = std::lower_bound(ids.begin(), ids.end(), value,
+        [&](uint32_t id, const std::string& text) { return strcmp(name(id), text.c_str()) < 0; });
+      if (iter == ids.end() || value != name(*iter))
+        return FabricScene::kInvalidId;
+      return *iter;
+    }
+
+  }
+
+  FabricOverlay::FabricOverlay() {
+  }
+
+  std::string FabricOverlay::key(Kind kind, const std::string& name) {
+    return std::string(1, static_cast<char>('0' + kind)) + name;
+  }
+
+  void FabricOverlay::setScene(const std::shared_ptr<const FabricScene>& scene) {
+    scene_ = scene;
+    nets_by_name_.clear();
+    cells_by_name_.clear();
+    index_.clear();
+    free_.clear();
+    for (uint32_t i = 0; i < items_.size(); i++) {
+      Item& item = items_[i];
+      if (item.used && !resolve(item)) {
+        by_key_.erase(key(item.kind, item.name));
+        item.used = false;
+      }
+      if (item.used) {
+        index_.add(i, item.bounds);
+      } else {
+        free_.push_back(i);
+      }
+    }
+    index_.build();
+  }
+
+  bool FabricOverlay::highlight(Kind kind, const std::string& name, uint32_t color, PackedRTree::Box& dirty) {
+    std::unordered_map<std::string, uint32_t>::iterator iter = by_key_.find(key(kind, name));
+    if (iter != by_key_.end()) {
+      items_[iter->second].color = color;
+      dirty = items_[iter->second].bounds;
+      return true;
+    }
+    Item item;
+    item.kind = kind;
+    item.name = name;
+    item.color = color;
+    item.used = true;
+    if (!resolve(item))
+      return false;
+    uint32_t slot;
+    if (free_.empty()) {
+      slot = static_cast<uint32_t>(items_.size());
+      items_.push_back(item);
+    } else {
+      slot = free_.back();
+      free_.pop_back();
+      items_[slot] = item;
+    }
+    by_key_.insert(std::make_pair(key(kind, name), slot));
+    index_.insert(slot, item.bounds);
+    dirty = item.bounds;
+    return true;
+  }
+
+  bool FabricOverlay::unhighlight(Kind kind, const std::string& name, PackedRTree::Box& dirty) {
+    std::unordered_map<std::string, uint32_t>::iterator iter = by_key_.find(key(kind, name));
+    if (iter == by_key_.end())
+      return false;
+    uint32_t slot = iter->second;
+    by_key_.erase(iter);
+    index_.remove(slot);
+    items_[slot].used = false;
+    items_[slot].name.clear();
+    free_.push_back(slot);
+    dirty = items_[slot].bounds;
+    return true;
+  }
+
+  void FabricOverlay::clear() {
+    items_.clear();
+    free_.clear();
+    by_key_.clear();
+    index_.clear();
+  }
+
+  void FabricOverlay::find(const PackedRTree::Box& box, std::vector<uint32_t>& items) const {
+    index_.search(box, items);
+    std::sort(items.begin(), items.end());
+  }
+
+  bool FabricOverlay::resolve(Item& item) {
+    if (!scene_)
+      return false;
+    const FabricScene& scene = *scene_;
+    FabricScene::Hit hit;
+    item.segment_begin = 0;
+    item.segment_end = 0;
+    switch (item.kind) {
+      case kNet: {
+        uint32_t net = findNet(item.name);
+        if (net == FabricScene::kInvalidId)
+          return false;
+        scene.netSegments(net, item.segment_begin, item.segment_end);
+        if (item.segment_begin == item.segment_end)
+          return false;
+        hit.segment = item.segment_begin;
+        item.bounds = scene.bounds(hit);
+        for (uint32_t i = item.segment_begin + 1; i < item.segment_end; i++) {
+          hit.segment = i;
+          item.bounds.expand(scene.bounds(hit));
+        }
+        item.box = item.bounds;
+        return true;
+      }
+      case kCell: {
+        uint32_t cell = findCell(item.name);
+        if (cell == FabricScene::kInvalidId)
+          return false;
+        hit.site = scene.cellSite(cell);
+        item.box = scene.bounds(hit);
+        break;
+      }
+      case kTile: {
+        uint32_t tile = scene.findTile(item.name);
+        if (tile == FabricScene::kInvalidId)
+          return false;
+        hit.tile = tile;
+        item.box = scene.bounds(hit);
+        break;
+      }
+      case kRegion: {
+        int x0, y0, x1, y1;
+        if (sscanf(item.name.c_str(), "%d %d %d %d", &x0, &y0, &x1, &y1) != 4)
+          return false;
+        int col0 = std::max(std::min(x0, x1), 0);
+        int col1 = std::min(std::max(x0, x1), scene.cols() - 1);
+        // Y counts from the bottom like in the tile names
+        int row0 = std::max(scene.rows() - 1 - std::max(y0, y1), 0);
+        int row1 = std::min(scene.rows() - 1 - std::min(y0, y1), scene.rows() - 1);
+        if (col0 > col1 || row0 > row1)
+          return false;
+        item.box = PackedRTree::Box(static_cast<float>(col0), static_cast<float>(row0), static_cast<float>(col1 + 1), static_cast<float>(row1 + 1));
+        break;
+      }
+    }
+    item.bounds = item.box;
+    return true;
+  }
+
+  uint32_t FabricOverlay::findNet(const std::string& name) {
+    const FabricScene& scene = *scene_;
+    auto net_name = [&](uint32_t net) { return scene.netName(net); };
+    if (nets_by_name_.size() != scene.numNets())
+      sortByName(scene.numNets(), net_name, nets_by_name_);
+    return findByName(nets_by_name_, net_name, name);
+  }
+
+  uint32_t FabricOverlay::findCell(const std::string& name) {
+    const FabricScene& scene = *scene_;
+    auto cell_name = [&](uint32_t cell) { return scene.cellName(cell); };
+    if (cells_by_name_.size() != scene.numCells())
+      sortByName(scene.numCells(), cell_name, cells_by_name_);
+    return findByName(cells_by_name_, cell_name, name);
+  }
+
+}
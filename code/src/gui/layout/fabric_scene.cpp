@@ -0,0 +1,634 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "gui/layout/fabric_scene.h"
+#include "design/design.h"
+#include "utility/hash.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  namespace {
+
+    const uint32_t kUsedSiteColor = 0xffff9c2a;
+    const uint32_t kRoutingColor = 0xff3cd25a;
+    const uint32_t kPipColor = 0xffc8ffd2;
+    // cold to hot
+    const uint32_t kHeatColors[4] = { 0xff2850ff, 0xff3cd25a, 0xffffdc32, 0xffff3c28 };
+
+    uint32_t blend(uint32_t a, uint32_t b, uint32_t alpha) {
+      uint32_t r = (((a >> 16) & 0xff) * (255 - alpha) + ((b >> 16) & 0xff) * alpha) / 255;
+      uint32_t g = (((a >> 8) & 0xff) * (255 - alpha) + ((b >> 8) & 0xff) * alpha) / 255;
+      uint32_t bl = ((a & 0xff) * (255 - alpha) + (b & 0xff) * alpha) / 255;
+      return 0xff000000 | (r << 16) | (g << 8) | bl;
+    }
+
+    // muted color with the hue taken from the hash of the name
+    uint32_t typeColor(const char* name) {
+      uint64_t hash = xxHash64(name, strlen(name));
+      int hue = static_cast<int>(hash % 360);
+      const int value = 150;
+      const int low = 70;
+      int rise = low + (value - low) * (hue % 60) / 60;
+      int fall = value - (value - low) * (hue % 60) / 60;
+      int r, g, b;
+      switch (hue / 60) {
+        case 0: r = value; g = rise; b = low; break;
+        case 1: r = fall; g = value; b = low; break;
+        case 2: r = low; g = value; b = rise; break;
+        case 3: r = low; g = fall; b = value; break;
+        case 4: r = rise; g = low; b = value; break;
+        default: r = value; g = low; b = fall; break;
+      }
+      return 0xff000000 | (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | static_cast<uint32_t>(b);
+    }
+
+    void fillRect(uint32_t* pixels, int stride, int x, int y, int w, int h, uint32_t color) {
+      int x0 = std::max(x, 0);
+      int y0 = std::max(y, 0);
+      int x1 = std::min(x + w, static_cast<int>(FabricScene::kTileSize));
+      int y1 = std::min(y + h, static_cast<int>(FabricScene::kTileSize));
+      for (int py = y0; py < y1; py++) {
+        uint32_t* line = pixels + static_cast<ptrdiff_t>(py) * stride;
+        std::fill(line + x0, line + (x1 > x0 ? x1 : x0), color);
+      }
+    }
+
+    // Liang-Barsky clip against [0, size] followed by Bresenham
+    void drawLine(uint32_t* pixels, int stride, double x0, double y0, double x1, double y1, uint32_t color) {
+      const double size = static_cast<double>(FabricScene::kTileSize) - 0.5;
+      double t0 = 0.0;
+      double t1 = 1.0;
+      double dx = x1 - x0;
+      double dy = y1 - y0;
+      const double p[4] = { -dx, dx, -dy, dy };
+      const double q[4] = { x0, size - x0, y0, size - y0 };
+      for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0) {
+          if (q[i] < 0.0)
+            return;
+          continue;
+        }
+        double t = q[i] / p[i];
+        if (p[i] < 0.0) {
+          if (t > t1) return;
+          if (t > t0) t0 = t;
+        } else {
+          if (t < t0) return;
+          if (t < t1) t1 = t;
+        }
+      }
+      int ax = static_cast<int>(x0 + t0 * dx);
+      int ay = static_cast<int>(y0 + t0 * dy);
+      int bx = static_cast<int>(x0 + t1 * dx);
+      int by = static_cast<int>(y0 + t1 * dy);
+      int sx = ax < bx ? 1 : -1;
+      int sy = ay < by ? 1 : -1;
+      int ex = std::abs(bx - ax);
+      int ey = -std::abs(by - ay);
+      int err = ex + ey;
+      while (true) {
+        if (ax >= 0 && ay >= 0 && ax < FabricScene::kTileSize && ay < FabricScene::kTileSize)
+          pixels[static_cast<ptrdiff_t>(ay) * stride + ax] = color;
+        if (ax == bx && ay == by)
+          break;
+        int e2 = 2 * err;
+        if (e2 >= ey) { err += ey; ax += sx; }
+        if (e2 <= ex) { err += ex; ay += sy; }
+      }
+    }
+
+    // t in [0, 1]
+    uint32_t heatColor(double t) {
+      double position = t * 3;
+      int i = std::min(static_cast<int>(position), 2);
+      return blend(kHeatColors[i], kHeatColors[i + 1], static_cast<uint32_t>((position - i) * 255));
+    }
+
+    // Douglas-Peucker over the tile centers of a route, marks the tiles that
+    // stay when every dropped tile may be up to tolerance off the polyline
+    void simplify(const std::vector<uint32_t>& route, uint32_t cols, double tolerance, std::vector<uint8_t>& keep,
+      std::vector<std::pair<size_t, size_t> >& stack) {
+      keep.assign(route.size(), 0);
+      keep.front() = 1;
+      keep.back() = 1;
+      stack.assign(1, std::make_pair(static_cast<size_t>(0), route.size() - 1));
+      while (!stack.empty()) {
+        size_t first = stack.back().first;
+        size_t last = stack.back().second;
+        stack.pop_back();
+        if (last - first < 2)
+          continue;
+        double ax = route[first] % cols;
+        double ay = route[first] / cols;
+        double dx = route[last] % cols - ax;
+        double dy = route[last] / cols - ay;
+        double length = dx * dx + dy * dy;
+        double best = tolerance * tolerance;
+        size_t farthest = first;
+        for (size_t i = first + 1; i < last; i++) {
+          double px = route[i] % cols - ax;
+          double py = route[i] / cols - ay;
+          // routes may turn back, so the distance to the segment rather
+          // than to the line through it
+          double along = length > 0 ? std::max(0.0, std::min(1.0, (px * dx + py * dy) / length)) : 0;
+          double ex = px - along * dx;
+          double ey = py - along * dy;
+          if (ex * ex + ey * ey > best) {
+            best = ex * ex + ey * ey;
+            farthest = i;
+          }
+        }
+        if (farthest != first) {
+          keep[farthest] = 1;
+          stack.push_back(std::make_pair(first, farthest));
+          stack.push_back(std::make_pair(farthest, last));
+        }
+      }
+    }
+
+    FabricScene::Segment makeSegment(uint32_t from, uint32_t to, uint32_t cols, uint32_t net) {
+      FabricScene::Segment segment;
+      segment.col0 = static_cast<uint16_t>(from % cols);
+      segment.row0 = static_cast<uint16_t>(from / cols);
+      segment.col1 = static_cast<uint16_t>(to % cols);
+      segment.row1 = static_cast<uint16_t>(to / cols);
+      segment.net = net;
+      return segment;
+    }
+
+    PackedRTree::Box segmentBox(const FabricScene::Segment& segment) {
+      return PackedRTree::Box(std::min(segment.col0, segment.col1) + 0.5f, std::min(segment.row0, segment.row1) + 0.5f,
+        std::max(segment.col0, segment.col1) + 0.5f, std::max(segment.row0, segment.row1) + 0.5f);
+    }
+
+    // the same for both directions of a segment
+    uint64_t segmentKey(uint32_t from, uint32_t to) {
+      return from < to ? (static_cast<uint64_t>(from) << 32) | to : (static_cast<uint64_t>(to) << 32) | from;
+    }
+
+    // orders segments by net for std::equal_range()
+    class SegmentNet {
+    public:
+      bool operator()(const FabricScene::Segment& segment, uint32_t net) const { return segment.net < net; }
+      bool operator()(uint32_t net, const FabricScene::Segment& segment) const { return net < segment.net; }
+    };
+
+    // "<type>_X<col>Y<y>" with Y counted from the bottom, see
+    // DeviceFabric::tileName()
+    uint32_t parseTile(const char* name, int rows, int cols) {
+      const char* pos = strrchr(name, '_');
+      int x = -1;
+      int y = -1;
+      if (pos == NULL || sscanf(pos, "_X%dY%d", &x, &y) != 2)
+        return DeviceFabric::kInvalidId;
+      if (x < 0 || x >= cols || y < 0 || y >= rows)
+        return DeviceFabric::kInvalidId;
+      return static_cast<uint32_t>(rows - 1 - y) * static_cast<uint32_t>(cols) + static_cast<uint32_t>(x);
+    }
+
+  }
+
+  const int FabricScene::kTileSize;
+  const int FabricScene::kMaxPixelsPerTile;
+  const int FabricScene::kSitePixels;
+  const int FabricScene::kLinePixels;
+  const int FabricScene::kDetailPixels;
+  const int FabricScene::kSimplifyPixels;
+  const uint32_t FabricScene::kBackground;
+  const uint32_t FabricScene::kInvalidId;
+
+  FabricScene::FabricScene(const DeviceFabric& fabric, const Design* design) : fabric_(fabric) {
+    num_used_sites_ = 0;
+    max_usage_ = 0;
+    type_colors_.resize(fabric_.numTileTypes());
+    for (uint32_t type = 0; type < fabric_.numTileTypes(); type++) {
+      type_colors_[type] = type == DeviceFabric::kEmptyTileType ? kBackground : typeColor(fabric_.tileTypeName(static_cast<DeviceFabric::TypeId>(type)));
+    }
+    site_cells_.assign(fabric_.numSites(), kInvalidId);
+    if (design != NULL) {
+      addDesign(*design);
+    }
+
+    num_levels_ = 1;
+    while (levelCols(num_levels_ - 1) > 1 || levelRows(num_levels_ - 1) > 1) {
+      num_levels_++;
+    }
+  }
+
+  int FabricScene::levelCols(int level) const {
+    double pixels = static_cast<double>(cols()) * pixelsPerTile(level);
+    int count = static_cast<int>((pixels + kTileSize - 1) / kTileSize);
+    return count > 0 ? count : 1;
+  }
+
+  int FabricScene::levelRows(int level) const {
+    double pixels = static_cast<double>(rows()) * pixelsPerTile(level);
+    int count = static_cast<int>((pixels + kTileSize - 1) / kTileSize);
+    return count > 0 ? count : 1;
+  }
+
+  uint32_t FabricScene::numLevelSegments(int level) const {
+    int ppt = kMaxPixelsPerTile >> level;
+    if (ppt < kLinePixels)
+      return 0;
+    if (ppt >= kDetailPixels)
+      return numSegments();
+    return level < static_cast<int>(simplified_.size()) ? static_cast<uint32_t>(simplified_[level].segments.size()) : 0;
+  }
+
+  const char* FabricScene::siteCell(uint32_t site) const {
+    return site_cells_[site] == kInvalidId ? NULL : cell_names_.name(site_cells_[site]);
+  }
+
+  uint32_t FabricScene::findTile(const std::string& name) const {
+    return parseTile(name.c_str(), rows(), cols());
+  }
+
+  // the segments are added net by net, so they are sorted by net
+  void FabricScene::netSegments(uint32_t net, uint32_t& begin, uint32_t& end) const {
+    auto range = std::equal_range(segments_.begin(), segments_.end(), net, SegmentNet());
+    begin = static_cast<uint32_t>(range.first - segments_.begin());
+    end = static_cast<uint32_t>(range.second - segments_.begin());
+  }
+
+  void FabricScene::addDesign(const Design& design) {
+    // tile names repeat for every PIP, parse each name once into a table
+    // by string ID
+    const uint32_t kUnparsed = DeviceFabric::kInvalidId - 1;
+    std::vector<uint32_t> tiles(design.strings().size(), kUnparsed);
+    auto findTile = [&](Design::StringId name) -> uint32_t {
+      if (name == StringPool::kInvalidId)
+        return DeviceFabric::kInvalidId;
+      if (tiles[name] == kUnparsed)
+        tiles[name] = parseTile(design.str(name), rows(), cols());
+      return tiles[name];
+    };
+
+    for (uint32_t i = 0; i < design.numInstances(); i++) {
+      const Design::Instance& instance = design.instance(i);
+      uint32_t tile = findTile(instance.tile);
+      if (tile == DeviceFabric::kInvalidId || instance.site == StringPool::kInvalidId)
+        continue;
+      const char* site_name = design.str(instance.site);
+      for (uint32_t s = fabric_.tileSiteBegin(tile); s < fabric_.tileSiteEnd(tile); s++) {
+        if (site_cells_[s] == kInvalidId && fabric_.siteName(s) == site_name) {
+          site_cells_[s] = cell_names_.add(design.str(instance.name));
+          cell_sites_.push_back(s);
+          num_used_sites_++;
+          break;
+        }
+      }
+    }
+
+    tile_usage_.assign(fabric_.numTiles(), 0);
+    simplified_.clear();
+    for (int level = 0; (kMaxPixelsPerTile >> level) >= kLinePixels; level++) {
+      simplified_.push_back(RouteLayer());
+    }
+    // segmentKey() of the simplified segments per level
+    std::vector<std::vector<uint64_t> > simplified(simplified_.size());
+    // the last net counted in each tile
+    std::vector<uint32_t> tile_net(fabric_.numTiles(), kInvalidId);
+    const uint32_t cols = static_cast<uint32_t>(fabric_.cols());
+    std::vector<uint32_t> route;
+    std::vector<uint8_t> keep;
+    std::vector<std::pair<size_t, size_t> > stack;
+    for (uint32_t n = 0; n < design.numNets(); n++) {
+      route.clear();
+      for (uint32_t p = design.netPipBegin(n); p < design.netPipEnd(n); p++) {
+        uint32_t tile = findTile(design.pip(p).tile);
+        if (tile == DeviceFabric::kInvalidId)
+          continue;
+        if (tile_net[tile] != n) {
+          tile_net[tile] = n;
+          if (tile_usage_[tile] < 0xffff)
+            tile_usage_[tile]++;
+          if (tile_usage_[tile] > max_usage_)
+            max_usage_ = tile_usage_[tile];
+        }
+        if (route.empty() || route.back() != tile)
+          route.push_back(tile);
+      }
+      if (route.size() < 2)
+        continue;
+      uint32_t net = net_names_.add(design.str(design.net(n).name));
+      for (size_t i = 1; i < route.size(); i++) {
+        Segment segment = makeSegment(route[i - 1], route[i], cols, net);
+        segment_index_.add(static_cast<uint32_t>(segments_.size()), segmentBox(segment));
+        segments_.push_back(segment);
+      }
+      for (size_t level = 0; level < simplified.size(); level++) {
+        int ppt = kMaxPixelsPerTile >> level;
+        if (ppt >= kDetailPixels)
+          continue;
+        simplify(route, cols, static_cast<double>(kSimplifyPixels) / ppt, keep, stack);
+        size_t previous = 0;
+        for (size_t i = 1; i < route.size(); i++) {
+          if (keep[i] == 0)
+            continue;
+          simplified[level].push_back(segmentKey(route[previous], route[i]));
+          previous = i;
+        }
+      }
+    }
+
+    // the trees are independent, the full routing is item 0
+    parallelFor(simplified.size() + 1, [&](size_t begin, size_t end) {
+      for (size_t item = begin; item < end; item++) {
+        if (item == 0) {
+          segment_index_.build();
+          continue;
+        }
+        // segments shared by several nets are drawn once, so they belong to
+        // no single net
+        std::vector<uint64_t>& keys = simplified[item - 1];
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        RouteLayer& layer = simplified_[item - 1];
+        layer.segments.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+          layer.segments.push_back(makeSegment(static_cast<uint32_t>(keys[i] >> 32), static_cast<uint32_t>(keys[i]), cols, kInvalidId));
+          layer.index.add(static_cast<uint32_t>(i), segmentBox(layer.segments.back()));
+        }
+        std::vector<uint64_t>().swap(keys);
+        layer.index.build();
+      }
+    });
+    if (max_usage_ == 0) {
+      tile_usage_.clear();
+    }
+  }
+
+  uint32_t FabricScene::tileColor(uint32_t tile) const {
+    uint32_t color = type_colors_[fabric_.tileType(tile)];
+    for (uint32_t s = fabric_.tileSiteBegin(tile); s < fabric_.tileSiteEnd(tile); s++) {
+      if (site_cells_[s] != kInvalidId) {
+        color = blend(color, kUsedSiteColor, 160);
+        break;
+      }
+    }
+    return color;
+  }
+
+  // square root so a few congested tiles do not wash out the rest
+  uint32_t FabricScene::usageColor(uint32_t color, uint32_t tile) const {
+    if (tile_usage_[tile] == 0)
+      return color;
+    double t = sqrt(static_cast<double>(tile_usage_[tile]) / max_usage_);
+    return blend(color, heatColor(t), static_cast<uint32_t>(64 + 160 * t));
+  }
+
+  // the site as drawn on level 0, see renderTiles()
+  PackedRTree::Box FabricScene::siteBounds(uint32_t site) const {
+    uint32_t tile = fabric_.siteTile(site);
+    uint32_t first = fabric_.tileSiteBegin(tile);
+    int num_sites = static_cast<int>(fabric_.tileSiteEnd(tile) - first);
+    const int ppt = kMaxPixelsPerTile;
+    int inner = ppt - 1 - 2 * (ppt / 8);
+    int height = inner / num_sites;
+    float unit = 1.0f / static_cast<float>(ppt);
+    float left = static_cast<float>(fabric_.tileCol(tile)) + static_cast<float>(ppt / 8) * unit;
+    float top = static_cast<float>(fabric_.tileRow(tile)) + static_cast<float>(ppt / 8) * unit;
+    if (height < 2) {
+      return PackedRTree::Box(left, top, left + static_cast<float>(inner) * unit, top + static_cast<float>(inner) * unit);
+    }
+    top += static_cast<float>(static_cast<int>(site - first) * height) * unit;
+    return PackedRTree::Box(left, top, left + static_cast<float>(inner) * unit, top + static_cast<float>(height - 1) * unit);
+  }
+
+  FabricScene::Hit FabricScene::pick(double x, double y, double tolerance) const {
+    Hit hit;
+    if (x < 0 || y < 0 || x >= cols() || y >= rows())
+      return hit;
+    int col = static_cast<int>(x);
+    int row = static_cast<int>(y);
+    uint32_t tile = fabric_.tileAt(row, col);
+    if (fabric_.tileType(tile) != DeviceFabric::kEmptyTileType)
+      hit.tile = tile;
+    float fx = static_cast<float>(x);
+    float fy = static_cast<float>(y);
+    for (uint32_t s = fabric_.tileSiteBegin(tile); s < fabric_.tileSiteEnd(tile); s++) {
+      PackedRTree::Box box = siteBounds(s);
+      if (fx < box.x0 || fx >= box.x1 || fy < box.y0 || fy >= box.y1)
+        continue;
+      // sites too small to be drawn apart share one block
+      uint32_t num_sites = fabric_.tileSiteEnd(tile) - fabric_.tileSiteBegin(tile);
+      if (num_sites > 1 && siteBounds(s + 1 < fabric_.tileSiteEnd(tile) ? s + 1 : s - 1).y0 == box.y0) {
+        uint32_t index = static_cast<uint32_t>((fy - box.y0) / (box.y1 - box.y0) * static_cast<float>(num_sites));
+        s = fabric_.tileSiteBegin(tile) + std::min(index, num_sites - 1);
+      }
+      hit.site = s;
+      // BELs side by side across the site
+      uint32_t num_bels = fabric_.siteBelEnd(s) - fabric_.siteBelBegin(s);
+      if (num_bels > 0) {
+        uint32_t index = static_cast<uint32_t>((fx - box.x0) / (box.x1 - box.x0) * static_cast<float>(num_bels));
+        hit.bel = fabric_.siteBelBegin(s) + std::min(index, num_bels - 1);
+      }
+      break;
+    }
+
+    std::vector<uint32_t> candidates;
+    float t = static_cast<float>(tolerance);
+    findSegments(PackedRTree::Box(fx - t, fy - t, fx + t, fy + t), candidates);
+    double best = tolerance * tolerance;
+    for (size_t i = 0; i < candidates.size(); i++) {
+      const Segment& segment = segments_[candidates[i]];
+      double ax = segment.col0 + 0.5;
+      double ay = segment.row0 + 0.5;
+      double dx = segment.col1 - segment.col0;
+      double dy = segment.row1 - segment.row0;
+      double length = dx * dx + dy * dy;
+      double along = length > 0 ? ((x - ax) * dx + (y - ay) * dy) / length : 0;
+      along = std::max(0.0, std::min(1.0, along));
+      double ex = ax + along * dx - x;
+      double ey = ay + along * dy - y;
+      double distance = ex * ex + ey * ey;
+      if (distance <= best) {
+        best = distance;
+        hit.segment = candidates[i];
+      }
+    }
+    return hit;
+  }
+
+  PackedRTree::Box FabricScene::bounds(const Hit& hit) const {
+    if (hit.site != kInvalidId) {
+      PackedRTree::Box box = siteBounds(hit.site);
+      if (hit.bel == kInvalidId)
+        return box;
+      float width = (box.x1 - box.x0) / static_cast<float>(fabric_.siteBelEnd(hit.site) - fabric_.siteBelBegin(hit.site));
+      float left = box.x0 + width * static_cast<float>(hit.bel - fabric_.siteBelBegin(hit.site));
+      return PackedRTree::Box(left, box.y0, left + width, box.y1);
+    }
+    if (hit.segment != kInvalidId) {
+      return segmentBox(segments_[hit.segment]);
+    }
+    if (hit.tile != kInvalidId) {
+      float x = static_cast<float>(fabric_.tileCol(hit.tile));
+      float y = static_cast<float>(fabric_.tileRow(hit.tile));
+      return PackedRTree::Box(x, y, x + 1, y + 1);
+    }
+    return PackedRTree::Box();
+  }
+
+  std::string FabricScene::describe(const Hit& hit) const {
+    std::string text;
+    if (hit.tile != kInvalidId)
+      text = fabric_.tileName(hit.tile);
+    if (hit.site != kInvalidId)
+      text += " / " + fabric_.siteName(hit.site);
+    if (hit.bel != kInvalidId)
+      text += std::string(" / ") + fabric_.siteBelName(hit.site, hit.bel);
+    if (hit.site != kInvalidId && siteCell(hit.site) != NULL)
+      text += std::string(", cell ") + siteCell(hit.site);
+    if (hit.segment != kInvalidId)
+      text += std::string(text.empty() ? "" : ", ") + "net " + netName(segments_[hit.segment].net);
+    return text;
+  }
+
+  void FabricScene::render(int level, int x, int y, uint32_t* pixels, int stride) const {
+    for (int py = 0; py < kTileSize; py++) {
+      std::fill(pixels + static_cast<ptrdiff_t>(py) * stride, pixels + static_cast<ptrdiff_t>(py) * stride + kTileSize, kBackground);
+    }
+    int ppt = kMaxPixelsPerTile >> level;
+    if (ppt >= 1) {
+      int span = kTileSize / ppt;
+      renderTiles(ppt, x * span, y * span, pixels, stride);
+    } else {
+      int step = (1 << level) / kMaxPixelsPerTile;
+      int span = kTileSize * step;
+      renderAveraged(step, x * span, y * span, pixels, stride);
+    }
+    if (ppt >= kDetailPixels) {
+      int span = kTileSize / ppt;
+      renderSegments(segments_, segment_index_, static_cast<double>(ppt), static_cast<double>(x * span), static_cast<double>(y * span), pixels, stride);
+      renderPips(ppt, x * span, y * span, pixels, stride);
+    } else if (ppt >= kLinePixels && level < static_cast<int>(simplified_.size())) {
+      int span = kTileSize / ppt;
+      const RouteLayer& layer = simplified_[level];
+      renderSegments(layer.segments, layer.index, static_cast<double>(ppt), static_cast<double>(x * span), static_cast<double>(y * span), pixels, stride);
+    }
+  }
+
+  void FabricScene::renderTiles(int ppt, int col0, int row0, uint32_t* pixels, int stride) const {
+    int span = kTileSize / ppt;
+    int col1 = std::min(col0 + span, cols());
+    int row1 = std::min(row0 + span, rows());
+    int gap = ppt >= 8 ? 1 : 0;
+    bool draw_sites = ppt >= kSitePixels;
+    bool draw_usage = ppt < kLinePixels && !tile_usage_.empty();
+    for (int row = row0; row < row1; row++) {
+      int py = (row - row0) * ppt;
+      for (int col = col0; col < col1; col++) {
+        uint32_t tile = fabric_.tileAt(row, col);
+        if (fabric_.tileType(tile) == DeviceFabric::kEmptyTileType)
+          continue;
+        int px = (col - col0) * ppt;
+        uint32_t color = draw_sites ? type_colors_[fabric_.tileType(tile)] : tileColor(tile);
+        if (draw_usage)
+          color = usageColor(color, tile);
+        fillRect(pixels, stride, px, py, ppt - gap, ppt - gap, color);
+        uint32_t num_sites = fabric_.tileSiteEnd(tile) - fabric_.tileSiteBegin(tile);
+        if (!draw_sites || num_sites == 0)
+          continue;
+        // sites stacked from the top of the tile
+        int margin = ppt / 8;
+        int inner = ppt - gap - 2 * margin;
+        int height = inner / static_cast<int>(num_sites);
+        uint32_t site_color = blend(color, 0xff000000, 96);
+        if (height < 2) {
+          fillRect(pixels, stride, px + margin, py + margin, inner, inner, site_color);
+          continue;
+        }
+        for (uint32_t i = 0; i < num_sites; i++) {
+          uint32_t site = fabric_.tileSiteBegin(tile) + i;
+          fillRect(pixels, stride, px + margin, py + margin + static_cast<int>(i) * height, inner, height - 1,
+            site_cells_[site] != kInvalidId ? kUsedSiteColor : site_color);
+        }
+      }
+    }
+  }
+
+  void FabricScene::renderAveraged(int step, int col0, int row0, uint32_t* pixels, int stride) const {
+    const uint32_t area = static_cast<uint32_t>(step) * static_cast<uint32_t>(step);
+    bool draw_usage = !tile_usage_.empty();
+    for (int py = 0; py < kTileSize; py++) {
+      int r0 = row0 + py * step;
+      if (r0 >= rows())
+        break;
+      int r1 = std::min(r0 + step, rows());
+      uint32_t* line = pixels + static_cast<ptrdiff_t>(py) * stride;
+      for (int px = 0; px < kTileSize; px++) {
+        int c0 = col0 + px * step;
+        if (c0 >= cols())
+          break;
+        int c1 = std::min(c0 + step, cols());
+        uint32_t r = 0;
+        uint32_t g = 0;
+        uint32_t b = 0;
+        uint32_t inside = 0;
+        for (int row = r0; row < r1; row++) {
+          uint32_t tile = fabric_.tileAt(row, c0);
+          for (int col = c0; col < c1; col++, tile++) {
+            uint32_t color = fabric_.tileType(tile) == DeviceFabric::kEmptyTileType ? kBackground : tileColor(tile);
+            if (draw_usage)
+              color = usageColor(color, tile);
+            r += (color >> 16) & 0xff;
+            g += (color >> 8) & 0xff;
+            b += color & 0xff;
+            inside++;
+          }
+        }
+        // the part of the pixel outside of the device is background
+        uint32_t outside = area - inside;
+        r += ((kBackground >> 16) & 0xff) * outside;
+        g += ((kBackground >> 8) & 0xff) * outside;
+        b += (kBackground & 0xff) * outside;
+        line[px] = 0xff000000 | ((r / area) << 16) | ((g / area) << 8) | (b / area);
+      }
+    }
+  }
+
+  void FabricScene::renderSegments(const std::vector<Segment>& segments, const PackedRTree& index, double ppt, double col0, double row0, uint32_t* pixels, int stride) const {
+    if (segments.empty())
+      return;
+    double span = kTileSize / ppt;
+    std::vector<uint32_t> visible;
+    index.search(PackedRTree::Box(static_cast<float>(col0), static_cast<float>(row0),
+      static_cast<float>(col0 + span), static_cast<float>(row0 + span)), visible);
+    for (size_t i = 0; i < visible.size(); i++) {
+      const Segment& segment = segments[visible[i]];
+      drawLine(pixels, stride,
+        (segment.col0 + 0.5 - col0) * ppt, (segment.row0 + 0.5 - row0) * ppt,
+        (segment.col1 + 0.5 - col0) * ppt, (segment.row1 + 0.5 - row0) * ppt, kRoutingColor);
+    }
+  }
+
+  void FabricScene::renderPips(int ppt, int col0, int row0, uint32_t* pixels, int stride) const {
+    if (tile_usage_.empty())
+      return;
+    int span = kTileSize / ppt;
+    int col1 = std::min(col0 + span, cols());
+    int row1 = std::min(row0 + span, rows());
+    int size = std::max(ppt / 8, 2);
+    for (int row = row0; row < row1; row++) {
+      for (int col = col0; col < col1; col++) {
+        if (tile_usage_[fabric_.tileAt(row, col)] > 0)
+          fillRect(pixels, stride, (col - col0) * ppt + (ppt - size) / 2, (row - row0) * ppt + (ppt - size) / 2, size, size, kPipColor);
+      }
+    }
+  }
+
+}
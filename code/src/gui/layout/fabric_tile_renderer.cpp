@@ -0,0 +1,142 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <algorithm>
+#include <qapplication.h>
+#include <qimage.h>
+
+#include "gui/main_event.h"
+#include "gui/layout/fabric_tile_renderer.h"
+#include "utility/parallel.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  const size_t FabricTileRenderer::kDefaultCacheBytes;
+
+  FabricTileRenderer::FabricTileRenderer(QObject* parent) : QObject(parent) {
+    generation_ = 0;
+    stopping_ = false;
+    cache_bytes_ = 0;
+    max_cache_bytes_ = kDefaultCacheBytes;
+    // one processor is left to the GUI thread
+    int num_threads = std::max(numProcessors() - 1, 1);
+    for (int i = 0; i < num_threads; i++) {
+      RenderThread* thread = new RenderThread(this);
+      thread->start(QThread::LowPriority);
+      threads_.append(thread);
+    }
+  }
+
+  FabricTileRenderer::~FabricTileRenderer() {
+    {
+      QMutexLocker locker(&mutex_);
+      stopping_ = true;
+      pending_.clear();
+      work_.wakeAll();
+    }
+    foreach(RenderThread* thread, threads_) {
+      thread->wait();
+      delete thread;
+    }
+  }
+
+  void FabricTileRenderer::setScene(const std::shared_ptr<const FabricScene>& scene) {
+    QMutexLocker locker(&mutex_);
+    scene_ = scene;
+    work_scene_ = scene;
+    generation_++;
+    pending_.clear();
+    drawing_.clear();
+    cache_.clear();
+    lru_.clear();
+    cache_bytes_ = 0;
+  }
+
+  const QPixmap* FabricTileRenderer::tile(quint64 key) {
+    QHash<quint64, CacheEntry>::iterator iter = cache_.find(key);
+    if (iter == cache_.end())
+      return NULL;
+    lru_.splice(lru_.begin(), lru_, iter->lru_pos);
+    return &iter->pixmap;
+  }
+
+  void FabricTileRenderer::request(const QVector<quint64>& keys) {
+    QMutexLocker locker(&mutex_);
+    pending_.clear();
+    if (!scene_)
+      return;
+    // the threads take from the back
+    for (int i = keys.size() - 1; i >= 0; i--) {
+      if (!cache_.contains(keys[i]) && !drawing_.contains(keys[i]))
+        pending_.append(keys[i]);
+    }
+    if (!pending_.isEmpty())
+      work_.wakeAll();
+  }
+
+  void FabricTileRenderer::set_max_cache_bytes(size_t bytes) {
+    max_cache_bytes_ = bytes;
+    evict();
+  }
+
+  void FabricTileRenderer::customEvent(QEvent* event) {
+    if (event->type() != FABRIC_TILE_RENDERED)
+      return;
+    FabricTileEvent* tile_event = static_cast<FabricTileEvent*>(event);
+    {
+      QMutexLocker locker(&mutex_);
+      if (tile_event->generation() != generation_)
+        return;
+      drawing_.remove(tile_event->key());
+    }
+    CacheEntry& entry = cache_[tile_event->key()];
+    entry.pixmap = QPixmap::fromImage(tile_event->image());
+    lru_.push_front(tile_event->key());
+    entry.lru_pos = lru_.begin();
+    cache_bytes_ += static_cast<size_t>(FabricScene::kTileSize) * FabricScene::kTileSize * 4;
+    evict();
+    emit tileReady();
+  }
+
+  void FabricTileRenderer::evict() {
+    while (cache_bytes_ > max_cache_bytes_ && !lru_.empty()) {
+      cache_.remove(lru_.back());
+      lru_.pop_back();
+      cache_bytes_ -= static_cast<size_t>(FabricScene::kTileSize) * FabricScene::kTileSize * 4;
+    }
+  }
+
+  void FabricTileRenderer::work() {
+    Tracer::set_thread_name("fabric renderer");
+    QMutexLocker locker(&mutex_);
+    while (true) {
+      while (pending_.isEmpty() && !stopping_) {
+        work_.wait(&mutex_);
+      }
+      if (stopping_)
+        break;
+      quint64 key = pending_.takeLast();
+      drawing_.insert(key);
+      std::shared_ptr<const FabricScene> scene = work_scene_;
+      int generation = generation_;
+      locker.unlock();
+
+      QImage image(FabricScene::kTileSize, FabricScene::kTileSize, QImage::Format_RGB32);
+      {
+        TraceScope scope("fabric_tile", "gui");
+        int level = static_cast<int>(key >> 48);
+        int y = static_cast<int>((key >> 24) & 0xffffff);
+        int x = static_cast<int>(key & 0xffffff);
+        scene->render(level, x, y, reinterpret_cast<uint32_t*>(image.bits()), image.bytesPerLine() / 4);
+      }
+      QApplication::postEvent(this, new FabricTileEvent(key, generation, image));
+      locker.relock();
+    }
+  }
+
+}
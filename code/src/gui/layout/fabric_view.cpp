@@ -0,0 +1,343 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <qpainter.h>
+#include <qevent.h>
+
+#include "gui/layout/fabric_view.h"
+#include "gui/layout/fabric_tile_renderer.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  namespace {
+
+    const double kMaxScale = 4.0 * FabricScene::kMaxPixelsPerTile;
+    const double kZoomStep = 1.25;
+    const int kClickDistance = 3;
+    // pixels that outlines and highlighted routing reach past their box
+    const int kOverlayMargin = 3;
+
+    QRectF toRect(const PackedRTree::Box& box) {
+      return QRectF(box.x0, box.y0, box.x1 - box.x0, box.y1 - box.y0);
+    }
+
+    // the coarsest level that still has at least 'scale' pixels per tile
+    int levelFor(double scale, int num_levels) {
+      int level = 0;
+      while (level + 1 < num_levels && FabricScene::pixelsPerTile(level + 1) >= scale) {
+        level++;
+      }
+      return level;
+    }
+
+  }
+
+  FabricView::FabricView(QWidget* parent) : QWidget(parent) {
+    renderer_ = new FabricTileRenderer(this);
+    scale_ = 1.0;
+    dragging_ = false;
+    level_ = 0;
+    frame_ms_ = 0.0;
+    setFocusPolicy(Qt::StrongFocus);
+    setMouseTracking(true);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    connect(renderer_, SIGNAL(tileReady()), this, SLOT(update()));
+  }
+
+  FabricView::~FabricView() {
+  }
+
+  const std::shared_ptr<const FabricScene>& FabricView::scene() const {
+    return renderer_->scene();
+  }
+
+  void FabricView::setScene(const std::shared_ptr<const FabricScene>& scene) {
+    renderer_->setScene(scene);
+    overlay_.setScene(scene);
+    selection_ = QRectF();
+    fit();
+  }
+
+  void FabricView::setSelection(const QRectF& selection) {
+    updateDevice(selection_);
+    selection_ = selection;
+    updateDevice(selection_);
+  }
+
+  bool FabricView::highlight(FabricOverlay::Kind kind, const QString& name, const QColor& color) {
+    PackedRTree::Box dirty;
+    if (!overlay_.highlight(kind, name.toStdString(), color.rgba(), dirty))
+      return false;
+    updateDevice(toRect(dirty));
+    return true;
+  }
+
+  bool FabricView::unhighlight(FabricOverlay::Kind kind, const QString& name) {
+    PackedRTree::Box dirty;
+    if (!overlay_.unhighlight(kind, name.toStdString(), dirty))
+      return false;
+    updateDevice(toRect(dirty));
+    return true;
+  }
+
+  void FabricView::clearHighlights() {
+    overlay_.clear();
+    update();
+  }
+
+  QRectF FabricView::toScreen(const QRectF& rect) const {
+    return QRectF((rect.left() - origin_.x()) * scale_, (rect.top() - origin_.y()) * scale_,
+      rect.width() * scale_, rect.height() * scale_);
+  }
+
+  void FabricView::updateDevice(const QRectF& rect) {
+    if (rect.isNull())
+      return;
+    QRect area = toScreen(rect).toAlignedRect().adjusted(-kOverlayMargin, -kOverlayMargin, kOverlayMargin, kOverlayMargin);
+    area &= this->rect();
+    if (!area.isEmpty())
+      update(area);
+  }
+
+  QPointF FabricView::toDevice(const QPoint& pos) const {
+    return QPointF(origin_.x() + pos.x() / scale_, origin_.y() + pos.y() / scale_);
+  }
+
+  void FabricView::fit() {
+    const std::shared_ptr<const FabricScene>& fabric_scene = scene();
+    if (fabric_scene && fabric_scene->cols() > 0 && fabric_scene->rows() > 0) {
+      double cols = fabric_scene->cols();
+      double rows = fabric_scene->rows();
+      scale_ = 0.95 * std::min(width() / cols, height() / rows);
+      if (scale_ <= 0.0)
+        scale_ = 1.0;
+      origin_ = QPointF(cols / 2 - width() / (2 * scale_), rows / 2 - height() / (2 * scale_));
+    }
+    update();
+  }
+
+  void FabricView::zoomIn() {
+    zoomAt(rect().center(), kZoomStep);
+  }
+
+  void FabricView::zoomOut() {
+    zoomAt(rect().center(), 1 / kZoomStep);
+  }
+
+  void FabricView::zoomAt(const QPoint& pos, double factor) {
+    const std::shared_ptr<const FabricScene>& fabric_scene = scene();
+    if (!fabric_scene)
+      return;
+    double fit_scale = std::min(width() / static_cast<double>(std::max(fabric_scene->cols(), 1)),
+      height() / static_cast<double>(std::max(fabric_scene->rows(), 1)));
+    // zooming out stops at a quarter of the fitted size
+    double scale = std::min(scale_ * factor, kMaxScale);
+    scale = std::max(scale, std::min(0.25 * fit_scale, scale_));
+    QPointF anchor = toDevice(pos);
+    scale_ = scale;
+    origin_ = QPointF(anchor.x() - pos.x() / scale_, anchor.y() - pos.y() / scale_);
+    update();
+  }
+
+  bool FabricView::drawCoarser(QPainter& painter, const FabricScene& scene, int level, int x, int y, const QRect& target) {
+    for (int coarser = level + 1; coarser < scene.numLevels(); coarser++) {
+      int shift = coarser - level;
+      int size = FabricScene::kTileSize >> shift;
+      if (size < 1)
+        break;
+      const QPixmap* pixmap = renderer_->tile(FabricTileRenderer::tileKey(coarser, x >> shift, y >> shift));
+      if (pixmap == NULL)
+        continue;
+      QRect source((x - ((x >> shift) << shift)) * size, (y - ((y >> shift) << shift)) * size, size, size);
+      painter.drawPixmap(target, *pixmap, source);
+      return true;
+    }
+    return false;
+  }
+
+  void FabricView::paintEvent(QPaintEvent* event) {
+    TraceScope scope("fabric_frame", "gui");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // only the changed part after highlights or a new tile
+    QRect clip = event->rect();
+    QPainter painter(this);
+    painter.fillRect(clip, QColor::fromRgb(FabricScene::kBackground));
+    const std::shared_ptr<const FabricScene> fabric_scene = scene();
+    if (!fabric_scene) {
+      painter.setPen(Qt::gray);
+      painter.drawText(rect(), Qt::AlignCenter, tr("No device loaded"));
+      return;
+    }
+
+    level_ = levelFor(scale_, fabric_scene->numLevels());
+    // device tiles per raster tile and its size on the screen
+    double span = FabricScene::kTileSize / FabricScene::pixelsPerTile(level_);
+    int num_cols = fabric_scene->levelCols(level_);
+    int num_rows = fabric_scene->levelRows(level_);
+    int x0 = std::max(static_cast<int>(floor(origin_.x() / span)), 0);
+    int y0 = std::max(static_cast<int>(floor(origin_.y() / span)), 0);
+    int x1 = std::min(static_cast<int>(floor((origin_.x() + width() / scale_) / span)), num_cols - 1);
+    int y1 = std::min(static_cast<int>(floor((origin_.y() + height() / scale_) / span)), num_rows - 1);
+
+    QVector<quint64> missing;
+    for (int y = y0; y <= y1; y++) {
+      for (int x = x0; x <= x1; x++) {
+        // rounded edges so neighboring tiles meet without seams
+        int left = static_cast<int>(floor((x * span - origin_.x()) * scale_ + 0.5));
+        int top = static_cast<int>(floor((y * span - origin_.y()) * scale_ + 0.5));
+        int right = static_cast<int>(floor(((x + 1) * span - origin_.x()) * scale_ + 0.5));
+        int bottom = static_cast<int>(floor(((y + 1) * span - origin_.y()) * scale_ + 0.5));
+        QRect target(left, top, right - left, bottom - top);
+        quint64 key = FabricTileRenderer::tileKey(level_, x, y);
+        const QPixmap* pixmap = renderer_->tile(key);
+        if (pixmap == NULL)
+          missing.append(key);
+        if (!target.intersects(clip))
+          continue;
+        if (pixmap != NULL) {
+          painter.drawPixmap(target, *pixmap, pixmap->rect());
+        } else {
+          drawCoarser(painter, *fabric_scene, level_, x, y, target);
+        }
+      }
+    }
+
+    // the missing tiles nearest to the center first, then one ring around
+    // the view for panning and the coarser level for zooming out
+    double center_x = (x0 + x1) / 2.0;
+    double center_y = (y0 + y1) / 2.0;
+    std::sort(missing.begin(), missing.end(), [&](quint64 a, quint64 b) {
+      double ax = static_cast<double>(a & 0xffffff) - center_x;
+      double ay = static_cast<double>((a >> 24) & 0xffffff) - center_y;
+      double bx = static_cast<double>(b & 0xffffff) - center_x;
+      double by = static_cast<double>((b >> 24) & 0xffffff) - center_y;
+      return ax * ax + ay * ay < bx * bx + by * by;
+    });
+    for (int y = y0 - 1; y <= y1 + 1; y++) {
+      for (int x = x0 - 1; x <= x1 + 1; x++) {
+        if (x < 0 || y < 0 || x >= num_cols || y >= num_rows)
+          continue;
+        if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+          continue;
+        missing.append(FabricTileRenderer::tileKey(level_, x, y));
+      }
+    }
+    if (level_ + 1 < fabric_scene->numLevels()) {
+      for (int y = y0 / 2; y <= y1 / 2; y++) {
+        for (int x = x0 / 2; x <= x1 / 2; x++) {
+          missing.append(FabricTileRenderer::tileKey(level_ + 1, x, y));
+        }
+      }
+    }
+    renderer_->request(missing);
+
+    drawOverlay(painter, *fabric_scene, clip);
+    if (!selection_.isEmpty()) {
+      QRectF outline = toScreen(selection_);
+      painter.setPen(QPen(Qt::cyan, 2));
+      painter.setBrush(Qt::NoBrush);
+      painter.drawRect(outline.adjusted(-1, -1, 1, 1));
+    }
+
+    frame_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    emit frameDrawn();
+  }
+
+  void FabricView::drawOverlay(QPainter& painter, const FabricScene& scene, const QRect& clip) {
+    if (overlay_.size() == 0)
+      return;
+    QPointF top_left = toDevice(clip.topLeft() - QPoint(kOverlayMargin, kOverlayMargin));
+    QPointF bottom_right = toDevice(clip.bottomRight() + QPoint(kOverlayMargin + 1, kOverlayMargin + 1));
+    std::vector<uint32_t> items;
+    overlay_.find(PackedRTree::Box(static_cast<float>(top_left.x()), static_cast<float>(top_left.y()),
+      static_cast<float>(bottom_right.x()), static_cast<float>(bottom_right.y())), items);
+    QVector<QLineF> lines;
+    for (size_t i = 0; i < items.size(); i++) {
+      const FabricOverlay::Item& item = overlay_.item(items[i]);
+      QColor color = QColor::fromRgba(item.color);
+      painter.setPen(QPen(color, 2));
+      if (item.kind == FabricOverlay::kNet) {
+        // one call for all segments of the net
+        lines.clear();
+        for (uint32_t s = item.segment_begin; s < item.segment_end; s++) {
+          const FabricScene::Segment& segment = scene.segment(s);
+          lines.append(QLineF((segment.col0 + 0.5 - origin_.x()) * scale_, (segment.row0 + 0.5 - origin_.y()) * scale_,
+            (segment.col1 + 0.5 - origin_.x()) * scale_, (segment.row1 + 0.5 - origin_.y()) * scale_));
+        }
+        painter.drawLines(lines);
+        continue;
+      }
+      if (item.kind == FabricOverlay::kCell) {
+        color.setAlpha(96);
+        painter.setBrush(color);
+      } else {
+        painter.setBrush(Qt::NoBrush);
+      }
+      painter.drawRect(toScreen(toRect(item.box)));
+    }
+  }
+
+  void FabricView::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+      dragging_ = true;
+      drag_pos_ = event->pos();
+      press_pos_ = event->pos();
+    }
+    QWidget::mousePressEvent(event);
+  }
+
+  void FabricView::mouseMoveEvent(QMouseEvent* event) {
+    if (dragging_) {
+      if ((event->pos() - press_pos_).manhattanLength() > kClickDistance)
+        setCursor(Qt::ClosedHandCursor);
+      QPoint delta = event->pos() - drag_pos_;
+      drag_pos_ = event->pos();
+      origin_ -= QPointF(delta.x() / scale_, delta.y() / scale_);
+      update();
+    }
+    emit hovered(toDevice(event->pos()));
+    QWidget::mouseMoveEvent(event);
+  }
+
+  void FabricView::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && dragging_) {
+      dragging_ = false;
+      unsetCursor();
+      if ((event->pos() - press_pos_).manhattanLength() <= kClickDistance)
+        emit clicked(toDevice(event->pos()));
+    }
+    QWidget::mouseReleaseEvent(event);
+  }
+
+  void FabricView::wheelEvent(QWheelEvent* event) {
+    double steps = event->angleDelta().y() / 120.0;
+    if (steps != 0.0) {
+      zoomAt(event->pos(), pow(kZoomStep, steps));
+    }
+    event->accept();
+  }
+
+  void FabricView::keyPressEvent(QKeyEvent* event) {
+    switch (event->key()) {
+      case Qt::Key_F: fit(); break;
+      case Qt::Key_Plus:
+      case Qt::Key_Equal: zoomIn(); break;
+      case Qt::Key_Minus: zoomOut(); break;
+      default: QWidget::keyPressEvent(event); break;
+    }
+  }
+
+  void FabricView::leaveEvent(QEvent* event) {
+    emit hovered(QPointF(-1, -1));
+    QWidget::leaveEvent(event);
+  }
+
+}
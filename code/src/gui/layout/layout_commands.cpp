@@ -0,0 +1,119 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <qcolor.h>
+#include <qstringlist.h>
+#include <qvariant.h>
+
+#include "tcl/commands.h"
+#include "gui/gui.h"
+#include "gui/main_event.h"
+#include "utility/log.h"
+
+namespace eda {
+
+  namespace {
+
+    const char* const kObjectOptions[] = { "-net", "-cell", "-tile", "-region" };
+    const char* const kObjectTypes[] = { "net", "cell", "tile", "region" };
+    const int kNumObjectOptions = 4;
+
+    // Broadcasts one kEventHighlightChanged per given option. Nets, cells and
+    // tiles are Tcl lists, so a whole path is one event, a region is one
+    // "<x0> <y0> <x1> <y1>".
+    int postHighlight(Tcl_Interp* interp, int objc, Tcl_Obj* const objv[], const QString& color, bool highlight) {
+      int num_posted = 0;
+      for (int i = 0; i < kNumObjectOptions; i++) {
+        int index = Commands::getOptionIndex(objc, objv, kObjectOptions[i]);
+        if (index < 0 || index + 1 >= objc)
+          continue;
+        QStringList names;
+        if (i == kNumObjectOptions - 1) {
+          names.append(Tcl_GetString(objv[index + 1]));
+        } else {
+          int count = 0;
+          Tcl_Obj** elements = NULL;
+          if (Tcl_ListObjGetElements(interp, objv[index + 1], &count, &elements) != TCL_OK)
+            return -1;
+          for (int e = 0; e < count; e++) {
+            names.append(Tcl_GetString(elements[e]));
+          }
+        }
+        QMap<const char*, QVariant> attributes;
+        attributes.insert(GlobalEvent::key_object_type, kObjectTypes[i]);
+        attributes.insert(GlobalEvent::key_object_name, names);
+        attributes.insert(GlobalEvent::key_color, color);
+        attributes.insert(GlobalEvent::key_highlight, highlight);
+        EventDispatcher::instance()->broadcastEvent(GlobalEvent::kEventHighlightChanged, NULL, attributes);
+        num_posted++;
+      }
+      return num_posted;
+    }
+
+  }
+
+  // highlight [-net <list>] [-cell <list>] [-tile <list>] [-region <string>] [-color <string>]
+  // Highlights objects in the Device Browser on top of the fabric, the color
+  // is a name or #rrggbb, yellow by default. Highlighting an object again
+  // changes its color.
+  int Highlight(ClientData, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    if (!Gui::is_gui_mode()) {
+      eda_warning("highlight only works in the GUI.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_OK;
+    }
+    std::string color = "yellow";
+    Commands::getStringOption(objc, objv, "-color", color);
+    if (!QColor::isValidColor(QString::fromStdString(color))) {
+      eda_error("Unknown color %s.\n", color.c_str());
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    int num_posted = postHighlight(interp, objc, objv, QString::fromStdString(color), true);
+    if (num_posted <= 0) {
+      if (num_posted == 0)
+        eda_error("One of -net, -cell, -tile or -region is required.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // unhighlight [-net <list>] [-cell <list>] [-tile <list>] [-region <string>] [-all]
+  int Unhighlight(ClientData, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    if (!Gui::is_gui_mode()) {
+      eda_warning("unhighlight only works in the GUI.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_OK;
+    }
+    if (Commands::isOptionUsed(objc, objv, "-all")) {
+      QMap<const char*, QVariant> attributes;
+      attributes.insert(GlobalEvent::key_object_type, "all");
+      attributes.insert(GlobalEvent::key_highlight, false);
+      EventDispatcher::instance()->broadcastEvent(GlobalEvent::kEventHighlightChanged, NULL, attributes);
+      gCommands.postRun(objc, objv);
+      return TCL_OK;
+    }
+    int num_posted = postHighlight(interp, objc, objv, QString(), false);
+    if (num_posted <= 0) {
+      if (num_posted == 0)
+        eda_error("One of -net, -cell, -tile, -region or -all is required.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+}
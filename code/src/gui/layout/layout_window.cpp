@@ -1,34 +1,95 @@
-
 #include <qstatusbar.h>
 #include <qlabel.h>
 #include <qtoolbar.h>
 #include <qlayout.h>
 #include <qsplitter.h>
+#include <qcolor.h>
+#include <qstringlist.h>
 //******************************************************************************
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
-//* This is only a demo used for how to design a QT window used in the Multiple
-//* Document Interface of this desktop software framework.
+//* Last updated: 2026-10-17
 //******************************************************************************
 
+#include <memory>
+
+#include "gui/gui.h"
+#include "gui/main_event.h"
+#include "gui/project/project.h"
+#include "gui/console/command_worker.h"
 #include "gui/layout/layout_window.h"
+#include "gui/layout/fabric_scene.h"
+#include "gui/layout/fabric_view.h"
+#include "design/design.h"
+#include "device/device_manager.h"
+#include "utility/log.h"
+#include "utility/memory_tracker.h"
+#include "utility/tracer.h"
 
 QLabel* g_status_label = NULL;
 
 namespace eda {
 
+  QMutex LayoutWindow::scene_mutex_;
+  QString LayoutWindow::scene_family_;
+  QString LayoutWindow::scene_device_;
+  std::shared_ptr<const FabricScene> LayoutWindow::scene_;
+  QString LayoutWindow::scene_key_;
+  QString LayoutWindow::scene_status_;
+  const Design* LayoutWindow::scene_design_ = NULL;
+  uint32_t LayoutWindow::scene_instances_ = 0;
+  uint32_t LayoutWindow::scene_pips_ = 0;
+  int LayoutWindow::num_windows_ = 0;
 
   LayoutWindow::LayoutWindow(QWidget* parent) : QMainWindow(parent) {
+    {
+      // the worker never reads the project, the GUI may replace it any time
+      QMutexLocker locker(&scene_mutex_);
+      num_windows_++;
+      Project* project = Project::project();
+      scene_family_ = project != NULL ? project->family() : QString();
+      scene_device_ = project != NULL ? project->device() : QString();
+    }
     setWindowTitle("Device Browser");
+    fabric_view_ = new FabricView(this);
+    setCentralWidget(fabric_view_);
+    connect(fabric_view_, SIGNAL(frameDrawn()), this, SLOT(onFrameDrawn()));
+    connect(fabric_view_, SIGNAL(hovered(const QPointF&)), this, SLOT(onHovered(const QPointF&)));
+    connect(fabric_view_, SIGNAL(clicked(const QPointF&)), this, SLOT(onClicked(const QPointF&)));
     initializeSideBar();
     QLabel* status_label = new QLabel("Status Bar");
     QStatusBar* status_bar = new QStatusBar();
     status_bar->addWidget(status_label);
+    frame_label_ = new QLabel();
+    status_bar->addPermanentWidget(frame_label_);
     setStatusBar(status_bar);
+    statusLabel_ = status_label;
     g_status_label = status_label;
     resize(1200, 800);
+
+    EventDispatcher::instance()->subscribeEvent(this, GlobalEvent::kEventProjectOpened);
+    EventDispatcher::instance()->subscribeEvent(this, GlobalEvent::kEventSceneReady);
+    EventDispatcher::instance()->subscribeEvent(this, GlobalEvent::kEventHighlightChanged);
+    connect(this, SIGNAL(destroyed(QObject*)), EventDispatcher::instance(), SLOT(cleanup(QObject*)));
+    reload();
+    // The scene of the current state, built behind the queued commands. The
+    // job only reads the design and the device manager, which belong to the
+    // worker, so the application need not be busy.
+    if (Gui::command_worker() != NULL)
+      Gui::command_worker()->post(QStringList(), NULL);
+  }
+
+  LayoutWindow::~LayoutWindow() {
+    QMutexLocker locker(&scene_mutex_);
+    if (--num_windows_ == 0) {
+      // the next window builds it again
+      scene_family_.clear();
+      scene_device_.clear();
+      scene_.reset();
+      scene_key_.clear();
+      scene_design_ = NULL;
+    }
   }
 
   void LayoutWindow::initializeSideBar() {
@@ -37,10 +98,146 @@ namespace eda {
     toolBar->setAllowedAreas(Qt::LeftToolBarArea);
     QAction* action = toolBar->addAction("<<");
     connect(action, SIGNAL(triggered()), this, SLOT(changeDockVisible()));
+    action = toolBar->addAction("Fit");
+    action->setStatusTip(tr("Fit the device into the view (F)"));
+    connect(action, SIGNAL(triggered()), fabric_view_, SLOT(fit()));
+    action = toolBar->addAction("+");
+    connect(action, SIGNAL(triggered()), fabric_view_, SLOT(zoomIn()));
+    action = toolBar->addAction("-");
+    connect(action, SIGNAL(triggered()), fabric_view_, SLOT(zoomOut()));
     addToolBar(Qt::LeftToolBarArea, toolBar);
   }
 
+  void LayoutWindow::reload() {
+    std::shared_ptr<const FabricScene> scene;
+    QString status;
+    {
+      QMutexLocker locker(&scene_mutex_);
+      scene = scene_;
+      status = scene_status_;
+      device_key_ = scene_key_;
+    }
+    if (scene != fabric_view_->scene())
+      fabric_view_->setScene(scene);
+    if (!status.isEmpty())
+      statusLabel_->setText(status);
+  }
+
+  void LayoutWindow::prepareScene() {
+    DeviceManager* manager = DeviceManager::manager();
+    if (manager == NULL)
+      return;
+    const Design* design = Design::design();
+    uint32_t num_instances = design != NULL ? design->numInstances() : 0;
+    uint32_t num_pips = design != NULL ? design->numPips() : 0;
+    QString family;
+    QString device;
+    QString key;
+    {
+      QMutexLocker locker(&scene_mutex_);
+      if (num_windows_ == 0 || scene_family_.isEmpty())
+        return;
+      family = scene_family_;
+      device = scene_device_;
+      key = family + "/" + device;
+      if (key == scene_key_ && design == scene_design_ && num_instances == scene_instances_ && num_pips == scene_pips_)
+        return;
+    }
+    // built without the lock, the windows keep showing the old scene
+    std::shared_ptr<const FabricScene> scene;
+    QString status;
+    const DeviceFabric* fabric = manager->fabric(family.toStdString(), device.toStdString());
+    if (fabric == NULL) {
+      status = tr("The fabric of %1 is not installed.").arg(key);
+    } else {
+      TraceScope scope("fabric_scene", "gui");
+      MemoryTagScope tag(MemoryTracker::TAG_GUI);
+      scene = std::make_shared<FabricScene>(*fabric, design);
+    }
+    {
+      QMutexLocker locker(&scene_mutex_);
+      // the windows were closed meanwhile
+      if (num_windows_ == 0 || family != scene_family_ || device != scene_device_)
+        return;
+      scene_ = scene;
+      scene_status_ = status;
+      scene_key_ = key;
+      scene_design_ = design;
+      scene_instances_ = num_instances;
+      scene_pips_ = num_pips;
+    }
+    EventDispatcher::instance()->broadcastEvent(GlobalEvent::kEventSceneReady);
+  }
 
+  void LayoutWindow::customEvent(QEvent* event) {
+    GlobalEvent* global_event = dynamic_cast<GlobalEvent*>(event);
+    if (!global_event) return;
 
+    if (global_event->id() == GlobalEvent::kEventProjectOpened ||
+      global_event->id() == GlobalEvent::kEventSceneReady) {
+      reload();
+    } else if (global_event->id() == GlobalEvent::kEventHighlightChanged) {
+      highlight(global_event->attributes());
+    }
+  }
+
+  void LayoutWindow::highlight(const QMap<const char*, QVariant>& attributes) {
+    QString type = attributes.value(GlobalEvent::key_object_type).toString();
+    bool on = attributes.value(GlobalEvent::key_highlight).toBool();
+    if (type == "all") {
+      fabric_view_->clearHighlights();
+      return;
+    }
+    FabricOverlay::Kind kind;
+    if (type == "net")
+      kind = FabricOverlay::kNet;
+    else if (type == "cell")
+      kind = FabricOverlay::kCell;
+    else if (type == "tile")
+      kind = FabricOverlay::kTile;
+    else
+      kind = FabricOverlay::kRegion;
+    QColor color(attributes.value(GlobalEvent::key_color).toString());
+    QStringList names = attributes.value(GlobalEvent::key_object_name).toStringList();
+    int missing = 0;
+    for (int i = 0; i < names.size(); i++) {
+      bool found = on ? fabric_view_->highlight(kind, names.at(i), color) : fabric_view_->unhighlight(kind, names.at(i));
+      if (!found)
+        missing++;
+    }
+    if (missing > 0 && on)
+      eda_warning("%d of %d %s objects are not in the Device Browser.\n", missing, names.size(), type.toLatin1().constData());
+  }
+
+  void LayoutWindow::onFrameDrawn() {
+    const std::shared_ptr<const FabricScene>& scene = fabric_view_->scene();
+    if (!scene)
+      return;
+    frame_label_->setText(QString("%1  %2 x %3 tiles, %4 used sites  |  level %5, %6 px/tile, %7 route segments, frame %8 ms")
+      .arg(device_key_).arg(scene->cols()).arg(scene->rows()).arg(scene->numUsedSites())
+      .arg(fabric_view_->level()).arg(fabric_view_->scale(), 0, 'f', 2)
+      .arg(scene->numLevelSegments(fabric_view_->level())).arg(fabric_view_->frame_ms(), 0, 'f', 1));
+  }
+
+  void LayoutWindow::onHovered(const QPointF& pos) {
+    const std::shared_ptr<const FabricScene>& scene = fabric_view_->scene();
+    if (!scene)
+      return;
+    // a few pixels around the cursor for thin routing lines
+    FabricScene::Hit hit = scene->pick(pos.x(), pos.y(), 3 / fabric_view_->scale());
+    statusLabel_->setText(QString::fromStdString(scene->describe(hit)));
+  }
+
+  void LayoutWindow::onClicked(const QPointF& pos) {
+    const std::shared_ptr<const FabricScene>& scene = fabric_view_->scene();
+    if (!scene)
+      return;
+    FabricScene::Hit hit = scene->pick(pos.x(), pos.y(), 3 / fabric_view_->scale());
+    PackedRTree::Box box = scene->bounds(hit);
+    fabric_view_->setSelection(QRectF(box.x0, box.y0, box.x1 - box.x0, box.y1 - box.y0));
+    std::string text = scene->describe(hit);
+    if (!text.empty())
+      eda_info("%s\n", text.c_str());
+  }
 
-}
\ No newline at end of file
+}
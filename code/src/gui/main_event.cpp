@@ -2,16 +2,42 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <qapplication.h>
 
 #include "gui/main_event.h"
+#include "utility/tracer.h"
 
 namespace eda {
+
+  namespace {
+
+    // marker name of an event in the trace
+    const char* eventName(GlobalEvent::EventId event_id) {
+      switch (event_id) {
+        case GlobalEvent::kEventOptionInit: return "option_init";
+        case GlobalEvent::kEventOptionChanged: return "option_changed";
+        case GlobalEvent::kEventProjectOpened: return "project_opened";
+        case GlobalEvent::kEventCommandFinish: return "command_finish";
+        case GlobalEvent::kEventChipSelected: return "chip_selected";
+        case GlobalEvent::kEventBusyLocked: return "busy_locked";
+        case GlobalEvent::kEventLabelWorkFinish: return "label_work_finish";
+        case GlobalEvent::kEventHighlightChanged: return "highlight_changed";
+        case GlobalEvent::kEventSceneReady: return "scene_ready";
+        default: return "event";
+      }
+    }
+
+  }
+
   EventDispatcher* EventDispatcher::instance_ = NULL;
   const char* GlobalEvent::key_result = "result";
+  const char* GlobalEvent::key_object_type = "object_type";
+  const char* GlobalEvent::key_object_name = "object_name";
+  const char* GlobalEvent::key_color = "color";
+  const char* GlobalEvent::key_highlight = "highlight";
 
   EventDispatcher::EventDispatcher() {
 
@@ -26,9 +52,11 @@ namespace eda {
     return instance_;
   }
   void EventDispatcher::broadcastEvent(GlobalEvent::EventId event_id, QObject* from_obj, const QMap<const char*, QVariant>& attributes) {
+    Tracer::instant(eventName(event_id), "gui");
+    QMutexLocker locker(&mutex_);
     auto iter = event_object_map_.find(event_id);
     if (iter != event_object_map_.end()) {
-      auto obj_list = iter->second;
+      const std::list<QObject*>& obj_list = iter->second;
       for (auto list_iter = obj_list.begin(); list_iter != obj_list.end(); list_iter++) {
         if (*list_iter && (static_cast<void*>(*list_iter) != from_obj)) {
           QApplication::postEvent(*list_iter, new GlobalEvent(event_id, from_obj, attributes));
@@ -37,15 +65,18 @@ namespace eda {
     }
   }
   void EventDispatcher::subscribeEvent(QObject* obj, GlobalEvent::EventId event_id) {
+    QMutexLocker locker(&mutex_);
     event_object_map_[event_id].push_back(obj);
   }
   void EventDispatcher::unsubscribeEvent(QObject* obj, GlobalEvent::EventId event_id) {
+    QMutexLocker locker(&mutex_);
     auto iter = event_object_map_.find(event_id);
     if (iter != event_object_map_.end()) {
       iter->second.remove(obj);
     }
   }
   void EventDispatcher::cleanup(QObject* obj) {
+    QMutexLocker locker(&mutex_);
     for (auto iter = event_object_map_.begin(); iter != event_object_map_.end(); iter++) {
       iter->second.remove(obj);
     }
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //* class for storing context information for the running command and notify
 //* the current progress of the running command. The running command is supposed
 //* to check the status of the thread it resides regularly using the function
@@ -16,6 +16,7 @@
 #include <qmenubar.h>
 #include <qboxlayout.h>
 #include <qpainter.h>
+#include <qstatusbar.h>
 
 #include "gui/gui.h"
 #include "gui/main_app.h"
@@ -101,6 +102,10 @@ namespace eda {
     createConsoleDock();
     createStartDock();
 
+    progress_bar_ = new QProgressBar(this);
+    progress_bar_->setMaximumWidth(200);
+    progress_bar_->setVisible(false);
+    statusBar()->addPermanentWidget(progress_bar_);
   }
 
   void MainWindow::onSetMdiWindowVisible(bool flag) {
@@ -141,9 +146,12 @@ namespace eda {
   void MainWindow::createActions() {
 
     act_open_project_ = new QAction(QIcon(Gui::resource_path() + "/project.png"), "&Open Project...", this);
+    // commands run on the worker while the GUI stays responsive
+    Gui::main_app()->addWaitObject(act_open_project_);
     act_open_project_->setStatusTip(tr("Opening an existing project"));
 
     act_new_project_ = new QAction(QIcon(Gui::resource_path() + "/current_project.png"), "&New Project...", this);
+    Gui::main_app()->addWaitObject(act_new_project_);
     act_new_project_->setStatusTip(tr("Create a new project"));
 
     act_save_project_ = new QAction(QIcon(Gui::resource_path() + "/save.png"), "&Save Project", this);
@@ -288,6 +296,10 @@ namespace eda {
     Project::load(project_file_name);
     setCurrentProject(Project::project());
     main_tab_->setEnabled(true);
+    // the design of the previous project is dropped and the snapshot of this
+    // one loaded on the command thread, the window stays responsive
+    if (Project::project() != NULL)
+      main_console_->run("read_snapshot");
     return true;
   }
   void MainWindow::onCloseProject() {
@@ -377,10 +389,12 @@ namespace eda {
     } else {
       console_tab_->setTabText(2, "Warnings (" + QString::number(count) + ")");
     }
-    QStringList lists = main_console()->warnings();
-    warning_list_->clear();
-    foreach(QString msg, lists) {
-      warning_list_->addItem(msg.trimmed());
+    // only the messages added since the last change are new
+    if (count < warning_list_->count()) {
+      warning_list_->clear();
+    }
+    for (int i = warning_list_->count(); i < count; i++) {
+      warning_list_->addItem(main_console()->warning(i).trimmed());
     }
   }
   void MainWindow::onErrorChanged(int count) {
@@ -389,10 +403,12 @@ namespace eda {
     } else {
       console_tab_->setTabText(1, "Errors (" + QString::number(count) + ")");
     }
-    QStringList lists = main_console()->errors();
-    error_list_->clear();
-    foreach(QString msg, lists) {
-      error_list_->addItem(msg.trimmed());
+    // only the messages added since the last change are new
+    if (count < error_list_->count()) {
+      error_list_->clear();
+    }
+    for (int i = error_list_->count(); i < count; i++) {
+      error_list_->addItem(main_console()->error(i).trimmed());
     }
   }
   void MainWindow::onViewConsoleLogFile() {
@@ -408,6 +424,15 @@ namespace eda {
     dock_start_->setVisible(flag);
     return;
   }
+  void MainWindow::showProgress(int min, int max, int value) {
+    if (value < 0 || max <= min) {
+      progress_bar_->setVisible(false);
+      return;
+    }
+    progress_bar_->setRange(min, max);
+    progress_bar_->setValue(value);
+    progress_bar_->setVisible(true);
+  }
   void MainWindow::onStartReport() {
     CommandExecutor* executor = qobject_cast<CommandExecutor*>(sender());
     if (executor == NULL) return;
@@ -191,10 +191,11 @@ namespace eda {
     grid->addWidget(new QLabel("Package", this), 3, 0);
     grid->addWidget(new QLabel("Speed", this), 4, 0);
 
+    DeviceManager* manager = DeviceManager::manager();
     family_combo_ = new QComboBox(this);
     family_combo_->setObjectName("FAMILY_COMBO");
     family_combo_->setCurrentIndex(0);
-    std::vector<std::string> families = DeviceManager::manager()->families();
+    const std::vector<std::string>& families = manager->families();
     for (size_t f = 0; f < families.size(); f++) {
       family_combo_->addItem(families[f].c_str());
     }
@@ -202,24 +203,27 @@ namespace eda {
     device_combo_ = new QComboBox(this);
     device_combo_->setObjectName("DEVICE_COMBO");
     device_combo_->setCurrentIndex(1);
-    std::vector<DeviceManager::DeviceDef> devices = DeviceManager::manager()->devices()[0];
-    for (size_t d = 0; d < devices.size(); d++) {
-      device_combo_->addItem(devices[d].name.c_str());
-    }
-
     package_combo_ = new QComboBox(this);
     package_combo_->setObjectName("PACKAGE_COMBO");
     package_combo_->setCurrentIndex(2);
-    DeviceManager::DeviceDef device = DeviceManager::manager()->devices()[0][0];
-    for (size_t p = 0; p < device.packages.size(); p++) {
-      package_combo_->addItem(device.packages[p].c_str());
-    }
-
     speed_combo_ = new QComboBox(this);
     speed_combo_->setObjectName("SPEED_COMBO");
     speed_combo_->setCurrentIndex(3);
-    for (size_t s = 0; s < device.speeds.size(); s++) {
-      speed_combo_->addItem(device.speeds[s].c_str());
+
+    if (manager->numFamilies() > 0) {
+      const std::vector<DeviceManager::DeviceDef>& devices = manager->devices(0);
+      for (size_t d = 0; d < devices.size(); d++) {
+        device_combo_->addItem(devices[d].name.c_str());
+      }
+      if (!devices.empty()) {
+        const DeviceManager::DeviceDef& device = devices[0];
+        for (size_t p = 0; p < device.packages.size(); p++) {
+          package_combo_->addItem(device.packages[p].c_str());
+        }
+        for (size_t s = 0; s < device.speeds.size(); s++) {
+          speed_combo_->addItem(device.speeds[s].c_str());
+        }
+      }
     }
 
     grid->addWidget(family_combo_, 1, 1);
@@ -264,11 +268,14 @@ namespace eda {
   }
   void NewProjectWizard::DevicePage::onDeviceFamilyChanged(int index) {
     device_combo_->clear();
-    std::vector<std::vector<DeviceManager::DeviceDef>> devices = DeviceManager::manager()->devices();
-    if (index >= 0 && index < (int)devices.size()) {
-      for (size_t d = 0; d < devices[index].size(); d++) {
-        device_combo_->addItem(devices[index][d].name.c_str());
+    DeviceManager* manager = DeviceManager::manager();
+    if (index >= 0 && index < (int)manager->numFamilies()) {
+      QStringList names;
+      const std::vector<DeviceManager::DeviceDef>& devices = manager->devices(index);
+      for (size_t d = 0; d < devices.size(); d++) {
+        names.append(devices[d].name.c_str());
       }
+      device_combo_->addItems(names);
     }
   }
   void NewProjectWizard::DevicePage::onDeviceNameChanged(int index) {
@@ -276,13 +283,14 @@ namespace eda {
     speed_combo_->clear();
     int family_index = family_combo_->currentIndex();
     if (family_index < 0) return;
-    std::vector<DeviceManager::DeviceDef> devices = DeviceManager::manager()->devices()[family_index];
+    const std::vector<DeviceManager::DeviceDef>& devices = DeviceManager::manager()->devices(family_index);
     if (index >= 0 && index < (int)devices.size()) {
-      for (size_t p = 0; p < devices[index].packages.size(); p++) {
-        package_combo_->addItem(devices[index].packages[p].c_str());
+      const DeviceManager::DeviceDef& device = devices[index];
+      for (size_t p = 0; p < device.packages.size(); p++) {
+        package_combo_->addItem(device.packages[p].c_str());
       }
-      for (size_t s = 0; s < devices[index].speeds.size(); s++) {
-        speed_combo_->addItem(devices[index].speeds[s].c_str());
+      for (size_t s = 0; s < device.speeds.size(); s++) {
+        speed_combo_->addItem(device.speeds[s].c_str());
       }
     }
   }
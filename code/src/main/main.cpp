@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <stdlib.h>
@@ -11,6 +11,8 @@
 #include <time.h>
 #include <stdlib.h>
 #include <fstream>
+#include <vector>
+#include <tcl.h>
 #ifndef WIN32
 #include <sys/resource.h>
 #include <signal.h>
@@ -23,8 +25,11 @@
 
 #include "utility/log.h"
 #include "utility/data_var.h"
+#include "utility/memory_sampler.h"
+#include "utility/tracer.h"
 #include "utility/utility.h"
 #include "tcl/commands.h"
+#include "tcl/batch_runner.h"
 #include "gui/gui.h"
 #include "device/device_manager.h"
 
@@ -70,8 +75,6 @@ namespace eda {
   extern char* init_tcl_file;
 }
 
-void* MemoryTraceFunc(void*);
-
 #ifdef WIN32
 // hidden win32 dos-style window 
 #pragma comment(linker, "/subsystem:\"windows\" /entry:\"mainCRTStartup\"")
@@ -86,6 +89,7 @@ void SigRoutine(int signo) {
   case SIGSEGV:
   case SIGBUS:
     eda_info("We encountered some problems while executing current command.\nIt may be caused by the environment, the input data, or other unexpected conditions.\nFatal error! Abnormal exit!\n");
+    eda::Console::flush();
     eda::dump_stack();
     exit(-1);
     break;
@@ -94,6 +98,7 @@ void SigRoutine(int signo) {
 #endif
 
 void releaseAll() {
+  eda::MemorySampler::stop();
   eda::DeviceManager::release();
 
 
@@ -103,7 +108,11 @@ void releaseAll() {
 int main(int argc, char** argv) {
 
   std::string logfile_name = default_logfile_name;
+  eda::Console::LogOptions log_options;
   bool gui_mode = false;
+  std::string batch_file;
+  std::vector<std::string> sweeps;
+  eda::BatchRunner batch_runner;
   for (int i = 1; i < argc; i++) {
     std::string cmd = argv[i];
     if (cmd.compare("-sh") == 0) {
@@ -112,12 +121,55 @@ int main(int argc, char** argv) {
       gui_mode = true;
     } else if (cmd.compare("-log") == 0) {
       logfile_name = std::string(argv[i + 1]);
+    } else if (cmd.compare("-log_json") == 0) {
+      log_options.json = true;
+    } else if (cmd.compare("-log_compress") == 0) {
+      log_options.compress = true;
+    } else if (cmd.compare("-log_max_size") == 0 && i + 1 < argc) {
+      // MB of text per log generation
+      log_options.max_size_mb = atoi(argv[++i]);
+    } else if (cmd.compare("-batch") == 0 && i + 1 < argc) {
+      // a job per line: <script> [<name>=<value> ...]
+      batch_file = argv[++i];
+    } else if (cmd.compare("-sweep") == 0 && i + 1 < argc) {
+      // <name>=<first>..<last> or <name>=<value>,<value>,... for the script
+      sweeps.push_back(argv[++i]);
+    } else if (cmd.compare("-jobs") == 0 && i + 1 < argc) {
+      batch_runner.set_num_parallel(atoi(argv[++i]));
+    } else if (cmd.compare("-batch_dir") == 0 && i + 1 < argc) {
+      batch_runner.set_dir(argv[++i]);
     } else if (argv[i][0] == '-') {
       printf("Error : unknown option : %s\n", argv[i]);
       return 0;
     }
   }
-  eda::Console::startLogFile(logfile_name);
+
+  if (!batch_file.empty() || !sweeps.empty()) {
+    if (!batch_file.empty() && !batch_runner.readJobs(batch_file))
+      return 1;
+    if (!sweeps.empty()) {
+      if (argc < 2 || argv[1][0] == '-') {
+        printf("Error : -sweep needs the script as first argument\n");
+        return 1;
+      }
+      if (!batch_runner.addSweep(argv[1], sweeps))
+        return 1;
+    }
+    // the jobs are forked before the log writer or any other thread starts
+    Tcl_FindExecutable(argv[0]);
+    eda::DeviceManager::load();
+    int failed = batch_runner.run(log_options);
+    eda::Console::startLogFile(logfile_name, log_options);
+    eda::Version();
+    eda::BuildTime();
+    eda::StartTime();
+    batch_runner.report();
+    releaseAll();
+    eda::Console::endLogFile();
+    exit(failed > 0 ? 1 : 0);
+  }
+
+  eda::Console::startLogFile(logfile_name, log_options);
 
 #ifdef WIN32
   SetUnhandledExceptionFilter(CrashCallback);
@@ -143,8 +195,8 @@ int main(int argc, char** argv) {
     eda::init_tcl_file = argv[1];
   }
 
-  pthread_t thread_mem_trace;
-  pthread_create(&thread_mem_trace, NULL, MemoryTraceFunc, NULL);
+  eda::Tracer::set_thread_name("main");
+  eda::MemorySampler::start();
 
   eda::DeviceManager::load();
 
@@ -160,58 +212,3 @@ int main(int argc, char** argv) {
 
   exit(0);
 }
-
-void* MemoryTraceFunc(void*) {
-#ifdef WIN32
-  while (true) {
-    PROCESS_MEMORY_COUNTERS info;
-    GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info));
-    eda::DataVar::eda_peak_used_memory_ = static_cast<int>(info.PeakWorkingSetSize) / 1024 / 1024;
-    eda::DataVar::current_used_memory_ = static_cast<int>(info.WorkingSetSize) / 1024 / 1024;
-
-    if (!eda::DataVar::cmd_started_)
-      eda::DataVar::cmd_peak_used_memory_ = eda::DataVar::current_used_memory_;
-    else if (eda::DataVar::cmd_peak_used_memory_ < eda::DataVar::current_used_memory_)
-      eda::DataVar::cmd_peak_used_memory_ = eda::DataVar::current_used_memory_;
-    Sleep(1);
-  }
-#else
-  while (true) {
-    rusage usage;
-    getrusage(RUSAGE_SELF, &usage);
-    int ru_maxrss = static_cast<int>(usage.ru_maxrss / 1024); //MB
-    eda::DataVar::eda_peak_used_memory_ = ru_maxrss; // MB
-
-    const int MAX_SIZE = 512;
-    pid_t pid = getpid();
-    char proc_status_file_name[MAX_SIZE];
-    sprintf(proc_status_file_name, "/proc/%d/status", pid);
-    std::fstream proc_status_stream(proc_status_file_name, std::ios::in);
-    if (!proc_status_stream.good()) {
-      rusage usage;
-      getrusage(RUSAGE_SELF, &usage);
-      eda::DataVar::current_used_memory_ = static_cast<int>((usage.ru_maxrss) / 1024);
-    } else {
-      char buf[MAX_SIZE];
-      while (proc_status_stream.getline(buf, MAX_SIZE)) {
-        if (!strncmp(buf, "VmRSS", 5)) {
-          std::vector<std::string> split_strings = eda::splitStringWithDelim(buf, ' ');
-          eda_assert(split_strings.size() > 1);
-          eda::DataVar::current_used_memory_ = atoi(split_strings[1].c_str()) / 1024;
-          break;
-        }
-      }
-    }
-    proc_status_stream.close();
-
-    if (!eda::DataVar::cmd_started_)
-      eda::DataVar::cmd_peak_used_memory_ = eda::DataVar::current_used_memory_;
-    else if (eda::DataVar::cmd_peak_used_memory_ < eda::DataVar::current_used_memory_)
-      eda::DataVar::cmd_peak_used_memory_ = eda::DataVar::current_used_memory_;
-    usleep(1000);
-  }
-#endif
-  return NULL;
-}
-
-
@@ -43,6 +43,7 @@ unix {
 }
 
 unix:LIBS += -L$$top_lib_path/tcl -ltcl8.4
+unix:LIBS += -lz
 win32:LIBS += $$top_lib_path/tcl/tcl84.lib
 
 #unix:
@@ -0,0 +1,349 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <tcl.h>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#ifndef WIN32
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "tcl/batch_runner.h"
+#include "tcl/commands.h"
+#include "utility/file.h"
+#include "utility/log.h"
+#include "utility/memory_sampler.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  extern int registerAllCmds(Tcl_Interp* pInterp);
+
+  namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    bool splitParameter(const std::string& text, std::string& name, std::string& value) {
+      size_t equal = text.find('=');
+      if (equal == std::string::npos || equal == 0)
+        return false;
+      name = text.substr(0, equal);
+      value = text.substr(equal + 1);
+      return true;
+    }
+
+    // "a..b" with integers, or a comma separated list
+    bool expandValues(const std::string& text, std::vector<std::string>& values) {
+      size_t dots = text.find("..");
+      if (dots != std::string::npos) {
+        char* end = NULL;
+        long first = strtol(text.c_str(), &end, 10);
+        if (end != text.c_str() + dots)
+          return false;
+        const char* last_text = text.c_str() + dots + 2;
+        long last = strtol(last_text, &end, 10);
+        if (end == last_text || *end != '\0' || last < first)
+          return false;
+        for (long v = first; v <= last; v++) {
+          values.push_back(std::to_string(v));
+        }
+        return true;
+      }
+      std::stringstream stream(text);
+      std::string value;
+      while (std::getline(stream, value, ',')) {
+        if (!value.empty())
+          values.push_back(value);
+      }
+      return !values.empty();
+    }
+
+    std::string parameterText(const BatchRunner::Job& job) {
+      std::string text;
+      for (size_t i = 0; i < job.parameters.size(); i++) {
+        if (i > 0)
+          text += " ";
+        text += job.parameters[i].first + "=" + job.parameters[i].second;
+      }
+      return text;
+    }
+
+    std::string csvField(const std::string& text) {
+      if (text.find_first_of(",\"\n\r") == std::string::npos)
+        return text;
+      std::string field = "\"";
+      for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '"')
+          field += '"';
+        field += text[i];
+      }
+      field += '"';
+      return field;
+    }
+
+  }
+
+  BatchRunner::BatchRunner() {
+    num_parallel_ = 0;
+    dir_ = "batch";
+  }
+
+  bool BatchRunner::readJobs(const std::string& jobs_file) {
+    std::ifstream in(jobs_file.c_str());
+    if (!in) {
+      eda_error("Could not open the job list %s.\n", jobs_file.c_str());
+      return false;
+    }
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+      line_number++;
+      size_t comment = line.find('#');
+      if (comment != std::string::npos)
+        line.erase(comment);
+      std::stringstream stream(line);
+      Job job;
+      if (!(stream >> job.script))
+        continue;
+      std::string token;
+      while (stream >> token) {
+        std::pair<std::string, std::string> parameter;
+        if (!splitParameter(token, parameter.first, parameter.second)) {
+          eda_error("%s:%d: '%s' is not <name>=<value>.\n", jobs_file.c_str(), line_number, token.c_str());
+          return false;
+        }
+        job.parameters.push_back(parameter);
+      }
+      jobs_.push_back(job);
+    }
+    return true;
+  }
+
+  bool BatchRunner::addSweep(const std::string& script, const std::vector<std::string>& sweeps) {
+    std::vector<Job> combinations(1);
+    combinations[0].script = script;
+    for (const std::string& sweep : sweeps) {
+      std::string name;
+      std::string text;
+      std::vector<std::string> values;
+      if (!splitParameter(sweep, name, text) || !expandValues(text, values)) {
+        eda_error("Bad sweep '%s', use <name>=<first>..<last> or <name>=<value>,<value>,...\n", sweep.c_str());
+        return false;
+      }
+      std::vector<Job> expanded;
+      expanded.reserve(combinations.size() * values.size());
+      for (const Job& job : combinations) {
+        for (const std::string& value : values) {
+          expanded.push_back(job);
+          expanded.back().parameters.push_back(std::make_pair(name, value));
+        }
+      }
+      combinations.swap(expanded);
+    }
+    jobs_.insert(jobs_.end(), combinations.begin(), combinations.end());
+    return true;
+  }
+
+  std::string BatchRunner::jobDir(const Job& job) const {
+    return dir_ + "/" + job.name;
+  }
+
+  int BatchRunner::run(const Console::LogOptions& log_options) {
+#ifdef WIN32
+    (void)log_options;
+    eda_error("Batch mode needs fork(), it is not available on Windows.\n");
+    return static_cast<int>(jobs_.size());
+#else
+    if (jobs_.empty()) {
+      eda_error("The batch has no jobs.\n");
+      return 0;
+    }
+    for (size_t i = 0; i < jobs_.size(); i++) {
+      char name[32];
+      snprintf(name, sizeof(name), "job%04u", static_cast<unsigned>(i + 1));
+      jobs_[i].name = name;
+      // jobs change into their directory
+      if (!jobs_[i].script.empty() && jobs_[i].script[0] != '/') {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd)) != NULL)
+          jobs_[i].script = std::string(cwd) + "/" + jobs_[i].script;
+      }
+    }
+    if (File::access(dir_.c_str(), 0) == -1) {
+      File::mkdir(dir_.c_str());
+    }
+    size_t num_parallel = static_cast<size_t>(num_parallel_ > 0 ? num_parallel_ : numProcessors());
+    if (num_parallel > jobs_.size()) {
+      num_parallel = jobs_.size();
+    }
+    // the parallel readers of a job get its share of the cores
+    int job_processors = numProcessors() / static_cast<int>(num_parallel);
+    eda_info("Running %u jobs, %u at a time, in %s.\n", static_cast<unsigned>(jobs_.size()),
+      static_cast<unsigned>(num_parallel), dir_.c_str());
+
+    std::map<pid_t, size_t> running;
+    std::vector<Clock::time_point> started(jobs_.size());
+    size_t next = 0;
+    size_t num_done = 0;
+    int failed = 0;
+    while (next < jobs_.size() || !running.empty()) {
+      while (next < jobs_.size() && running.size() < num_parallel) {
+        Job& job = jobs_[next];
+        File::mkdir(jobDir(job).c_str());
+        // the child would write what is still buffered a second time
+        fflush(NULL);
+        pid_t pid = fork();
+        if (pid == 0) {
+          set_max_processors(job_processors > 1 ? job_processors : 1);
+          int exit_code = runJob(job, log_options);
+          fflush(NULL);
+          _exit(exit_code);
+        }
+        if (pid < 0) {
+          eda_error("Could not start %s: %s.\n", job.name.c_str(), strerror(errno));
+          failed++;
+          num_done++;
+        } else {
+          started[next] = Clock::now();
+          running[pid] = next;
+        }
+        next++;
+      }
+      if (running.empty())
+        continue;
+      int status = 0;
+      struct rusage usage;
+      pid_t pid = wait4(-1, &status, 0, &usage);
+      if (pid < 0) {
+        if (errno == EINTR)
+          continue;
+        eda_error("Lost track of the running jobs: %s.\n", strerror(errno));
+        break;
+      }
+      std::map<pid_t, size_t>::iterator iter = running.find(pid);
+      if (iter == running.end())
+        continue;
+      Job& job = jobs_[iter->second];
+      job.elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started[iter->second]).count();
+      // kilobytes on Linux
+      job.peak_kb = static_cast<uint32_t>(usage.ru_maxrss);
+      job.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+      std::ifstream result((jobDir(job) + "/result.txt").c_str());
+      std::stringstream text;
+      text << result.rdbuf();
+      job.result = text.str();
+      if (job.exit_code != 0) {
+        failed++;
+      }
+      num_done++;
+      if (WIFSIGNALED(status)) {
+        eda_warning("%s was killed by signal %d.\n", job.name.c_str(), WTERMSIG(status));
+      } else {
+        eda_info("%s finished with exit code %d after %.1fs, %u of %u done.\n", job.name.c_str(), job.exit_code,
+          static_cast<double>(job.elapsed_ms) / 1000.0, static_cast<unsigned>(num_done),
+          static_cast<unsigned>(jobs_.size()));
+      }
+      running.erase(iter);
+    }
+    return failed;
+#endif
+  }
+
+  int BatchRunner::runJob(const Job& job, const Console::LogOptions& log_options) {
+#ifdef WIN32
+    (void)job;
+    (void)log_options;
+    return 1;
+#else
+    if (chdir(jobDir(job).c_str()) != 0)
+      return 1;
+    // Tcl puts and everything else written to the terminal
+    if (freopen("stdout.txt", "w", stdout) != NULL)
+      dup2(fileno(stdout), 2);
+    Console::LogOptions options = log_options;
+    // report() copies the text into the main log
+    options.compress = false;
+    options.max_size_mb = 0;
+    Console::startLogFile("job.log", options);
+    MemorySampler::start();
+
+    Tcl_Interp* interp = Tcl_CreateInterp();
+    int ret = Tcl_Init(interp);
+    if (ret == TCL_OK) {
+      Commands::set_interp(interp);
+      registerAllCmds(interp);
+      for (size_t i = 0; i < job.parameters.size(); i++) {
+        Tcl_SetVar(interp, job.parameters[i].first.c_str(), job.parameters[i].second.c_str(), TCL_GLOBAL_ONLY);
+      }
+      Tcl_SetVar(interp, "batch_job", job.name.c_str(), TCL_GLOBAL_ONLY);
+      eda_info("Running %s as %s %s.\n", job.script.c_str(), job.name.c_str(), parameterText(job).c_str());
+      ret = Tcl_EvalFile(interp, job.script.c_str());
+    }
+    std::string result = Tcl_GetStringResult(interp);
+    if (ret != TCL_OK) {
+      const char* error_info = Tcl_GetVar(interp, "errorInfo", TCL_GLOBAL_ONLY);
+      eda_error("%s\n", error_info != NULL ? error_info : result.c_str());
+    }
+    FILE* fp = fopen("result.txt", "w");
+    if (fp != NULL) {
+      fwrite(result.data(), 1, result.size(), fp);
+      fclose(fp);
+    }
+    MemorySampler::stop();
+    Console::endLogFile();
+    return ret == TCL_OK ? 0 : 1;
+#endif
+  }
+
+  void BatchRunner::report() {
+    for (const Job& job : jobs_) {
+      eda_print("==== %s: %s %s, exit code %d, %.1fs ====\n", job.name.c_str(), job.script.c_str(),
+        parameterText(job).c_str(), job.exit_code, static_cast<double>(job.elapsed_ms) / 1000.0);
+      if (!Console::appendLogFile(jobDir(job) + "/job.log")) {
+        eda_warning("%s left no log.\n", job.name.c_str());
+      }
+    }
+
+    std::string csv_file = dir_ + "/results.csv";
+    FILE* csv = fopen(csv_file.c_str(), "w");
+    if (csv != NULL) {
+      fprintf(csv, "job,script,parameters,exit_code,elapsed_ms,peak_kb,result\n");
+    }
+    int failed = 0;
+    eda_print("%-10s %9s %10s %10s  %s\n", "job", "exit", "time(s)", "peak(MB)", "parameters");
+    for (const Job& job : jobs_) {
+      if (job.exit_code != 0)
+        failed++;
+      eda_print("%-10s %9d %10.1f %10u  %s\n", job.name.c_str(), job.exit_code,
+        static_cast<double>(job.elapsed_ms) / 1000.0, job.peak_kb / 1024, parameterText(job).c_str());
+      if (csv != NULL) {
+        fprintf(csv, "%s,%s,%s,%d,%lld,%u,%s\n", job.name.c_str(), csvField(job.script).c_str(),
+          csvField(parameterText(job)).c_str(), job.exit_code, static_cast<long long>(job.elapsed_ms),
+          job.peak_kb, csvField(job.result).c_str());
+      }
+    }
+    if (csv != NULL) {
+      fclose(csv);
+    }
+    if (failed > 0) {
+      eda_error("%d of %u jobs failed, see %s.\n", failed, static_cast<unsigned>(jobs_.size()), csv_file.c_str());
+    } else {
+      eda_info("All %u jobs succeeded, see %s.\n", static_cast<unsigned>(jobs_.size()), csv_file.c_str());
+    }
+  }
+
+}
@@ -2,13 +2,10 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <stdlib.h>
-#ifndef WIN32
-#include <unistd.h>
-#endif
 #include <string.h>
 #include <assert.h>
 #include <iostream>
@@ -17,6 +14,9 @@
 #include "utility/log.h"
 #include "utility/assert.h"
 #include "utility/data_var.h"
+#include "utility/log_queue.h"
+#include "utility/memory_sampler.h"
+#include "utility/tracer.h"
 
 namespace eda {
 
@@ -34,12 +34,20 @@ namespace eda {
     options_.push_back(cmd_options);
     cmd_funcs_.push_back(cmd_func);
 
-    //register options
-    std::string arguments;
-    std::vector<Option> options;
-    splitString(cmd_options, arguments, options);
-    cmd_opts_.insert(std::pair<std::string, std::vector<Option>>(cmd_name, options));
-    cmd_args_.insert(std::pair<std::string, std::string>(cmd_name, arguments));
+    //compile the options once, every run of the command only looks them up
+    CommandSpec& spec = specs_[cmd_name];
+    spec = CommandSpec();
+    spec.function = cmd_func;
+    spec.option_text = cmd_options;
+    splitString(cmd_options, spec.arguments, spec.options);
+    std::vector<std::string> arguments;
+    splitString(spec.arguments, arguments);
+    spec.num_arguments = static_cast<int>(arguments.size());
+    spec.option_specs.resize(spec.options.size());
+    for (size_t i = 0; i < spec.options.size(); i++) {
+      compileOption(spec.options[i].regex, spec.option_specs[i]);
+      spec.option_index.insert(std::make_pair(spec.options[i].option, static_cast<int>(i)));
+    }
 
     //register cmd_name and cmd_func with tclsh
     Tcl_CreateObjCommand(interp, cmd_name.c_str(), cmd_func, (ClientData)NULL, (Tcl_CmdDeleteProc*)NULL);
@@ -72,16 +80,18 @@ namespace eda {
     return idx;
   }
   char* Commands::getObject(Tcl_Obj* const objv[], const char* obj_name) {
-    const std::string command_name = std::string(Tcl_GetString(objv[0]));
-    for (int i = 0; i < numCmds(); i++) {
-      if (commands(i) == command_name) {
-        const int obj_idx = getObjectIndex(options(i).c_str(), obj_name);
-        if (obj_idx >= 0) {
-          return Tcl_GetString(objv[obj_idx + 1]);
-        } else {
-          return NULL;
-        }
-      }
+    std::unordered_map<std::string, CommandSpec>::iterator iter = specs_.find(Tcl_GetString(objv[0]));
+    if (iter == specs_.end()) {
+      return NULL;
+    }
+    CommandSpec& spec = iter->second;
+    std::unordered_map<std::string, int>::iterator object = spec.object_index.find(obj_name);
+    if (object == spec.object_index.end()) {
+      int obj_idx = getObjectIndex(spec.option_text.c_str(), obj_name);
+      object = spec.object_index.insert(std::make_pair(std::string(obj_name), obj_idx)).first;
+    }
+    if (object->second >= 0) {
+      return Tcl_GetString(objv[object->second + 1]);
     }
     return NULL;
   }
@@ -204,20 +214,14 @@ namespace eda {
         if (commands_[i].substr(0, 4) == "test") {
           continue;
         }
-        std::string argument;
-        std::map<std::string, std::string>::const_iterator it = cmd_args_.find(commands_[i]);
-        if (it != cmd_args_.end()) {
-          argument = it->second;
-        }
+        const CommandSpec* spec = findSpec(commands_[i]);
+        std::string argument = spec != NULL ? spec->arguments : "";
         std::string option = visibleOption(commands_[i], opt_name);
         eda_info("  Command name : %s\n", commands_[i].c_str());
         eda_info("  Option: %s %s\n", argument.c_str(), option.c_str());
       } else if (commands_[i] == cmd_name) {
-        std::string argument;
-        std::map<std::string, std::string>::const_iterator it = cmd_args_.find(cmd_name);
-        if (it != cmd_args_.end()) {
-          argument = it->second;
-        }
+        const CommandSpec* spec = findSpec(cmd_name);
+        std::string argument = spec != NULL ? spec->arguments : "";
         std::string option = visibleOption(cmd_name, opt_name);
         eda_info("  Command name : %s\n", commands_[i].c_str());
         eda_info("  Option: %s %s\n", argument.c_str(), option.c_str());
@@ -230,11 +234,7 @@ namespace eda {
     if (cmd_name.length() == 0) {
       return "";
     }
-    std::map<std::string, std::vector<Option> >::const_iterator it = cmd_opts_.find(cmd_name);
-    std::vector<Option> options;
-    if (it != cmd_opts_.end()) {
-      options = it->second;
-    }
+    const std::vector<Option>& options = command_options(cmd_name);
     std::string option_str;
     int option_cnt = (int)options.size();
     for (int i = 0; i < option_cnt; ++i) {
@@ -266,182 +266,218 @@ namespace eda {
       gCommands.printHelp(objv);
       return false;
     }
-    DataVar::cmd_started_ = true;
-#ifndef WIN32
-    usleep(2000);
-#endif
     if (!checkArguments(objc, objv) || !checkOptions(objc, objv)) {
       return false;
     }
     //FIXME
     //check stages
-    if (verbose_) {
+    // the synchronous samples cost a lock and a read of the process memory,
+    // too much for many small commands with profiling off
+    memory_sampled_ = profile_level_ >= PROFILE_MEMORY;
+    if (memory_sampled_)
+      MemorySampler::beginCommand(Tcl_GetString(objv[0]));
+    LogQueue::beginCommand();
+    Tracer::begin(Tracer::intern(Tcl_GetString(objv[0])), "command");
+    memory_begin_ = DataVar::current_used_memory_.load();
+    if (profile_level_ >= PROFILE_TIMING) {
       DataVar::time_.getProcessCpuTime(&tp_begin_);
       DataVar::time_.getElapsedTime(&time_begin_);
-      memory_begin_ = DataVar::current_used_memory_;
     }
     return true;
   }
-  bool Commands::postRun(int objc, Tcl_Obj* const objv[]) {
-    std::string cmd_full_name;
-    Commands::getFullName(objc, objv, cmd_full_name);
-    if (verbose_) {
+  bool Commands::postRun(int, Tcl_Obj* const objv[]) {
+    if (profile_level_ >= PROFILE_TIMING) {
       DataVar::time_.getElapsedTime(&time_end_);
       DataVar::time_.getProcessCpuTime(&tp_end_);
+    }
+    bool memory_sampled = memory_sampled_;
+    if (memory_sampled) {
+      MemorySampler::endCommand();
+      memory_sampled_ = false;
+    }
+    if (profile_level_ >= PROFILE_TIMING) {
       char* cmd_name = Tcl_GetString(objv[0]);
-#ifndef WIN32
-      usleep(6000);
-#endif
       eda_print_cmd_profile(cmd_name, time_begin_, time_end_, tp_begin_, tp_end_);
-      int cmd_used_mem = DataVar::cmd_peak_used_memory_ - memory_begin_;
-      eda_info("*INFO*: %s used memory %dMb, firrtlsyn used peak memory %dMb, current used memory %dMb.\n", cmd_name, cmd_used_mem, DataVar::eda_peak_used_memory_, DataVar::current_used_memory_);
+      if (memory_sampled) {
+        int cmd_used_mem = DataVar::cmd_peak_used_memory_.load() - memory_begin_;
+        eda_info("*INFO*: %s used memory %dMb, firrtlsyn used peak memory %dMb, current used memory %dMb.\n", cmd_name, cmd_used_mem, DataVar::eda_peak_used_memory_.load(), DataVar::current_used_memory_.load());
+      }
     }
-    DataVar::cmd_started_ = false;
-#ifndef WIN32
-    usleep(2000);
-#endif // !WIN32
+    Tracer::end();
+    LogQueue::endCommand();
+    // Tcl writes its own output straight to stdout
+    Console::flush();
     return true;
   }
   bool Commands::checkArguments(int objc, Tcl_Obj* const objv[]) {
     char* cmd_name = Tcl_GetString(objv[0]);
-    std::map<std::string, std::string>::iterator it = cmd_args_.find(cmd_name);
-    std::string argument;
-    if (it != cmd_args_.end()) {
-      argument = it->second;
-    }
-    std::vector<std::string> regex;
-    splitString(argument, regex);
-    int required_args_num = static_cast<int> (regex.size());
+    const CommandSpec* spec = findSpec(cmd_name);
+    int required_args_num = spec != NULL ? spec->num_arguments : 0;
+    if (required_args_num == 0) {
+      return true;
+    }
     int given_args_num = 0;
-    std::string para;
     for (int i = 1; i < objc; ++i) {
-      char* opt_name = Tcl_GetString(objv[i]);
-      if (!isSeparator(opt_name)) {
+      if (!isSeparator(Tcl_GetString(objv[i]))) {
         given_args_num++;
-        para += opt_name[0];
-        para += " ";
       }
     }
     if (given_args_num < required_args_num) {
+      std::string para;
+      for (int i = 1; i < objc; ++i) {
+        char* opt_name = Tcl_GetString(objv[i]);
+        if (!isSeparator(opt_name)) {
+          para += opt_name[0];
+          para += " ";
+        }
+      }
       eda_error("  Invalid option arguments: %s\n", para.c_str());
       printHelp(cmd_name);
       return false;
     }
     return true;
   }
-  bool Commands::matchRegex(const std::string& para, const std::string& regex) {
-    std::string str = trimString(para);
+  void Commands::compileOption(const std::string& regex, OptionSpec& spec) {
+    spec.kind = OptionSpec::VALUE_NONE;
+    spec.braced = false;
+    spec.field_types.clear();
+    spec.words.clear();
     std::string rgx = trimString(regex);
     if (rgx.length() == 0) {
-      if (str.length() == 0) {
-        return true;
-      } else {
-        return false;
-      }
+      return;
     }
     if (rgx[0] == '{') {
+      spec.braced = true;
       if (rgx[rgx.length() - 1] != '}') {
-        return false;
+        spec.kind = OptionSpec::VALUE_INVALID;
+        return;
       }
-      str = trimString(str, "{", "}");
       rgx = trimString(rgx, "{", "}");
     }
-    std::vector<std::string> str_v;
-    splitString(str, str_v, " ");
     std::vector<std::string> rgx_v;
     splitString(rgx, rgx_v, " ");
-    int str_v_size = static_cast<int> (str_v.size());
-    int rgx_v_size = static_cast<int> (rgx_v.size());
+    if (rgx_v.empty()) {
+      return;
+    }
     if (rgx[0] == '<') {
-      if (rgx_v_size == 1) {
-        std::string tmp = trimString(rgx_v[0], "<", ">");
-        if (tmp == "string") {
-          if (isValidString(str)) {
-            return true;
-          }
-        }
-      }
-      if (str_v_size != rgx_v_size) {
-        return false;
+      if (rgx_v.size() == 1 && trimString(rgx_v[0], "<", ">") == "string") {
+        spec.kind = OptionSpec::VALUE_STRING;
+        return;
       }
-    }
-    for (int i = 0; i < rgx_v_size; ++i) {
-      if (rgx_v[i][0] == '<') {
+      spec.kind = OptionSpec::VALUE_FIELDS;
+      for (size_t i = 0; i < rgx_v.size(); ++i) {
         std::string tmp = trimString(rgx_v[i], "<", ">");
         if (tmp == "int") {
-          if (!isValidInt(str_v[i])) {
-            return false;
-          }
+          spec.field_types += 'i';
         } else if (tmp == "double" || tmp == "float") {
-          if (!isValidDouble(str_v[i])) {
-            return false;
-          }
+          spec.field_types += 'd';
         } else if (tmp == "string") {
-          if (!isValidString(str_v[i])) {
-            return false;
-          }
+          spec.field_types += 's';
         } else {
           eda_warning("Unsupport data type %s\n", tmp.c_str());
+          spec.field_types += '?';
         }
-      } else {
-        eda_assert(rgx_v_size == 1);
-        std::vector<std::string> tmp;
-        splitString(rgx_v[i], tmp, "|");
-        int tmp_size = static_cast<int> (tmp.size());
-        for (int j = 0; j < str_v_size; ++j) {
-          bool isValid = false;
-          for (int k = 0; k < tmp_size; ++k) {
-            if (str_v[j] == tmp[k]) {
-              isValid = true;
-            }
-          }
-          if (!isValid) {
-            return false;
-          }
+      }
+    } else {
+      eda_assert(rgx_v.size() == 1);
+      spec.kind = OptionSpec::VALUE_WORDS;
+      splitString(rgx_v[0], spec.words, "|");
+    }
+  }
+  bool Commands::matchOption(const OptionSpec& spec, Tcl_Obj* const objv[], int count) {
+    if (spec.kind == OptionSpec::VALUE_NONE) {
+      return count == 0;
+    }
+    if (spec.kind == OptionSpec::VALUE_INVALID) {
+      return false;
+    }
+    if (spec.kind == OptionSpec::VALUE_STRING && !spec.braced) {
+      return count > 0;
+    }
+    //split the values into words without copying them
+    words_.clear();
+    for (int i = 0; i < count; ++i) {
+      const char* p = Tcl_GetString(objv[i]);
+      while (*p != '\0') {
+        while (*p == ' ') p++;
+        const char* word = p;
+        while (*p != '\0' && *p != ' ') p++;
+        if (p > word) {
+          words_.push_back(std::make_pair(word, static_cast<size_t>(p - word)));
         }
       }
     }
-    return true;
+    if (spec.braced && !words_.empty()) {
+      std::pair<const char*, size_t>& first = words_.front();
+      while (first.second > 0 && first.first[0] == '{') {
+        first.first++;
+        first.second--;
+      }
+      std::pair<const char*, size_t>& last = words_.back();
+      while (last.second > 0 && last.first[last.second - 1] == '}') {
+        last.second--;
+      }
+      if (words_.back().second == 0) words_.pop_back();
+      if (!words_.empty() && words_.front().second == 0) words_.erase(words_.begin());
+    }
+    switch (spec.kind) {
+    case OptionSpec::VALUE_STRING:
+      return !words_.empty();
+    case OptionSpec::VALUE_FIELDS:
+      if (words_.size() != spec.field_types.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < words_.size(); ++i) {
+        char type = spec.field_types[i];
+        if ((type == 'i' && !isValidInt(words_[i].first, words_[i].second)) ||
+          (type == 'd' && !isValidDouble(words_[i].first, words_[i].second))) {
+          return false;
+        }
+      }
+      return true;
+    case OptionSpec::VALUE_WORDS:
+      for (size_t i = 0; i < words_.size(); ++i) {
+        bool isValid = false;
+        for (size_t k = 0; k < spec.words.size() && !isValid; ++k) {
+          isValid = spec.words[k].length() == words_[i].second &&
+            strncmp(spec.words[k].c_str(), words_[i].first, words_[i].second) == 0;
+        }
+        if (!isValid) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return false;
+    }
   }
   bool Commands::checkOptions(int objc, Tcl_Obj* const objv[]) {
     char* cmd_name = Tcl_GetString(objv[0]);
-    std::map<std::string, std::vector<Option> >::iterator it = cmd_opts_.find(cmd_name);
-    std::vector<Option> options;
-    if (it != cmd_opts_.end()) {
-      options = it->second;
-    }
+    const CommandSpec* spec = findSpec(cmd_name);
     for (int i = 1; i < objc; ++i) {
       char* opt_name = Tcl_GetString(objv[i]);
       if (!isSeparator(opt_name))
         continue;
-      std::string para = "";
-      while (++i < objc) {
-        char* para_name = Tcl_GetString(objv[i]);
-        if (isSeparator(para_name)) {
-          --i;
-          break;
-        }
-        para += " ";
-        para += para_name;
-      }
-      std::string opt(opt_name);
-      std::vector<Option>::iterator iter = options.begin();
-      for (iter = options.begin(); iter != options.end(); ++iter) {
-        if (iter->option == opt) {
-          if (matchRegex(para, iter->regex)) {
-            break;
-          } else {
-            eda_error("  Invalid option arguments: %s\n", para.c_str());
-            printHelp(cmd_name, opt_name);
-            return false;
-          }
-        }
+      int first = i + 1;
+      while (i + 1 < objc && !isSeparator(Tcl_GetString(objv[i + 1]))) {
+        ++i;
       }
-      if (iter == options.end()) {
+      std::unordered_map<std::string, int>::const_iterator iter;
+      if (spec == NULL || (iter = spec->option_index.find(opt_name)) == spec->option_index.end()) {
         eda_error("  Invalid option name: %s\n", opt_name);
         printHelp(cmd_name);
         return false;
       }
+      if (!matchOption(spec->option_specs[iter->second], objv + first, i + 1 - first)) {
+        std::string para = "";
+        for (int k = first; k <= i; ++k) {
+          para += " ";
+          para += Tcl_GetString(objv[k]);
+        }
+        eda_error("  Invalid option arguments: %s\n", para.c_str());
+        printHelp(cmd_name, opt_name);
+        return false;
+      }
     }
     return true;
   }
@@ -514,40 +550,32 @@ namespace eda {
     }
     return str.substr(pos);
   }
-  bool Commands::isValidInt(std::string opt) {
-    int len = static_cast<int> (opt.length());
-    if (len == 0) {
+  bool Commands::isValidInt(const char* opt, size_t length) {
+    if (length == 0) {
       return false;
     }
-    int i = 0;
+    size_t i = 0;
     if (opt[0] == '-')
       ++i;
-    for (; i < len; ++i) {
-      if (!isdigit(opt[i])) {
+    for (; i < length; ++i) {
+      if (!isdigit(static_cast<unsigned char>(opt[i]))) {
         return false;
       }
     }
     return true;
   }
-  bool Commands::isValidDouble(std::string opt) {
-    int len = static_cast<int> (opt.length());
-    if (len == 0) {
+  bool Commands::isValidDouble(const char* opt, size_t length) {
+    if (length == 0) {
       return false;
     }
-    int i = 0;
+    size_t i = 0;
     if (opt[0] == '-')
       ++i;
-    for (; i < len; ++i) {
-      if (!isdigit(opt[i]) && (opt[i] != '.')) {
+    for (; i < length; ++i) {
+      if (!isdigit(static_cast<unsigned char>(opt[i])) && (opt[i] != '.')) {
         return false;
       }
     }
     return true;
   }
-  bool Commands::isValidString(std::string opt) {
-    if (opt.length() == 0) {
-      return false;
-    }
-    return true;
-  }
-}
\ No newline at end of file
+}
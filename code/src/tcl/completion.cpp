@@ -0,0 +1,254 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include "tcl/commands.h"
+#include "tcl/completion.h"
+#include "design/design.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  CommandCompletion gCompletion;
+
+  namespace {
+
+    // adds the words of the Tcl list script evaluates to
+    void addTclList(Tcl_Interp* interp, const char* script, CompletionIndex& index) {
+      if (Tcl_Eval(interp, script) != TCL_OK)
+        return;
+      int count = 0;
+      Tcl_Obj** elements = NULL;
+      if (Tcl_ListObjGetElements(interp, Tcl_GetObjResult(interp), &count, &elements) != TCL_OK)
+        return;
+      for (int i = 0; i < count; i++) {
+        int length = 0;
+        const char* word = Tcl_GetStringFromObj(elements[i], &length);
+        index.add(word, static_cast<size_t>(length));
+      }
+    }
+
+  }
+
+  CommandCompletion::CommandCompletion() {
+    objects_generation_ = 0;
+    stopping_ = false;
+    thread_started_ = false;
+  }
+
+  CommandCompletion::~CommandCompletion() {
+    if (thread_started_) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        work_.notify_one();
+      }
+      pthread_join(thread_, NULL);
+    }
+  }
+
+  void CommandCompletion::indexInterp(Tcl_Interp* interp) {
+    std::shared_ptr<CompletionIndex> commands(new CompletionIndex());
+    std::shared_ptr<CompletionIndex> options(new CompletionIndex());
+    std::shared_ptr<CompletionIndex> variables(new CompletionIndex());
+    commands->add("ls");
+    for (int i = 0; i < gCommands.numCmds(); i++) {
+      const std::string name = gCommands.commands(i);
+      commands->add(name);
+      const std::vector<Commands::Option>& command_options = gCommands.command_options(name);
+      for (size_t o = 0; o < command_options.size(); o++) {
+        options->add(name + " " + command_options[o].option);
+      }
+    }
+    if (interp != NULL) {
+      // the result of the command that just ran is still to be read
+      Tcl_SavedResult saved;
+      Tcl_SaveResult(interp, &saved);
+      addTclList(interp, "info commands", *commands);
+      addTclList(interp, "info vars", *variables);
+      Tcl_RestoreResult(interp, &saved);
+    }
+    commands->build();
+    options->build();
+    variables->build();
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_ = commands;
+    options_ = options;
+    variables_ = variables;
+  }
+
+  void CommandCompletion::indexDesign(const Design* design) {
+    std::shared_ptr<CompletionIndex> objects;
+    if (design != NULL) {
+      // every name once, by string ID
+      const StringPool& strings = design->strings();
+      std::vector<bool> used(strings.size(), false);
+      auto mark = [&](StringPool::Id id) {
+        if (id != StringPool::kInvalidId)
+          used[id] = true;
+      };
+      for (uint32_t i = 0; i < design->numCells(); i++) {
+        mark(design->cell(i).name);
+      }
+      for (uint32_t i = 0; i < design->numPorts(); i++) {
+        mark(design->port(i).name);
+      }
+      for (uint32_t i = 0; i < design->numInstances(); i++) {
+        mark(design->instance(i).name);
+      }
+      for (uint32_t i = 0; i < design->numNets(); i++) {
+        mark(design->net(i).name);
+      }
+      for (uint32_t i = 0; i < design->numPins(); i++) {
+        mark(design->pin(i).name);
+      }
+      size_t num_words = 0;
+      size_t num_bytes = 0;
+      for (StringPool::Id id = 0; id < strings.size(); id++) {
+        if (used[id]) {
+          num_words++;
+          num_bytes += strings.length(id);
+        }
+      }
+      objects.reset(new CompletionIndex());
+      objects->reserve(num_words, num_bytes);
+      for (StringPool::Id id = 0; id < strings.size(); id++) {
+        if (used[id])
+          objects->add(strings.str(id), strings.length(id));
+      }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    // the names of the previous design must not complete meanwhile
+    objects_.reset();
+    objects_generation_++;
+    pending_objects_ = objects;
+    if (!objects)
+      return;
+    if (!thread_started_) {
+      thread_started_ = pthread_create(&thread_, NULL, indexerThread, this) == 0;
+      if (!thread_started_) {
+        // sorted here then
+        pending_objects_.reset();
+        uint64_t generation = objects_generation_;
+        lock.unlock();
+        objects->build();
+        lock.lock();
+        if (generation == objects_generation_)
+          objects_ = objects;
+        return;
+      }
+    }
+    work_.notify_one();
+  }
+
+  void* CommandCompletion::indexerThread(void* data) {
+    Tracer::set_thread_name("completion indexer");
+    static_cast<CommandCompletion*>(data)->buildObjects();
+    return NULL;
+  }
+
+  void CommandCompletion::buildObjects() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      while (!pending_objects_ && !stopping_) {
+        work_.wait(lock);
+      }
+      if (stopping_)
+        break;
+      std::shared_ptr<CompletionIndex> objects;
+      objects.swap(pending_objects_);
+      uint64_t generation = objects_generation_;
+      lock.unlock();
+      objects->build();
+      lock.lock();
+      // dropped if another design was set while sorting
+      if (generation == objects_generation_)
+        objects_ = objects;
+    }
+  }
+
+  std::string CommandCompletion::commandOf(const std::string& line, size_t start) {
+    size_t i = start;
+    while (i > 0 && (line[i - 1] == ' ' || line[i - 1] == '\t')) {
+      i--;
+    }
+    if (i == 0 || line[i - 1] == '[' || line[i - 1] == ';')
+      return std::string();
+    // back to the start of the command, over nested [...]
+    int depth = 0;
+    while (i > 0) {
+      char c = line[i - 1];
+      if (c == ']') {
+        depth++;
+      } else if (c == '[') {
+        if (depth == 0)
+          break;
+        depth--;
+      } else if (c == ';' && depth == 0) {
+        break;
+      }
+      i--;
+    }
+    while (i < start && (line[i] == ' ' || line[i] == '\t')) {
+      i++;
+    }
+    size_t end = i;
+    while (end < start && line[end] != ' ' && line[end] != '\t') {
+      end++;
+    }
+    return line.substr(i, end - i);
+  }
+
+  void CommandCompletion::collect(const CompletionIndex& index, const std::string& prefix, size_t skip,
+    const std::string& insert, Result& result) {
+    size_t begin = 0;
+    size_t end = 0;
+    index.find(prefix.data(), prefix.size(), begin, end);
+    result.num_matches = end - begin;
+    if (begin == end)
+      return;
+    result.common = insert + std::string(index.word(begin) + skip, index.commonLength(begin, end) - skip);
+    for (size_t i = begin; i < end && result.matches.size() < kMaxMatches; i++) {
+      result.matches.push_back(insert + (index.word(i) + skip));
+    }
+  }
+
+  bool CommandCompletion::complete(const std::string& line, size_t start, size_t end, Result& result) const {
+    result.common.clear();
+    result.matches.clear();
+    result.num_matches = 0;
+    if (start > end || end > line.size())
+      return false;
+    const std::string word = line.substr(start, end - start);
+    const std::string command = commandOf(line, start);
+    IndexPtr index;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (command.empty()) {
+        index = commands_;
+      } else if (!word.empty() && word[0] == '-') {
+        index = options_;
+      } else if (!word.empty() && word[0] == '$') {
+        index = variables_;
+      } else if (!word.empty()) {
+        index = objects_;
+      }
+    }
+    if (!index)
+      return false;
+    if (command.empty()) {
+      collect(*index, word, 0, std::string(), result);
+    } else if (word[0] == '-') {
+      collect(*index, command + " " + word, command.size() + 1, std::string(), result);
+    } else if (word[0] == '$') {
+      collect(*index, word.substr(1), 0, "$", result);
+    } else {
+      collect(*index, word, 0, std::string(), result);
+    }
+    return result.num_matches > 0;
+  }
+
+}
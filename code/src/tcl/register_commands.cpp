@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <tcl.h>
@@ -11,11 +11,39 @@
 
 namespace eda {
   extern int DeviceEditor(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int BuildDeviceDB(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int SetDeviceCache(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int BuildDeviceFabric(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int ReadXdl(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int ReadEdif(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int ReadBlif(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int ReadSnapshot(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int SetVerbose(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int ReportMemoryTrace(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int MemoryReport(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int FindLog(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int WriteTrace(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int Highlight(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
+  extern int Unhighlight(ClientData data, Tcl_Interp* interp, int objc, Tcl_Obj* const objv[]);
   Commands gCommands;
 
   int registerAllCmds(Tcl_Interp* interp) {
     Commands::set_interp(interp);
     gCommands.register_cmd(interp, "device_editor", "", DeviceEditor);
+    gCommands.register_cmd(interp, "build_device_db", "-input <string> -output <string>", BuildDeviceDB);
+    gCommands.register_cmd(interp, "set_device_cache", "-size <int>", SetDeviceCache);
+    gCommands.register_cmd(interp, "build_device_fabric", "-input <string> -output <string> -routing <string>", BuildDeviceFabric);
+    gCommands.register_cmd(interp, "read_xdl", "-file <string>", ReadXdl);
+    gCommands.register_cmd(interp, "read_edif", "-file <string> -threads <int>", ReadEdif);
+    gCommands.register_cmd(interp, "read_blif", "-file <string> -threads <int>", ReadBlif);
+    gCommands.register_cmd(interp, "read_snapshot", "", ReadSnapshot);
+    gCommands.register_cmd(interp, "set_verbose", "-level off|timing|memory", SetVerbose);
+    gCommands.register_cmd(interp, "report_memory_trace", "-file <string>", ReportMemoryTrace);
+    gCommands.register_cmd(interp, "memory_report", "", MemoryReport);
+    gCommands.register_cmd(interp, "find_log", "-pattern <string> -regexp -nocase -max <int> -file <string>", FindLog);
+    gCommands.register_cmd(interp, "write_trace", "-file <string> -clear", WriteTrace);
+    gCommands.register_cmd(interp, "highlight", "-net <string> -cell <string> -tile <string> -region <string> -color <string>", Highlight);
+    gCommands.register_cmd(interp, "unhighlight", "-net <string> -cell <string> -tile <string> -region <string> -all", Unhighlight);
     
     return TCL_OK;
   }
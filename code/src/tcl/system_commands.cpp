@@ -0,0 +1,213 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "tcl/commands.h"
+#include "utility/data_var.h"
+#include "utility/file.h"
+#include "utility/log.h"
+#include "utility/log_index.h"
+#include "utility/memory_sampler.h"
+#include "utility/memory_tracker.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  // set_verbose [-level off|timing|memory]
+  // Sets what every command reports when it ends: nothing, its run time, or
+  // its run time and memory. Memory is the default, it also keeps the memory
+  // trace of report_memory_trace. Without -level prints the current level.
+  int SetVerbose(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    static const char* const kLevelNames[] = { "off", "timing", "memory" };
+    std::string level;
+    if (!Commands::getStringOption(objc, objv, "-level", level)) {
+      eda_info("Verbose level is %s.\n", kLevelNames[gCommands.profile_level()]);
+      gCommands.postRun(objc, objv);
+      return TCL_OK;
+    }
+    if (level == "off") {
+      gCommands.set_verbose(Commands::PROFILE_OFF);
+    } else if (level == "timing") {
+      gCommands.set_verbose(Commands::PROFILE_TIMING);
+    } else {
+      gCommands.set_verbose(Commands::PROFILE_MEMORY);
+    }
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // report_memory_trace [-file <string>]
+  // Prints the memory of the last commands, -file also writes all of their
+  // samples as "command,time_ms,rss_kb" lines.
+  int ReportMemoryTrace(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    std::vector<MemorySampler::Trace> traces = MemorySampler::traces();
+    std::string file_name;
+    if (Commands::getStringOption(objc, objv, "-file", file_name)) {
+      FILE* file = fopen(file_name.c_str(), "w");
+      if (file == NULL) {
+        eda_error("Could not open %s for writing.\n", file_name.c_str());
+        gCommands.postRun(objc, objv);
+        return TCL_ERROR;
+      }
+      fprintf(file, "command,time_ms,rss_kb\n");
+      for (const MemorySampler::Trace& trace : traces) {
+        for (const MemorySampler::Sample& sample : trace.samples) {
+          fprintf(file, "%s,%u,%u\n", trace.command.c_str(), sample.time_ms, sample.rss_kb);
+        }
+      }
+      fclose(file);
+    }
+
+    eda_print("%-24s %10s %10s %10s %10s %8s\n", "command", "time(ms)", "begin(KB)", "peak(KB)", "end(KB)", "samples");
+    for (const MemorySampler::Trace& trace : traces) {
+      eda_print("%-24s %10u %10u %10u %10u %8u\n", trace.command.c_str(), trace.elapsed_ms,
+        trace.begin_kb, trace.peak_kb, trace.end_kb, static_cast<unsigned>(trace.samples.size()));
+    }
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // memory_report
+  // Prints the heap used per subsystem. The counters are only kept when the
+  // process was started with EDA_MEMORY_TRACKING=1.
+  int MemoryReport(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    MemorySampler::sample();
+    if (!MemoryTracker::enabled()) {
+      eda_info("Heap tracking is off, restart with EDA_MEMORY_TRACKING=1 to enable it. Resident memory %dMB.\n",
+        DataVar::current_used_memory_.load());
+      gCommands.postRun(objc, objv);
+      return TCL_OK;
+    }
+    std::vector<MemoryTracker::Usage> usage;
+    MemoryTracker::usage(usage);
+    int64_t total_bytes = 0;
+    eda_print("%-10s %12s %12s %14s %14s\n", "tag", "current(KB)", "peak(KB)", "allocations", "frees");
+    for (int t = 0; t < MemoryTracker::NUM_TAGS; t++) {
+      const MemoryTracker::Usage& u = usage[t];
+      total_bytes += u.bytes;
+      eda_print("%-10s %12lld %12lld %14llu %14llu\n", MemoryTracker::tagName(static_cast<MemoryTracker::Tag>(t)),
+        static_cast<long long>(u.bytes / 1024), static_cast<long long>(u.peak_bytes / 1024),
+        static_cast<unsigned long long>(u.allocations), static_cast<unsigned long long>(u.frees));
+    }
+    // the rest of the resident memory: code, stacks and what Tcl and the C
+    // libraries allocate with malloc directly
+    long long resident_kb = static_cast<long long>(DataVar::current_used_memory_.load()) * 1024;
+    eda_print("%-10s %12lld\n", "heap", static_cast<long long>(total_bytes / 1024));
+    eda_print("%-10s %12lld\n", "untracked", resident_kb > total_bytes / 1024 ? resident_kb - total_bytes / 1024 : 0);
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // find_log -pattern <string> [-regexp] [-nocase] [-max <int>] [-file <string>]
+  // Prints the lines of the log containing the pattern, at most -max of them
+  // (100 by default). -regexp takes the pattern as a regular expression.
+  // The open log is searched unless -file names another one, whose index is
+  // then built and saved next to it if there is none yet.
+  int FindLog(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    std::string pattern;
+    std::string file_name;
+    int max_matches = 100;
+    int flags = 0;
+    Commands::getStringOption(objc, objv, "-pattern", pattern);
+    Commands::getIntOption(objc, objv, "-max", max_matches);
+    if (Commands::isOptionUsed(objc, objv, "-regexp"))
+      flags |= LogIndex::SEARCH_REGEX;
+    if (Commands::isOptionUsed(objc, objv, "-nocase"))
+      flags |= LogIndex::SEARCH_IGNORE_CASE;
+    if (pattern.empty() || max_matches <= 0) {
+      eda_error("A pattern and a positive -max are required.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+
+    LogIndex other_log;
+    LogIndex* index = &Console::log_index();
+    if (Commands::getStringOption(objc, objv, "-file", file_name) && file_name != Console::logfile_name()) {
+      if (File::size(file_name.c_str()) < 0) {
+        eda_error("Could not open %s.\n", file_name.c_str());
+        gCommands.postRun(objc, objv);
+        return TCL_ERROR;
+      }
+      if (!other_log.open(file_name) && !other_log.save()) {
+        eda_warning("Could not save the index of %s.\n", file_name.c_str());
+      }
+      index = &other_log;
+    } else if (index->log_file().empty()) {
+      eda_error("The log file is not open or compressed, it has no index.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    } else {
+      // everything printed so far has to be in the file
+      Console::flush();
+    }
+
+    std::vector<LogIndex::Match> matches;
+    std::string error;
+    if (!index->search(pattern, flags, static_cast<size_t>(max_matches), matches, error)) {
+      eda_error("%s.\n", error.c_str());
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    for (const LogIndex::Match& match : matches) {
+      eda_print("%u: %s\n", match.line + 1, match.text.c_str());
+    }
+    eda_info("%u matching lines in %s.\n", static_cast<unsigned>(matches.size()), index->log_file().c_str());
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+  // write_trace [-file <string>] [-clear]
+  // Writes the timeline of the commands, threads, memory and progress in the
+  // Chrome trace format, for chrome://tracing or ui.perfetto.dev. -clear
+  // drops what was recorded so far, after writing it if -file is given too.
+  int WriteTrace(ClientData, Tcl_Interp*, int objc, Tcl_Obj* const objv[]) {
+    if (!gCommands.preRun(objc, objv)) {
+      return TCL_ERROR;
+    }
+    std::string file_name;
+    bool clear = Commands::isOptionUsed(objc, objv, "-clear");
+    if (!Commands::getStringOption(objc, objv, "-file", file_name) && !clear) {
+      eda_error("Either -file or -clear is required.\n");
+      gCommands.postRun(objc, objv);
+      return TCL_ERROR;
+    }
+    if (!file_name.empty()) {
+      size_t num_events = 0;
+      if (!Tracer::writeChromeTrace(file_name, num_events)) {
+        eda_error("Could not write %s.\n", file_name.c_str());
+        gCommands.postRun(objc, objv);
+        return TCL_ERROR;
+      }
+      eda_info("%u trace events written to %s.\n", static_cast<unsigned>(num_events), file_name.c_str());
+      if (Tracer::numDropped() > 0) {
+        eda_warning("%llu events were dropped, a thread filled its trace buffer.\n",
+          static_cast<unsigned long long>(Tracer::numDropped()));
+      }
+    }
+    if (clear) {
+      Tracer::clear();
+    }
+    gCommands.postRun(objc, objv);
+    return TCL_OK;
+  }
+
+}
@@ -5,8 +5,13 @@
 TEMPLATE = lib
 CONFIG += staticlib
 
-HEADERS += $$top_srcdir/include/tcl/commands.h
+HEADERS += $$top_srcdir/include/tcl/commands.h \
+           $$top_srcdir/include/tcl/batch_runner.h \
+           $$top_srcdir/include/tcl/completion.h
 
-SOURCES += commands.cpp \
+SOURCES += batch_runner.cpp \
+           commands.cpp \
+           completion.cpp \
            register_commands.cpp \
+           system_commands.cpp \
            tcl_init.cpp \
\ No newline at end of file
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <stdlib.h>
@@ -15,6 +15,7 @@
 #endif // !WIN32
 
 #include "tcl/commands.h"
+#include "tcl/completion.h"
 #include "utility/log.h"
 
 namespace eda {
@@ -40,6 +41,7 @@ namespace eda {
     Commands::set_interp(interp);
 
     registerAllCmds(interp);
+    gCompletion.indexInterp(interp);
 
     EDAReadLineLoop(interp);
 
@@ -127,124 +129,25 @@ namespace eda {
       FREE(expansion);
     }
   }
-  char* EDACommandsGenerator(const char* text, int state) {
-    static int list_index;
-    static size_t len;
-    const char* name;
-    if (!state) {
-      list_index = 0;
-      len = strlen(text);
-    }
-    int num_internal_cmds = 1;
-    static const char* internal_cmds[] = { "ls" };
-    int num_firrtlsyn_cmds = gCommands.numCmds();
-    int num_cmds = num_firrtlsyn_cmds + num_internal_cmds;
-    while (list_index < num_cmds) {
-      if (list_index < num_firrtlsyn_cmds) {
-        name = gCommands.commands(list_index).c_str();
-      }
-      else {
-        name = internal_cmds[list_index - num_firrtlsyn_cmds];
-      }
-      list_index++;
-      if (strncmp(name, text, len) == 0) {
-        return (strdup(name));
-      }
-    }
-    return ((char*)NULL);
-  }
-  char* EDACommandsOptionGenerator(const char* text, int state) {
-    static int list_index;
-    static size_t len;
-    if (text == NULL || text[0] != '-')
-      return ((char*)NULL);
-    if (!state) {
-      list_index = 0;
-      len = strlen(text);
-    }
-    char* cmd = strdup(rl_line_buffer);
-    stripwhite(cmd);
-    char* p = cmd;
-    while (*p && *p != ' ') {
-      p++;
-    }
-    if (*p == ' ') {
-      (*p) = '\0';
-    }
-    std::vector<std::string> option_names;
-    std::vector<Commands::Option> options = gCommands.command_options(cmd);
-    if (options.size() > 0) {
-      for (size_t i = 0; i < options.size(); i++) {
-        option_names.push_back(options[i].option);
-      }
-    }
-    else {
-      // for external lib commands 
-    }
-    FREE(cmd);
-    int num_options = static_cast<int>(option_names.size());
-    while (list_index < num_options) {
-      const char* name = option_names[list_index].c_str();
-      list_index++;
-      if (strncmp(name, text, len) == 0) {
-        return (strdup(name));
-      }
-    }
-    return ((char*)NULL);
-  }
-  char* EDATclVarGenerator(const char* text, int state) {
-    static int list_index;
-    static size_t len;
-    static Tcl_Obj** objv;
-    static int objc = 0;
-    static char** matches;
-    int length;
-    if (text == NULL || text[0] != '$')
-      return ((char*)NULL);
-    if (!state) {
-      list_index = 0;
-      len = strlen(text);
-      for (int i = 0; i < objc; i++) {
-        FREE(matches[i]);
-      }
-      FREE(matches);
-      objc = 0;
-      Tcl_ResetResult(tclrl_interp);
-      Tcl_Eval(tclrl_interp, "info_vars");
-      static Tcl_Obj* obj = Tcl_GetObjResult(tclrl_interp);
-      int status = Tcl_ListObjGetElements(tclrl_interp, obj, &objc, &objv);
-      if (TCL_OK != status) {
-        return ((char*)NULL);
-      }
-      if (objc > 0) {
-        matches = (char**)MALLOC(sizeof(char*) * (objc + 1));
-        for (int i = 0; i < objc; i++) {
-          char* match = Tcl_GetStringFromObj(objv[i], &length);
-          matches[i] = (char*)MALLOC(length + 2);
-          strcpy(matches[i], "$");
-          strcat(matches[i], match);
-        }
-      }
-      Tcl_ResetResult(tclrl_interp);
-    }
-    while (list_index < objc) {
-      const char* name = matches[list_index];
-      list_index++;
-      if (strncmp(name, text, len) == 0) {
-        return (strdup(name));
-      }
-    }
-    return ((char*)NULL);
-  }
-  char** EDACommandsCompletion(const char* text, int start, int end) {
-    char** matches;
-    matches = (char**)NULL;
-    if (start == 0)
-      matches = rl_completion_matches(text, EDACommandsGenerator);
-    else if (text && text[0] == '-')
-      matches = rl_completion_matches(text, EDACommandsOptionGenerator);
-    else if (text && text[0] == '$')
-      matches = rl_completion_matches(text, EDATclVarGenerator);
+  // Readline expects the text to insert first, then the matches, the list
+  // is cut at CommandCompletion::kMaxMatches.
+  char** EDACommandsCompletion(const char*, int start, int end) {
+    CommandCompletion::Result result;
+    if (!gCompletion.complete(rl_line_buffer, static_cast<size_t>(start), static_cast<size_t>(end), result))
+      return ((char**)NULL);
+    size_t num_matches = result.matches.size();
+    if (num_matches == 1) {
+      char** matches = (char**)MALLOC(sizeof(char*) * 2);
+      matches[0] = strdup(result.matches[0].c_str());
+      matches[1] = (char*)NULL;
+      return matches;
+    }
+    char** matches = (char**)MALLOC(sizeof(char*) * (num_matches + 2));
+    matches[0] = strdup(result.common.c_str());
+    for (size_t i = 0; i < num_matches; i++) {
+      matches[i + 1] = strdup(result.matches[i].c_str());
+    }
+    matches[num_matches + 1] = (char*)NULL;
     return matches;
   }
   void EDAReadLineInit(const char* history_file) {
@@ -272,6 +175,7 @@ namespace eda {
 #endif
     if (init_tcl_file) {
       Tcl_EvalFile(interp, init_tcl_file);
+      Console::flush();
       const char* result = Tcl_GetStringResult(interp);
       if (strlen(result) > 0)
         printf("%s\n", result);
@@ -288,10 +192,12 @@ namespace eda {
       Tcl_DeleteFileHandler(0);
       if (tclrl_last_line) {
         Tcl_Eval(interp, tclrl_last_line);
+        Console::flush();
         write_history(default_history_file.c_str());
         const char* result = Tcl_GetStringResult(interp);
         if (strlen(result) > 0)
           printf("%s\n", result);
+        gCompletion.indexInterp(interp);
       }
     }
 #endif // !WIN32
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include "utility/app.h"
@@ -16,8 +16,8 @@
 #else
 #include <stdlib.h>
 #include <limits.h>
-#include <dirent.h>
 #endif
+#include <stdio.h>
 
 namespace eda {
 
@@ -117,66 +117,48 @@ namespace eda {
     return "";
   }
 
-  bool App::avoidOverwrite(const std::string & file_name) {
-    if (access(file_name.c_str(), 0) == -1) {
+  // The file is moved to <base>.<n>[.gz], n counting up from 1, where base
+  // is file_name without a ".gz" suffix. The next n is kept in <base>.gen,
+  // so the directory is only probed when that file is missing or stale.
+  bool App::avoidOverwrite(const std::string & file_name, std::string* moved_name) {
+    if (File::access(file_name.c_str(), 0) == -1) {
       // no such a file exists, do nothing
       return true;
     }
-    std::vector<std::string> all_files;
-#ifndef WIN32
-    size_t pos = file_name.find_last_of("/");
-    std::string dir_path = "";
-    std::string file_final_name = "";
-    if (pos != std::string::npos) {
-      dir_path = file_name.substr(0, pos);
-      file_final_name = file_name.substr(pos+1);
-    } else {
-      char buf[2048] = { 0 };
-      getcwd(buf, sizeof(buf));
-      dir_path = std::string(buf);
-      file_final_name = file_name;
-    }
-    DIR *pDir;
-    struct dirent *pEntry;
-    if ((pDir = opendir(dir_path.c_str())) != NULL) {
-      while ((pEntry = readdir(pDir)) != NULL) {
-        if (strstr(pEntry->d_name, file_final_name.c_str())) {
-          all_files.push_back(dir_path + std::string(pEntry->d_name));
-        }
-      }
-      closedir(pDir);
-    } else {
-      eda_error("*ERROR*: The directory '%s' does not exist.\n", dir_path.c_str());
+    std::string base = file_name;
+    std::string suffix;
+    if (base.size() > 3 && base.compare(base.size() - 3, 3, ".gz") == 0) {
+      suffix = ".gz";
+      base.erase(base.size() - 3);
     }
-#else
-    struct _finddata_t finfo;
-    long long fhandle = _findfirst((file_name + ".*").c_str(), &finfo);
-    int success = static_cast<int>(fhandle);
-    while (success != -1) {
-      all_files.push_back(finfo.name);
-      success = _findnext(fhandle, &finfo);
-    }
-    _findclose(fhandle);
-#endif // WIN32
-    int max = -1;
-    for (size_t i = 0; i < all_files.size(); i++) {
-      std::string tmp_file = all_files[i];
-      size_t found = tmp_file.find_last_of('.');
-      if (found == std::string::npos) {
-        eda_warning("*WARNING*: Found a file without suffix: '%s'.\n");
-        continue;
-      }
-      std::string suffix = std::string(tmp_file, found+1);
-      int num = std::atoi(suffix.c_str());
-      if (num > max) {
-        max = num;
-      }
+    std::string counter_file = base + ".gen";
+    long long generation = 0;
+    FILE* fp = fopen(counter_file.c_str(), "r");
+    if (fp != NULL) {
+      if (fscanf(fp, "%lld", &generation) != 1)
+        generation = 0;
+      fclose(fp);
     }
-
-    if (max >= 0) {
-      std::string new_file_name = file_name + "." + std::to_string(max + 1);
-      rename(file_name.c_str(), new_file_name.c_str());
-      eda_info("*INFO*: The existing Verilog file '%s' was renamed to '%s' to avoid overwriting.\n", file_name.c_str(), new_file_name.c_str());
+    if (generation < 1)
+      generation = 1;
+    std::string new_file_name;
+    while (true) {
+      std::string prefix = base + "." + std::to_string(generation);
+      new_file_name = prefix + suffix;
+      if (File::access(prefix.c_str(), 0) == -1 && File::access((prefix + ".gz").c_str(), 0) == -1)
+        break;
+      generation++;
+    }
+    if (File::rename(file_name.c_str(), new_file_name.c_str()) != 0) {
+      return false;
+    }
+    fp = fopen(counter_file.c_str(), "w");
+    if (fp != NULL) {
+      fprintf(fp, "%lld\n", generation + 1);
+      fclose(fp);
+    }
+    if (moved_name != NULL) {
+      *moved_name = new_file_name;
     }
     return true;
   }
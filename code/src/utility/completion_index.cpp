@@ -0,0 +1,146 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#include "utility/completion_index.h"
+#include "utility/parallel.h"
+
+namespace eda {
+
+  namespace {
+
+    // below this the sort runs on the calling thread
+    const size_t kParallelSortWords = 1 << 16;
+
+    class SortWord {
+    public:
+      // 8 bytes of the word from the current depth big-endian and zero
+      // padded, so the sort compares integers instead of strings
+      uint64_t key;
+      size_t offset;
+    };
+
+    bool lessKey(const SortWord& a, const SortWord& b) {
+      return a.key < b.key;
+    }
+
+    uint64_t sortKey(const char* word) {
+      uint64_t key = 0;
+      for (int i = 0; i < 8; i++) {
+        key <<= 8;
+        if (*word != '\0') {
+          key |= static_cast<unsigned char>(*word);
+          word++;
+        }
+      }
+      return key;
+    }
+
+    // Sorts [begin, end) whose words share their first depth bytes by the
+    // next 8 bytes, then every run of equal keys by the 8 after those. A zero
+    // low byte means the words of the run ended and are equal.
+    void sortWords(const std::vector<char>& text, SortWord* begin, SortWord* end, size_t depth) {
+      for (SortWord* word = begin; word != end; word++) {
+        word->key = sortKey(&text[word->offset + depth]);
+      }
+      std::sort(begin, end, lessKey);
+      for (SortWord* run = begin; run != end;) {
+        SortWord* run_end = run + 1;
+        while (run_end != end && run_end->key == run->key) {
+          run_end++;
+        }
+        if (run_end - run > 1 && (run->key & 0xff) != 0)
+          sortWords(text, run, run_end, depth + 8);
+        run = run_end;
+      }
+    }
+
+  }
+
+  void CompletionIndex::reserve(size_t num_words, size_t num_bytes) {
+    offsets_.reserve(num_words);
+    text_.reserve(num_bytes + num_words);
+  }
+
+  void CompletionIndex::add(const char* word, size_t length) {
+    offsets_.push_back(text_.size());
+    text_.insert(text_.end(), word, word + length);
+    text_.push_back('\0');
+  }
+
+  void CompletionIndex::build() {
+    size_t count = offsets_.size();
+    std::vector<SortWord> words(count);
+    for (size_t i = 0; i < count; i++) {
+      words[i].offset = offsets_[i];
+    }
+    const std::vector<char>& text = text_;
+    if (count < kParallelSortWords) {
+      sortWords(text, words.data(), words.data() + count, 0);
+    } else {
+      // sorted runs on all processors, then merged pairwise
+      size_t num_runs = static_cast<size_t>(numProcessors());
+      size_t run = (count + num_runs - 1) / num_runs;
+      parallelFor(num_runs, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+          sortWords(text, words.data() + std::min(r * run, count), words.data() + std::min((r + 1) * run, count), 0);
+        }
+      });
+      auto less = [&](const SortWord& a, const SortWord& b) { return strcmp(&text[a.offset], &text[b.offset]) < 0; };
+      for (size_t width = run; width < count; width *= 2) {
+        size_t num_pairs = (count + 2 * width - 1) / (2 * width);
+        parallelFor(num_pairs, [&](size_t begin, size_t end) {
+          for (size_t p = begin; p < end; p++) {
+            SortWord* first = words.data() + p * 2 * width;
+            std::inplace_merge(first, words.data() + std::min(p * 2 * width + width, count),
+              words.data() + std::min(p * 2 * width + 2 * width, count), less);
+          }
+        });
+      }
+    }
+    offsets_.clear();
+    for (size_t i = 0; i < count; i++) {
+      if (i == 0 || strcmp(&text[words[i - 1].offset], &text[words[i].offset]) != 0)
+        offsets_.push_back(words[i].offset);
+    }
+    std::vector<size_t>(offsets_).swap(offsets_);
+  }
+
+  void CompletionIndex::clear() {
+    std::vector<char>().swap(text_);
+    std::vector<size_t>().swap(offsets_);
+  }
+
+  void CompletionIndex::find(const char* prefix, size_t length, size_t& begin, size_t& end) const {
+    // the words compared on their first length bytes are still sorted
+    std::vector<size_t>::const_iterator first = std::lower_bound(offsets_.begin(), offsets_.end(), prefix,
+      [&](size_t offset, const char* text) { return strncmp(&text_[offset], text, length) < 0; });
+    std::vector<size_t>::const_iterator last = std::upper_bound(first, offsets_.end(), prefix,
+      [&](const char* text, size_t offset) { return strncmp(text, &text_[offset], length) < 0; });
+    begin = static_cast<size_t>(first - offsets_.begin());
+    end = static_cast<size_t>(last - offsets_.begin());
+  }
+
+  size_t CompletionIndex::commonLength(size_t begin, size_t end) const {
+    // sorted, so the first and the last word share the least
+    const char* first = word(begin);
+    const char* last = word(end - 1);
+    size_t length = 0;
+    while (first[length] != '\0' && first[length] == last[length]) {
+      length++;
+    }
+    return length;
+  }
+
+  size_t CompletionIndex::memoryUsage() const {
+    return text_.capacity() + offsets_.capacity() * sizeof(size_t);
+  }
+
+}
@@ -2,7 +2,7 @@
 //* Author: Sitong Zhai
 //* Affiliation: University of Toronto
 //* Created: 2022-06-08
-//* Last updated: 2022-06-08
+//* Last updated: 2026-10-17
 //******************************************************************************
 
 #include <vector>
@@ -12,11 +12,11 @@
 
 namespace eda {
 
-  int DataVar::current_used_memory_ = 0;
-  int DataVar::cmd_peak_used_memory_ = 0;
-  int DataVar::eda_peak_used_memory_ = 0;
+  std::atomic<int> DataVar::current_used_memory_(0);
+  std::atomic<int> DataVar::cmd_peak_used_memory_(0);
+  std::atomic<int> DataVar::eda_peak_used_memory_(0);
 
-  bool DataVar::cmd_started_ = 0;
+  std::atomic<bool> DataVar::cmd_started_(false);
   Time DataVar::time_;
   std::list<DataVarObserver*> DataVar::observers_;
 
@@ -0,0 +1,112 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+
+#include "utility/hash.h"
+#include "utility/mapped_file.h"
+
+namespace eda {
+
+  namespace {
+
+    const uint64_t kPrime1 = 11400714785074694791ULL;
+    const uint64_t kPrime2 = 14029467366897019727ULL;
+    const uint64_t kPrime3 = 1609587929392839161ULL;
+    const uint64_t kPrime4 = 9650029242287828579ULL;
+    const uint64_t kPrime5 = 2870177450012600261ULL;
+
+    inline uint64_t rotateLeft(uint64_t x, int bits) {
+      return (x << bits) | (x >> (64 - bits));
+    }
+
+    // unaligned loads in host byte order
+    inline uint64_t read64(const unsigned char* p) {
+      uint64_t value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    inline uint32_t read32(const unsigned char* p) {
+      uint32_t value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input) {
+      acc += input * kPrime2;
+      acc = rotateLeft(acc, 31);
+      return acc * kPrime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+      acc ^= round(0, value);
+      return acc * kPrime1 + kPrime4;
+    }
+
+  }
+
+  uint64_t xxHash64(const void* data, size_t length, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + length;
+    uint64_t h;
+    if (length >= 32) {
+      // four independent lanes over 32-byte stripes
+      uint64_t v1 = seed + kPrime1 + kPrime2;
+      uint64_t v2 = seed + kPrime2;
+      uint64_t v3 = seed;
+      uint64_t v4 = seed - kPrime1;
+      const unsigned char* limit = end - 32;
+      do {
+        v1 = round(v1, read64(p));
+        v2 = round(v2, read64(p + 8));
+        v3 = round(v3, read64(p + 16));
+        v4 = round(v4, read64(p + 24));
+        p += 32;
+      } while (p <= limit);
+      h = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+      h = mergeRound(h, v1);
+      h = mergeRound(h, v2);
+      h = mergeRound(h, v3);
+      h = mergeRound(h, v4);
+    } else {
+      h = seed + kPrime5;
+    }
+    h += static_cast<uint64_t>(length);
+
+    for (; p + 8 <= end; p += 8) {
+      h ^= round(0, read64(p));
+      h = rotateLeft(h, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+      h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+      h = rotateLeft(h, 23) * kPrime2 + kPrime3;
+      p += 4;
+    }
+    for (; p < end; p++) {
+      h ^= (*p) * kPrime5;
+      h = rotateLeft(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  bool hashFile(const std::string& file_name, uint64_t seed, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(file_name)) {
+      return false;
+    }
+    hash = xxHash64(file.data(), file.size(), seed);
+    return true;
+  }
+
+}
@@ -0,0 +1,209 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "utility/app.h"
+#include "utility/log_file.h"
+#include "utility/memory_tracker.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  const size_t LogFile::kBufferSize;
+  const size_t LogFile::kMaxPending;
+  const int LogFile::kCompressionLevel;
+
+  LogFile::LogFile() {
+    max_bytes_ = 0;
+    size_ = 0;
+    compress_ = false;
+    plain_ = NULL;
+    compressed_ = NULL;
+    busy_ = false;
+    stopping_ = false;
+    thread_started_ = false;
+  }
+
+  LogFile::~LogFile() {
+    close();
+  }
+
+  bool LogFile::canCompress() {
+#ifdef HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  bool LogFile::open(const std::string& file_name, bool compress, uint64_t max_bytes) {
+    close();
+    file_name_ = file_name;
+    max_bytes_ = max_bytes;
+    compress_ = compress && canCompress();
+    if (!openFile("w"))
+      return false;
+    if (compress_) {
+      stopping_ = false;
+      thread_started_ = pthread_create(&thread_, NULL, compressorThread, this) == 0;
+      if (!thread_started_) {
+        closeFile();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool LogFile::openFile(const char* mode) {
+    size_ = 0;
+    if (!compress_) {
+      plain_ = fopen(file_name_.c_str(), mode);
+      return plain_ != NULL;
+    }
+#ifdef HAVE_ZLIB
+    char gz_mode[8];
+    snprintf(gz_mode, sizeof(gz_mode), "%sb%d", mode, kCompressionLevel);
+    gzFile file = gzopen(file_name_.c_str(), gz_mode);
+    if (file != NULL) {
+      // fewer, larger writes than with the 8KB default
+      gzbuffer(file, 256 * 1024);
+    }
+    compressed_ = file;
+#endif
+    return compressed_ != NULL;
+  }
+
+  void LogFile::closeFile() {
+    if (plain_ != NULL) {
+      fclose(plain_);
+      plain_ = NULL;
+    }
+#ifdef HAVE_ZLIB
+    if (compressed_ != NULL) {
+      gzclose(static_cast<gzFile>(compressed_));
+      compressed_ = NULL;
+    }
+#endif
+  }
+
+  void LogFile::write(const char* text, size_t length) {
+    size_ += length;
+    if (plain_ != NULL) {
+      fwrite(text, 1, length, plain_);
+      return;
+    }
+    if (compressed_ == NULL)
+      return;
+    buffer_.insert(buffer_.end(), text, text + length);
+    if (buffer_.size() >= kBufferSize)
+      queueBuffer();
+  }
+
+  void LogFile::flush() {
+    if (plain_ != NULL) {
+      fflush(plain_);
+    } else if (!buffer_.empty()) {
+      queueBuffer();
+    }
+  }
+
+  void LogFile::queueBuffer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pending_.size() >= kMaxPending) {
+      done_.wait(lock);
+    }
+    pending_.push_back(std::vector<char>());
+    pending_.back().swap(buffer_);
+    if (!free_buffers_.empty()) {
+      buffer_.swap(free_buffers_.back());
+      free_buffers_.pop_back();
+    }
+    buffer_.clear();
+    buffer_.reserve(kBufferSize + kBufferSize / 4);
+    work_.notify_one();
+  }
+
+  void LogFile::drain() {
+    if (!buffer_.empty())
+      queueBuffer();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!pending_.empty() || busy_) {
+      done_.wait(lock);
+    }
+  }
+
+  void* LogFile::compressorThread(void* data) {
+    MemoryTracker::set_tag(MemoryTracker::TAG_LOG);
+    Tracer::set_thread_name("log compressor");
+    static_cast<LogFile*>(data)->compressBlocks();
+    return NULL;
+  }
+
+  void LogFile::compressBlocks() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      while (pending_.empty() && !stopping_) {
+        work_.wait(lock);
+      }
+      if (pending_.empty())
+        break;
+      std::vector<char> block;
+      block.swap(pending_.front());
+      pending_.pop_front();
+      busy_ = true;
+      lock.unlock();
+#ifdef HAVE_ZLIB
+      // compressed_ only changes while the queue is drained
+      gzwrite(static_cast<gzFile>(compressed_), block.data(), static_cast<unsigned>(block.size()));
+#endif
+      lock.lock();
+      busy_ = false;
+      if (free_buffers_.size() < kMaxPending) {
+        free_buffers_.push_back(std::vector<char>());
+        free_buffers_.back().swap(block);
+      }
+      done_.notify_all();
+    }
+  }
+
+  std::string LogFile::rotate() {
+    if (!isOpen())
+      return std::string();
+    if (compress_)
+      drain();
+    closeFile();
+    std::string moved_name;
+    if (!App::avoidOverwrite(file_name_, &moved_name) || moved_name.empty()) {
+      max_bytes_ = 0;
+      openFile("a");
+      return std::string();
+    }
+    openFile("w");
+    return moved_name;
+  }
+
+  void LogFile::close() {
+    if (thread_started_) {
+      drain();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        work_.notify_one();
+      }
+      pthread_join(thread_, NULL);
+      thread_started_ = false;
+    }
+    closeFile();
+    std::vector<char>().swap(buffer_);
+    free_buffers_.clear();
+  }
+
+}
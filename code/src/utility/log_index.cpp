@@ -0,0 +1,569 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <regex>
+
+#include "utility/binary_io.h"
+#include "utility/file.h"
+#include "utility/hash.h"
+#include "utility/log_index.h"
+#include "utility/mapped_file.h"
+
+namespace eda {
+
+  namespace {
+
+    const uint32_t kMagic = 0x58494c45;  // "ELIX"
+    // bytes at the head of the log file hashed to tell log files apart
+    const size_t kHeadSize = 4096;
+    const size_t kReadSize = 1024 * 1024;
+
+    inline unsigned char lower(unsigned char c) {
+      return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    }
+
+    bool seekFile(FILE* fp, uint64_t offset) {
+#ifdef WIN32
+      return _fseeki64(fp, static_cast<int64_t>(offset), SEEK_SET) == 0;
+#else
+      return fseeko(fp, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    bool headHash(FILE* fp, uint64_t num_bytes, uint64_t& hash) {
+      char buffer[kHeadSize];
+      size_t size = static_cast<size_t>(std::min(num_bytes, static_cast<uint64_t>(kHeadSize)));
+      if (!seekFile(fp, 0) || fread(buffer, 1, size, fp) != size)
+        return false;
+      hash = xxHash64(buffer, size);
+      return true;
+    }
+
+    void addTrigrams(const std::string& literal, std::vector<uint32_t>& trigrams) {
+      uint32_t window = 0;
+      for (size_t i = 0; i < literal.size(); i++) {
+        window = ((window << 8) | lower(static_cast<unsigned char>(literal[i]))) & 0xffffff;
+        if (i >= 2)
+          trigrams.push_back(window);
+      }
+    }
+
+    // Skips the bracket expression or group starting at pattern[i], returns
+    // the position after it.
+    size_t skipNested(const std::string& pattern, size_t i) {
+      int depth = 0;
+      bool in_bracket = false;
+      while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == '\\') {
+          i += 2;
+          continue;
+        }
+        if (in_bracket) {
+          if (c == ']')
+            in_bracket = false;
+        } else if (c == '[') {
+          in_bracket = true;
+          // a ']' right after '[' or '[^' is a member
+          if (i + 1 < pattern.size() && pattern[i + 1] == '^')
+            i++;
+          if (i + 1 < pattern.size() && pattern[i + 1] == ']')
+            i++;
+        } else if (c == '(') {
+          depth++;
+        } else if (c == ')') {
+          depth--;
+        }
+        i++;
+        if (!in_bracket && depth <= 0)
+          return i;
+      }
+      return i;
+    }
+
+    // Runs of literal characters that every match of an ECMAScript regular
+    // expression contains. Nothing is required if there is an alternation
+    // outside of the groups.
+    void requiredLiterals(const std::string& pattern, std::vector<std::string>& literals) {
+      std::string run;
+      bool last_literal = false;
+      size_t i = 0;
+      while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == '\\') {
+          if (i + 1 >= pattern.size())
+            break;
+          unsigned char next = static_cast<unsigned char>(pattern[i + 1]);
+          i += 2;
+          if (isalnum(next)) {
+            // a class like \d or \w, an assertion or a character code, whose
+            // argument is no literal either
+            literals.push_back(run);
+            run.clear();
+            last_literal = false;
+            if (next == 'x') {
+              i = std::min(i + 2, pattern.size());
+            } else if (next == 'u') {
+              i = std::min(i + 4, pattern.size());
+            } else if (next == 'c') {
+              i = std::min(i + 1, pattern.size());
+            } else if (isdigit(next)) {
+              // \0 or a back reference
+              while (i < pattern.size() && isdigit(static_cast<unsigned char>(pattern[i]))) {
+                i++;
+              }
+            }
+          } else {
+            run += static_cast<char>(next);
+            last_literal = true;
+          }
+          continue;
+        }
+        switch (c) {
+          case '|':
+            literals.clear();
+            return;
+          case '[':
+          case '(':
+            // an alternation inside a group only makes the group optional
+            literals.push_back(run);
+            run.clear();
+            last_literal = false;
+            i = skipNested(pattern, i);
+            continue;
+          case '*':
+          case '?':
+          case '{':
+            // the atom before may be left out
+            if (last_literal && !run.empty())
+              run.erase(run.size() - 1);
+            literals.push_back(run);
+            run.clear();
+            last_literal = false;
+            if (c == '{') {
+              size_t close = pattern.find('}', i);
+              i = close == std::string::npos ? pattern.size() : close + 1;
+              continue;
+            }
+            break;
+          case '+':
+          case '.':
+          case '^':
+          case '$':
+            literals.push_back(run);
+            run.clear();
+            last_literal = false;
+            break;
+          default:
+            run += c;
+            last_literal = true;
+            break;
+        }
+        i++;
+      }
+      literals.push_back(run);
+    }
+
+    bool containsLiteral(const char* begin, const char* end, const std::string& literal, bool ignore_case) {
+      if (!ignore_case)
+        return std::search(begin, end, literal.begin(), literal.end()) != end;
+      return std::search(begin, end, literal.begin(), literal.end(), [](char a, char b) {
+        return lower(static_cast<unsigned char>(a)) == lower(static_cast<unsigned char>(b));
+      }) != end;
+    }
+
+  }
+
+  const uint32_t LogIndex::kVersion;
+  const size_t LogIndex::kBlockSize;
+
+  LogIndex::LogIndex() {
+    clear();
+  }
+
+  void LogIndex::clear() {
+    std::vector<uint64_t>().swap(block_offsets_);
+    std::vector<uint32_t>().swap(block_lines_);
+    std::unordered_map<uint32_t, uint32_t>().swap(posting_index_);
+    std::vector<Posting>().swap(postings_);
+    std::vector<uint32_t>().swap(block_trigrams_);
+    block_seen_.assign((1 << 24) / 64, 0);
+    block_offset_ = 0;
+    block_line_ = 0;
+    num_bytes_ = 0;
+    num_lines_ = 0;
+    window_ = 0;
+    window_length_ = 0;
+  }
+
+  void LogIndex::reset(const std::string& log_file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clear();
+    log_file_ = log_file;
+  }
+
+  void LogIndex::append(const char* text, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    appendLocked(text, length);
+  }
+
+  void LogIndex::appendLocked(const char* text, size_t length) {
+    uint32_t window = window_;
+    int window_length = window_length_;
+    for (size_t i = 0; i < length; i++) {
+      unsigned char c = static_cast<unsigned char>(text[i]);
+      if (c == '\n') {
+        num_lines_++;
+        window = 0;
+        window_length = 0;
+        // blocks end with a whole line
+        if (num_bytes_ + i + 1 - block_offset_ >= kBlockSize) {
+          num_bytes_ += i + 1;
+          closeBlock();
+          num_bytes_ -= i + 1;
+        }
+        continue;
+      }
+      window = ((window << 8) | lower(c)) & 0xffffff;
+      if (window_length < 2) {
+        window_length++;
+        continue;
+      }
+      uint64_t& word = block_seen_[window >> 6];
+      uint64_t bit = static_cast<uint64_t>(1) << (window & 63);
+      if ((word & bit) == 0) {
+        word |= bit;
+        block_trigrams_.push_back(window);
+      }
+    }
+    num_bytes_ += length;
+    window_ = window;
+    window_length_ = window_length;
+  }
+
+  void LogIndex::closeBlock() {
+    uint32_t block = static_cast<uint32_t>(block_offsets_.size());
+    for (size_t i = 0; i < block_trigrams_.size(); i++) {
+      uint32_t trigram = block_trigrams_[i];
+      block_seen_[trigram >> 6] &= ~(static_cast<uint64_t>(1) << (trigram & 63));
+      std::pair<std::unordered_map<uint32_t, uint32_t>::iterator, bool> inserted =
+        posting_index_.insert(std::make_pair(trigram, static_cast<uint32_t>(postings_.size())));
+      if (inserted.second) {
+        postings_.push_back(Posting());
+        postings_.back().last_block = 0;
+        postings_.back().count = 0;
+      }
+      Posting& posting = postings_[inserted.first->second];
+      uint32_t delta = posting.count == 0 ? block : block - posting.last_block;
+      while (delta >= 0x80) {
+        posting.deltas.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+      }
+      posting.deltas.push_back(static_cast<uint8_t>(delta));
+      posting.last_block = block;
+      posting.count++;
+    }
+    block_trigrams_.clear();
+    block_offsets_.push_back(block_offset_);
+    block_lines_.push_back(block_line_);
+    block_offset_ = num_bytes_;
+    block_line_ = num_lines_;
+  }
+
+  void LogIndex::decode(const Posting& posting, std::vector<uint32_t>& blocks) const {
+    blocks.clear();
+    blocks.reserve(posting.count);
+    uint32_t block = 0;
+    size_t i = 0;
+    for (uint32_t n = 0; n < posting.count; n++) {
+      uint32_t delta = 0;
+      int shift = 0;
+      while (posting.deltas[i] & 0x80) {
+        delta |= static_cast<uint32_t>(posting.deltas[i++] & 0x7f) << shift;
+        shift += 7;
+      }
+      delta |= static_cast<uint32_t>(posting.deltas[i++]) << shift;
+      block = n == 0 ? delta : block + delta;
+      blocks.push_back(block);
+    }
+  }
+
+  bool LogIndex::findCandidates(const std::vector<uint32_t>& trigrams, std::vector<Candidate>& candidates) {
+    candidates.clear();
+    std::vector<uint32_t> blocks;
+    bool all_blocks = trigrams.empty();
+    bool closed_blocks = true;
+    bool open_block = true;
+    std::vector<const Posting*> lists;
+    for (size_t i = 0; i < trigrams.size(); i++) {
+      uint32_t trigram = trigrams[i];
+      if ((block_seen_[trigram >> 6] & (static_cast<uint64_t>(1) << (trigram & 63))) == 0)
+        open_block = false;
+      std::unordered_map<uint32_t, uint32_t>::const_iterator iter = posting_index_.find(trigram);
+      if (iter == posting_index_.end()) {
+        closed_blocks = false;
+      } else {
+        lists.push_back(&postings_[iter->second]);
+      }
+    }
+    if (!all_blocks && closed_blocks) {
+      std::sort(lists.begin(), lists.end(), [](const Posting* a, const Posting* b) { return a->count < b->count; });
+      decode(*lists[0], blocks);
+      std::vector<uint32_t> other;
+      std::vector<uint32_t> both;
+      for (size_t i = 1; i < lists.size() && !blocks.empty(); i++) {
+        decode(*lists[i], other);
+        both.clear();
+        std::set_intersection(blocks.begin(), blocks.end(), other.begin(), other.end(), std::back_inserter(both));
+        blocks.swap(both);
+      }
+    }
+    if (all_blocks) {
+      for (size_t b = 0; b < block_offsets_.size(); b++) {
+        blocks.push_back(static_cast<uint32_t>(b));
+      }
+    }
+    for (size_t i = 0; i < blocks.size(); i++) {
+      Candidate candidate;
+      candidate.begin = block_offsets_[blocks[i]];
+      candidate.end = blocks[i] + 1 < block_offsets_.size() ? block_offsets_[blocks[i] + 1] : block_offset_;
+      candidate.first_line = block_lines_[blocks[i]];
+      candidates.push_back(candidate);
+    }
+    if ((all_blocks || open_block) && num_bytes_ > block_offset_) {
+      Candidate candidate;
+      candidate.begin = block_offset_;
+      candidate.end = num_bytes_;
+      candidate.first_line = block_line_;
+      candidates.push_back(candidate);
+    }
+    return !candidates.empty();
+  }
+
+  bool LogIndex::search(const std::string& pattern, int flags, size_t max_matches,
+    std::vector<Match>& matches, std::string& error) {
+    matches.clear();
+    bool ignore_case = (flags & SEARCH_IGNORE_CASE) != 0;
+    bool is_regex = (flags & SEARCH_REGEX) != 0;
+    std::regex regex;
+    std::vector<std::string> literals;
+    if (is_regex) {
+      try {
+        regex.assign(pattern, ignore_case ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+      } catch (const std::regex_error& e) {
+        error = std::string("invalid regular expression: ") + e.what();
+        return false;
+      }
+      requiredLiterals(pattern, literals);
+    } else {
+      literals.push_back(pattern);
+    }
+    literals.erase(std::remove(literals.begin(), literals.end(), std::string()), literals.end());
+    std::vector<uint32_t> trigrams;
+    for (size_t i = 0; i < literals.size(); i++) {
+      addTrigrams(literals[i], trigrams);
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+    std::vector<Candidate> candidates;
+    std::string log_file;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      log_file = log_file_;
+      if (!findCandidates(trigrams, candidates))
+        return true;
+    }
+    FILE* fp = fopen(log_file.c_str(), "rb");
+    if (fp == NULL) {
+      error = "could not open " + log_file;
+      return false;
+    }
+    std::vector<char> buffer;
+    for (size_t c = 0; c < candidates.size() && matches.size() < max_matches; c++) {
+      const Candidate& candidate = candidates[c];
+      buffer.resize(static_cast<size_t>(candidate.end - candidate.begin));
+      if (!seekFile(fp, candidate.begin))
+        break;
+      size_t size = fread(buffer.data(), 1, buffer.size(), fp);
+      const char* p = buffer.data();
+      const char* end = p + size;
+      uint32_t line = candidate.first_line;
+      while (p < end && matches.size() < max_matches) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* line_end = newline != NULL ? newline : end;
+        // the required literals are much cheaper to look for than running
+        // the regular expression
+        bool found = true;
+        for (size_t i = 0; i < literals.size() && found; i++) {
+          found = containsLiteral(p, line_end, literals[i], ignore_case);
+        }
+        if (found && is_regex)
+          found = std::regex_search(p, line_end, regex);
+        if (found) {
+          Match match;
+          match.line = line;
+          match.text.assign(p, line_end);
+          matches.push_back(match);
+        }
+        p = line_end + 1;
+        line++;
+      }
+    }
+    fclose(fp);
+    return true;
+  }
+
+  bool LogIndex::open(const std::string& log_file) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clear();
+    log_file_ = log_file;
+    long long file_size = File::size(log_file.c_str());
+    FILE* fp = fopen(log_file.c_str(), "rb");
+    if (file_size < 0 || fp == NULL) {
+      if (fp != NULL)
+        fclose(fp);
+      return false;
+    }
+
+    bool loaded = false;
+    MappedFile index;
+    if (index.open(indexFile(log_file))) {
+      const char* p = index.data();
+      const char* end = p + index.size();
+      uint32_t magic = 0;
+      uint32_t version = 0;
+      uint64_t hash = 0;
+      uint64_t file_hash = 0;
+      std::vector<uint32_t> keys;
+      std::vector<uint32_t> last_blocks;
+      std::vector<uint32_t> counts;
+      std::vector<uint32_t> sizes;
+      std::vector<uint8_t> deltas;
+      loaded = readValue(p, end, magic) && magic == kMagic && readValue(p, end, version) && version == kVersion &&
+        readValue(p, end, num_bytes_) && readValue(p, end, hash) && readValue(p, end, num_lines_) &&
+        readValue(p, end, block_offset_) && readValue(p, end, block_line_) && readValue(p, end, window_) &&
+        readValue(p, end, window_length_) && readVector(p, end, block_offsets_) && readVector(p, end, block_lines_) &&
+        readVector(p, end, block_trigrams_) && readVector(p, end, keys) && readVector(p, end, last_blocks) &&
+        readVector(p, end, counts) && readVector(p, end, sizes) && readVector(p, end, deltas) &&
+        num_bytes_ <= static_cast<uint64_t>(file_size) && headHash(fp, num_bytes_, file_hash) && file_hash == hash &&
+        last_blocks.size() == keys.size() && counts.size() == keys.size() && sizes.size() == keys.size();
+      if (loaded) {
+        postings_.resize(keys.size());
+        posting_index_.reserve(keys.size());
+        size_t offset = 0;
+        for (size_t i = 0; i < keys.size() && loaded; i++) {
+          Posting& posting = postings_[i];
+          posting.last_block = last_blocks[i];
+          posting.count = counts[i];
+          loaded = offset + sizes[i] <= deltas.size();
+          if (loaded) {
+            posting.deltas.assign(deltas.begin() + static_cast<ptrdiff_t>(offset),
+              deltas.begin() + static_cast<ptrdiff_t>(offset + sizes[i]));
+            offset += sizes[i];
+            posting_index_[keys[i]] = static_cast<uint32_t>(i);
+          }
+        }
+        for (size_t i = 0; i < block_trigrams_.size() && loaded; i++) {
+          uint32_t trigram = block_trigrams_[i] & 0xffffff;
+          block_seen_[trigram >> 6] |= static_cast<uint64_t>(1) << (trigram & 63);
+        }
+      }
+      if (!loaded) {
+        clear();
+      }
+    }
+
+    // what was written after the index was saved
+    std::vector<char> buffer(kReadSize);
+    if (seekFile(fp, num_bytes_)) {
+      size_t size = 0;
+      while ((size = fread(buffer.data(), 1, buffer.size(), fp)) > 0) {
+        appendLocked(buffer.data(), size);
+      }
+    }
+    fclose(fp);
+    return loaded;
+  }
+
+  bool LogIndex::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (log_file_.empty())
+      return false;
+    uint64_t hash = 0;
+    FILE* log = fopen(log_file_.c_str(), "rb");
+    bool hashed = log != NULL && headHash(log, num_bytes_, hash);
+    if (log != NULL)
+      fclose(log);
+    if (!hashed)
+      return false;
+
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> last_blocks(postings_.size());
+    std::vector<uint32_t> counts(postings_.size());
+    std::vector<uint32_t> sizes(postings_.size());
+    std::vector<uint8_t> deltas;
+    keys.resize(postings_.size());
+    for (std::unordered_map<uint32_t, uint32_t>::const_iterator iter = posting_index_.begin();
+      iter != posting_index_.end(); ++iter) {
+      keys[iter->second] = iter->first;
+    }
+    for (size_t i = 0; i < postings_.size(); i++) {
+      last_blocks[i] = postings_[i].last_block;
+      counts[i] = postings_[i].count;
+      sizes[i] = static_cast<uint32_t>(postings_[i].deltas.size());
+      deltas.insert(deltas.end(), postings_[i].deltas.begin(), postings_[i].deltas.end());
+    }
+
+    // written aside first, a half written index is never picked up
+    std::string index_file = indexFile(log_file_);
+    std::string temp_file = index_file + ".tmp";
+    FILE* fp = fopen(temp_file.c_str(), "wb");
+    if (fp == NULL)
+      return false;
+    bool ok = fwrite(&kMagic, sizeof(kMagic), 1, fp) == 1 && fwrite(&kVersion, sizeof(kVersion), 1, fp) == 1 &&
+      fwrite(&num_bytes_, sizeof(num_bytes_), 1, fp) == 1 && fwrite(&hash, sizeof(hash), 1, fp) == 1 &&
+      fwrite(&num_lines_, sizeof(num_lines_), 1, fp) == 1 && fwrite(&block_offset_, sizeof(block_offset_), 1, fp) == 1 &&
+      fwrite(&block_line_, sizeof(block_line_), 1, fp) == 1 && fwrite(&window_, sizeof(window_), 1, fp) == 1 &&
+      fwrite(&window_length_, sizeof(window_length_), 1, fp) == 1 && writeVector(fp, block_offsets_) &&
+      writeVector(fp, block_lines_) && writeVector(fp, block_trigrams_) && writeVector(fp, keys) &&
+      writeVector(fp, last_blocks) && writeVector(fp, counts) && writeVector(fp, sizes) && writeVector(fp, deltas);
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+      remove(temp_file.c_str());
+      return false;
+    }
+    remove(index_file.c_str());
+    return File::rename(temp_file.c_str(), index_file.c_str()) == 0;
+  }
+
+  uint32_t LogIndex::numLines() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_lines_;
+  }
+
+  uint64_t LogIndex::numBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_bytes_;
+  }
+
+  size_t LogIndex::memoryUsage() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = block_offsets_.capacity() * sizeof(uint64_t) + block_lines_.capacity() * sizeof(uint32_t) +
+      block_trigrams_.capacity() * sizeof(uint32_t) + block_seen_.capacity() * sizeof(uint64_t) +
+      postings_.capacity() * sizeof(Posting) + posting_index_.size() * (sizeof(uint32_t) * 2 + sizeof(void*) * 2);
+    for (size_t i = 0; i < postings_.size(); i++) {
+      bytes += postings_[i].deltas.capacity();
+    }
+    return bytes;
+  }
+
+}
@@ -0,0 +1,295 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "utility/log_queue.h"
+#include "utility/memory_tracker.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  namespace {
+
+    // A slot of the ring. sequence == position: free for the producer of that
+    // position, sequence == position + 1: written and ready for the writer.
+    struct Record {
+      std::atomic<size_t> sequence;
+      LogQueue::Entry entry;
+      char* heap;
+      char text[LogQueue::kInlineSize];
+    };
+
+    const size_t kMask = LogQueue::kCapacity - 1;
+    static_assert((LogQueue::kCapacity & kMask) == 0, "capacity must be a power of two");
+
+    Record* gRing = NULL;
+    std::atomic<size_t> gEnqueuePos(0);
+    // everything before it is written and flushed
+    std::atomic<size_t> gWritten(0);
+    size_t gDequeuePos = 0;
+    std::atomic<bool> gRunning(false);
+    std::atomic<bool> gStopping(false);
+    std::atomic<bool> gSleeping(false);
+    std::mutex gMutex;
+    std::condition_variable gWork;
+    std::condition_variable gDone;
+    pthread_t gThread;
+    LogQueue::Sink* gSink = NULL;
+    bool gExitHandler = false;
+
+    std::atomic<uint32_t> gNumCommands(0);
+    std::atomic<uint32_t> gCommand(0);
+    std::atomic<int> gCommandDepth(0);
+
+    thread_local bool tWriter = false;
+
+    void wakeWriter() {
+      if (gSleeping.load()) {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gWork.notify_one();
+      }
+    }
+
+    // claims the record of the next position, waits while the ring is full
+    Record* claim(size_t& pos) {
+      pos = gEnqueuePos.load(std::memory_order_relaxed);
+      while (true) {
+        if (!gRunning.load() || gStopping.load())
+          return NULL;
+        Record& record = gRing[pos & kMask];
+        size_t sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence == pos) {
+          if (gEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            return &record;
+        } else if (sequence < pos) {
+          // full, the writer is a whole ring behind
+          wakeWriter();
+          std::this_thread::yield();
+          pos = gEnqueuePos.load(std::memory_order_relaxed);
+        } else {
+          pos = gEnqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    void publish(Record& record, size_t pos) {
+      record.sequence.store(pos + 1);
+      wakeWriter();
+    }
+
+    // writes the records from pos on that are ready, at most max_count
+    size_t writeRecords(size_t& pos, size_t max_count) {
+      size_t count = 0;
+      while (count < max_count) {
+        Record& record = gRing[pos & kMask];
+        if (record.sequence.load(std::memory_order_acquire) != pos + 1)
+          break;
+        record.entry.text = record.heap != NULL ? record.heap : record.text;
+        gSink->write(record.entry);
+        if (record.heap != NULL) {
+          free(record.heap);
+          record.heap = NULL;
+        }
+        record.sequence.store(pos + LogQueue::kCapacity, std::memory_order_release);
+        pos++;
+        count++;
+      }
+      return count;
+    }
+
+    void* writerThread(void*) {
+      tWriter = true;
+      MemoryTracker::set_tag(MemoryTracker::TAG_LOG);
+      Tracer::set_thread_name("log writer");
+      size_t pos = gDequeuePos;
+      while (true) {
+        if (writeRecords(pos, LogQueue::kBatchSize) > 0) {
+          gSink->flush();
+          gWritten.store(pos);
+          {
+            std::lock_guard<std::mutex> lock(gMutex);
+          }
+          gDone.notify_all();
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(gMutex);
+        if (gStopping.load() && pos == gEnqueuePos.load())
+          break;
+        gSleeping.store(true);
+        if (gRing[pos & kMask].sequence.load() != pos + 1 && !gStopping.load()) {
+          gWork.wait_for(lock, std::chrono::milliseconds(50));
+        }
+        gSleeping.store(false);
+      }
+      gDequeuePos = pos;
+      return NULL;
+    }
+
+    void stopAtExit() {
+      LogQueue::stop();
+    }
+
+  }
+
+  bool LogQueue::start(Sink* sink) {
+    if (gRunning.load())
+      return true;
+    if (gRing == NULL) {
+      gRing = new Record[kCapacity];
+    }
+    size_t pos = gEnqueuePos.load();
+    for (size_t i = 0; i < kCapacity; i++) {
+      Record& record = gRing[(pos + i) & kMask];
+      record.heap = NULL;
+      record.sequence.store(pos + i);
+    }
+    gDequeuePos = pos;
+    gWritten.store(pos);
+    gSink = sink;
+    gStopping.store(false);
+    gRunning.store(true);
+    if (pthread_create(&gThread, NULL, writerThread, NULL) != 0) {
+      gRunning.store(false);
+      return false;
+    }
+    if (!gExitHandler) {
+      // messages still queued when Tcl calls exit()
+      atexit(stopAtExit);
+      gExitHandler = true;
+    }
+    return true;
+  }
+
+  void LogQueue::stop() {
+    if (!gRunning.load() || gStopping.load() || tWriter)
+      return;
+    {
+      std::lock_guard<std::mutex> lock(gMutex);
+      gStopping.store(true);
+      gWork.notify_one();
+    }
+    pthread_join(gThread, NULL);
+    // records claimed while the writer was finishing
+    size_t pos = gDequeuePos;
+    while (pos != gEnqueuePos.load()) {
+      if (writeRecords(pos, kCapacity) == 0)
+        std::this_thread::yield();
+    }
+    gSink->flush();
+    gDequeuePos = pos;
+    gWritten.store(pos);
+    gRunning.store(false);
+    gDone.notify_all();
+  }
+
+  bool LogQueue::running() {
+    return gRunning.load() && !gStopping.load();
+  }
+
+  bool LogQueue::push(int type, const char* prefix, const char* format, va_list args) {
+    if (tWriter)
+      return false;
+    size_t pos = 0;
+    Record* record = claim(pos);
+    if (record == NULL)
+      return false;
+
+    size_t prefix_length = strlen(prefix);
+    if (prefix_length >= kInlineSize)
+      prefix_length = kInlineSize - 1;
+    memcpy(record->text, prefix, prefix_length);
+    va_list copy;
+    va_copy(copy, args);
+    int size = vsnprintf(record->text + prefix_length, kInlineSize - prefix_length, format, copy);
+    va_end(copy);
+    size_t length = prefix_length + static_cast<size_t>(size > 0 ? size : 0);
+    record->heap = NULL;
+    if (length >= kInlineSize) {
+      char* heap = static_cast<char*>(malloc(length + 1));
+      if (heap != NULL) {
+        memcpy(heap, prefix, prefix_length);
+        vsnprintf(heap + prefix_length, length + 1 - prefix_length, format, args);
+        record->heap = heap;
+      } else {
+        length = kInlineSize - 1;
+      }
+    }
+    record->entry.type = type;
+    record->entry.length = length;
+    stamp(record->entry);
+    publish(*record, pos);
+    return true;
+  }
+
+  bool LogQueue::push(int type, const char* text) {
+    if (tWriter)
+      return false;
+    size_t pos = 0;
+    Record* record = claim(pos);
+    if (record == NULL)
+      return false;
+
+    size_t length = strlen(text);
+    record->heap = NULL;
+    if (length < kInlineSize) {
+      memcpy(record->text, text, length + 1);
+    } else {
+      record->heap = static_cast<char*>(malloc(length + 1));
+      if (record->heap != NULL) {
+        memcpy(record->heap, text, length + 1);
+      } else {
+        length = kInlineSize - 1;
+        memcpy(record->text, text, length);
+        record->text[length] = '\0';
+      }
+    }
+    record->entry.type = type;
+    record->entry.length = length;
+    stamp(record->entry);
+    publish(*record, pos);
+    return true;
+  }
+
+  void LogQueue::flush() {
+    if (!gRunning.load() || tWriter)
+      return;
+    size_t ticket = gEnqueuePos.load();
+    std::unique_lock<std::mutex> lock(gMutex);
+    gWork.notify_one();
+    while (gWritten.load() < ticket && gRunning.load()) {
+      gDone.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+
+  void LogQueue::stamp(Entry& entry) {
+    // same numbering as the threads of a trace
+    entry.thread_id = Tracer::threadId();
+    entry.command_id = gCommand.load(std::memory_order_relaxed);
+    entry.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+  void LogQueue::beginCommand() {
+    if (gCommandDepth++ == 0)
+      gCommand.store(++gNumCommands);
+  }
+
+  void LogQueue::endCommand() {
+    if (--gCommandDepth == 0)
+      gCommand.store(0);
+  }
+
+}
@@ -0,0 +1,105 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "utility/mapped_file.h"
+#include "utility/log.h"
+
+namespace eda {
+
+  MappedFile::MappedFile() {
+    data_ = NULL;
+    size_ = 0;
+#ifdef WIN32
+    file_handle_ = NULL;
+    map_handle_ = NULL;
+#endif
+  }
+
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+  bool MappedFile::open(const std::string& file_name) {
+    close();
+#ifdef WIN32
+    HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+      CloseHandle(file);
+      return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+      CloseHandle(file);
+      return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return false;
+    }
+    file_handle_ = file;
+    map_handle_ = mapping;
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      eda_error("Failed to map file '%s' into memory.\n", file_name.c_str());
+      return false;
+    }
+    data_ = static_cast<const char*>(addr);
+    size_ = size;
+#endif
+    file_name_ = file_name;
+    return true;
+  }
+
+  void MappedFile::close() {
+    if (data_ == NULL) {
+      return;
+    }
+#ifdef WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(map_handle_));
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+    map_handle_ = NULL;
+    file_handle_ = NULL;
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = NULL;
+    size_ = 0;
+    file_name_.clear();
+  }
+
+}
@@ -0,0 +1,226 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#ifdef WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+#include "utility/memory_sampler.h"
+#include "utility/data_var.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  namespace {
+
+    typedef std::chrono::steady_clock Clock;
+
+    std::mutex gMutex;
+    std::condition_variable gWake;
+    bool gRunning = false;
+    pthread_t gThread;
+
+    // trace of the running command, guarded by gMutex
+    bool gTracing = false;
+    uint32_t gTick = 0;
+    uint32_t gPeakBegin = 0;
+    Clock::time_point gTraceBegin;
+    MemorySampler::Trace gTrace;
+    std::deque<MemorySampler::Trace> gTraces;
+
+    void readMemory(uint32_t& rss_kb, uint32_t& peak_kb) {
+#ifdef WIN32
+      PROCESS_MEMORY_COUNTERS info;
+      GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info));
+      rss_kb = static_cast<uint32_t>(info.WorkingSetSize / 1024);
+      peak_kb = static_cast<uint32_t>(info.PeakWorkingSetSize / 1024);
+#else
+      // opened once, the second field of statm is the resident size in pages
+      static const int statm_fd = open("/proc/self/statm", O_RDONLY);
+      static const long page_kb = sysconf(_SC_PAGESIZE) / 1024;
+      rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      peak_kb = static_cast<uint32_t>(usage.ru_maxrss);
+
+      rss_kb = peak_kb;
+      char buf[128];
+      ssize_t size = statm_fd >= 0 ? pread(statm_fd, buf, sizeof(buf) - 1, 0) : -1;
+      if (size > 0) {
+        buf[size] = '\0';
+        char* end = NULL;
+        strtol(buf, &end, 10);
+        long resident = strtol(end, NULL, 10);
+        if (resident > 0)
+          rss_kb = static_cast<uint32_t>(resident * page_kb);
+      }
+#endif
+      if (peak_kb < rss_kb)
+        peak_kb = rss_kb;
+    }
+
+    void publish(uint32_t rss_kb, uint32_t peak_kb) {
+      int rss = static_cast<int>(rss_kb / 1024);
+      DataVar::current_used_memory_.store(rss);
+      DataVar::eda_peak_used_memory_.store(static_cast<int>(peak_kb / 1024));
+      if (!DataVar::cmd_started_.load()) {
+        DataVar::cmd_peak_used_memory_.store(rss);
+        return;
+      }
+      int cmd_peak = DataVar::cmd_peak_used_memory_.load();
+      while (cmd_peak < rss && !DataVar::cmd_peak_used_memory_.compare_exchange_weak(cmd_peak, rss)) {}
+    }
+
+    // called with gMutex held
+    void record(uint32_t rss_kb) {
+      if (gTrace.peak_kb < rss_kb)
+        gTrace.peak_kb = rss_kb;
+      if (++gTick % gTrace.stride != 0)
+        return;
+      MemorySampler::Sample sample;
+      sample.time_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - gTraceBegin).count());
+      sample.rss_kb = rss_kb;
+      gTrace.samples.push_back(sample);
+      if (gTrace.samples.size() >= MemorySampler::kMaxSamples) {
+        size_t count = 0;
+        for (size_t i = 0; i < gTrace.samples.size(); i += 2) {
+          gTrace.samples[count++] = gTrace.samples[i];
+        }
+        gTrace.samples.resize(count);
+        gTrace.stride *= 2;
+      }
+    }
+
+    void* samplerThread(void*) {
+      Tracer::set_thread_name("memory sampler");
+      // the trace only gets a counter event when the size changes
+      uint32_t traced_mb = UINT32_MAX;
+      std::unique_lock<std::mutex> lock(gMutex);
+      while (gRunning) {
+        lock.unlock();
+        uint32_t rss_kb = 0;
+        uint32_t peak_kb = 0;
+        readMemory(rss_kb, peak_kb);
+        publish(rss_kb, peak_kb);
+        if (rss_kb / 1024 != traced_mb) {
+          traced_mb = rss_kb / 1024;
+          Tracer::counter("rss_mb", traced_mb);
+        }
+        lock.lock();
+        if (gTracing) {
+          record(rss_kb);
+        }
+        int interval = gTracing ? MemorySampler::kBusyIntervalMs : MemorySampler::kIdleIntervalMs;
+        gWake.wait_for(lock, std::chrono::milliseconds(interval));
+      }
+      return NULL;
+    }
+
+  }
+
+  bool MemorySampler::start() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (gRunning)
+      return true;
+    gRunning = true;
+    if (pthread_create(&gThread, NULL, samplerThread, NULL) != 0) {
+      gRunning = false;
+      return false;
+    }
+    return true;
+  }
+
+  void MemorySampler::stop() {
+    {
+      std::lock_guard<std::mutex> lock(gMutex);
+      if (!gRunning)
+        return;
+      gRunning = false;
+    }
+    gWake.notify_all();
+    pthread_join(gThread, NULL);
+  }
+
+  uint32_t MemorySampler::sample() {
+    uint32_t rss_kb = 0;
+    uint32_t peak_kb = 0;
+    readMemory(rss_kb, peak_kb);
+    publish(rss_kb, peak_kb);
+    return rss_kb;
+  }
+
+  void MemorySampler::beginCommand(const std::string& command) {
+    std::lock_guard<std::mutex> lock(gMutex);
+    // restarts the command peak from the memory in use right now
+    DataVar::cmd_started_.store(false);
+    uint32_t rss_kb = 0;
+    readMemory(rss_kb, gPeakBegin);
+    publish(rss_kb, gPeakBegin);
+    DataVar::cmd_started_.store(true);
+
+    gTracing = true;
+    gTick = 0;
+    gTraceBegin = Clock::now();
+    gTrace.command = command;
+    gTrace.begin_kb = rss_kb;
+    gTrace.peak_kb = rss_kb;
+    gTrace.end_kb = rss_kb;
+    gTrace.elapsed_ms = 0;
+    gTrace.stride = 1;
+    gTrace.samples.clear();
+    record(rss_kb);
+    gWake.notify_all();
+  }
+
+  void MemorySampler::endCommand() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    uint32_t rss_kb = 0;
+    uint32_t peak_kb = 0;
+    readMemory(rss_kb, peak_kb);
+    publish(rss_kb, peak_kb);
+    if (gTracing) {
+      // the process peak grew during the command, so the command reached it
+      // even if no tick saw it
+      if (peak_kb > gPeakBegin && gTrace.peak_kb < peak_kb) {
+        gTrace.peak_kb = peak_kb;
+        int cmd_peak = static_cast<int>(peak_kb / 1024);
+        if (DataVar::cmd_peak_used_memory_.load() < cmd_peak)
+          DataVar::cmd_peak_used_memory_.store(cmd_peak);
+      }
+      if (gTrace.peak_kb < rss_kb)
+        gTrace.peak_kb = rss_kb;
+      // the last sample is always kept
+      Sample sample;
+      sample.time_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - gTraceBegin).count());
+      sample.rss_kb = rss_kb;
+      gTrace.samples.push_back(sample);
+      gTrace.end_kb = rss_kb;
+      gTrace.elapsed_ms = sample.time_ms;
+      gTraces.push_back(gTrace);
+      if (gTraces.size() > kMaxTraces)
+        gTraces.pop_front();
+      gTracing = false;
+    }
+    DataVar::cmd_started_.store(false);
+  }
+
+  std::vector<MemorySampler::Trace> MemorySampler::traces() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    return std::vector<Trace>(gTraces.begin(), gTraces.end());
+  }
+
+}
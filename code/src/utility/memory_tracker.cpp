@@ -0,0 +1,254 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "utility/memory_tracker.h"
+
+namespace eda {
+
+  namespace {
+
+    const uint32_t kHeaderMagic = 0x4d544b52;
+    // keeps the 16 byte alignment of malloc
+    const size_t kHeaderSize = 16;
+    // a thread merges the counters of a tag into its peak every time its own
+    // bytes of the tag grow by this much
+    const int64_t kPeakGranule = 256 * 1024;
+
+    struct BlockHeader {
+      size_t size;
+      uint32_t tag;
+      uint32_t magic;
+    };
+    static_assert(sizeof(BlockHeader) <= kHeaderSize, "block header too large");
+
+    // Written by its thread only, read by everyone. The counters of a finished
+    // thread are taken over by the next new thread, they are never freed.
+    struct ThreadCounters {
+      std::atomic<int64_t> bytes[MemoryTracker::NUM_TAGS];
+      std::atomic<uint64_t> allocations[MemoryTracker::NUM_TAGS];
+      std::atomic<uint64_t> frees[MemoryTracker::NUM_TAGS];
+      int64_t next_peak_check[MemoryTracker::NUM_TAGS];
+      ThreadCounters* next;
+      bool in_use;
+    };
+
+    int gEnabled = -1;
+    std::mutex gMutex;
+    ThreadCounters* gCounters = NULL;
+    std::atomic<int64_t> gPeakBytes[MemoryTracker::NUM_TAGS];
+    pthread_key_t gKey;
+    pthread_once_t gKeyOnce = PTHREAD_ONCE_INIT;
+
+    thread_local ThreadCounters* tCounters = NULL;
+    thread_local int tTag = MemoryTracker::TAG_OTHER;
+
+    void releaseCounters(void* counters) {
+      std::lock_guard<std::mutex> lock(gMutex);
+      static_cast<ThreadCounters*>(counters)->in_use = false;
+      // late frees of the exiting thread pick up counters again
+      tCounters = NULL;
+    }
+
+    void createKey() {
+      pthread_key_create(&gKey, releaseCounters);
+    }
+
+    // the counters are allocated with malloc, operator new would recurse
+    ThreadCounters* threadCounters() {
+      if (tCounters != NULL)
+        return tCounters;
+      pthread_once(&gKeyOnce, createKey);
+      ThreadCounters* counters = NULL;
+      {
+        std::lock_guard<std::mutex> lock(gMutex);
+        for (ThreadCounters* c = gCounters; c != NULL; c = c->next) {
+          if (!c->in_use) {
+            counters = c;
+            break;
+          }
+        }
+        if (counters == NULL) {
+          counters = static_cast<ThreadCounters*>(malloc(sizeof(ThreadCounters)));
+          if (counters == NULL)
+            return NULL;
+          for (int t = 0; t < MemoryTracker::NUM_TAGS; t++) {
+            counters->bytes[t].store(0);
+            counters->allocations[t].store(0);
+            counters->frees[t].store(0);
+          }
+          counters->next = gCounters;
+          gCounters = counters;
+        }
+        counters->in_use = true;
+        for (int t = 0; t < MemoryTracker::NUM_TAGS; t++) {
+          counters->next_peak_check[t] = counters->bytes[t].load(std::memory_order_relaxed) + kPeakGranule;
+        }
+      }
+      pthread_setspecific(gKey, counters);
+      tCounters = counters;
+      return counters;
+    }
+
+    // called with gMutex held
+    int64_t currentBytes(int tag) {
+      int64_t bytes = 0;
+      for (ThreadCounters* c = gCounters; c != NULL; c = c->next) {
+        bytes += c->bytes[tag].load(std::memory_order_relaxed);
+      }
+      return bytes;
+    }
+
+    void updatePeak(int tag, int64_t bytes) {
+      int64_t peak = gPeakBytes[tag].load(std::memory_order_relaxed);
+      while (peak < bytes && !gPeakBytes[tag].compare_exchange_weak(peak, bytes)) {}
+    }
+
+  }
+
+  bool MemoryTracker::enabled() {
+    if (gEnabled < 0) {
+      // decided by the first allocation, before any thread is started
+      const char* value = getenv("EDA_MEMORY_TRACKING");
+      gEnabled = value != NULL && value[0] != '\0' && strcmp(value, "0") != 0 ? 1 : 0;
+    }
+    return gEnabled > 0;
+  }
+
+  const char* MemoryTracker::tagName(Tag tag) {
+    switch (tag) {
+    case TAG_DEVICE: return "device";
+    case TAG_DESIGN: return "design";
+    case TAG_GUI: return "gui";
+    case TAG_LOG: return "log";
+    default: return "other";
+    }
+  }
+
+  MemoryTracker::Tag MemoryTracker::tag() {
+    return static_cast<Tag>(tTag);
+  }
+
+  void MemoryTracker::set_tag(Tag tag) {
+    tTag = tag;
+  }
+
+  void MemoryTracker::usage(std::vector<Usage>& usage) {
+    usage.assign(NUM_TAGS, Usage());
+    std::lock_guard<std::mutex> lock(gMutex);
+    for (int t = 0; t < NUM_TAGS; t++) {
+      Usage& u = usage[t];
+      u.bytes = 0;
+      u.allocations = 0;
+      u.frees = 0;
+      for (ThreadCounters* c = gCounters; c != NULL; c = c->next) {
+        u.bytes += c->bytes[t].load(std::memory_order_relaxed);
+        u.allocations += c->allocations[t].load(std::memory_order_relaxed);
+        u.frees += c->frees[t].load(std::memory_order_relaxed);
+      }
+      updatePeak(t, u.bytes);
+      u.peak_bytes = gPeakBytes[t].load();
+    }
+  }
+
+  void* MemoryTracker::allocate(size_t size) {
+    if (!enabled())
+      return malloc(size);
+    char* block = static_cast<char*>(malloc(size + kHeaderSize));
+    if (block == NULL)
+      return NULL;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+    header->size = size;
+    header->tag = static_cast<uint32_t>(tTag);
+    header->magic = kHeaderMagic;
+
+    ThreadCounters* counters = threadCounters();
+    if (counters != NULL) {
+      int tag = tTag;
+      int64_t bytes = counters->bytes[tag].load(std::memory_order_relaxed) + static_cast<int64_t>(size);
+      counters->bytes[tag].store(bytes, std::memory_order_relaxed);
+      counters->allocations[tag].store(counters->allocations[tag].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      if (bytes >= counters->next_peak_check[tag]) {
+        counters->next_peak_check[tag] = bytes + kPeakGranule;
+        std::lock_guard<std::mutex> lock(gMutex);
+        updatePeak(tag, currentBytes(tag));
+      }
+    }
+    return block + kHeaderSize;
+  }
+
+  void MemoryTracker::release(void* ptr) {
+    if (ptr == NULL)
+      return;
+    if (!enabled()) {
+      free(ptr);
+      return;
+    }
+    char* block = static_cast<char*>(ptr) - kHeaderSize;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+    if (header->magic != kHeaderMagic || header->tag >= static_cast<uint32_t>(NUM_TAGS)) {
+      free(ptr);
+      return;
+    }
+    header->magic = 0;
+    ThreadCounters* counters = threadCounters();
+    if (counters != NULL) {
+      int tag = static_cast<int>(header->tag);
+      int64_t bytes = counters->bytes[tag].load(std::memory_order_relaxed) - static_cast<int64_t>(header->size);
+      counters->bytes[tag].store(bytes, std::memory_order_relaxed);
+      counters->frees[tag].store(counters->frees[tag].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      if (bytes + 2 * kPeakGranule < counters->next_peak_check[tag])
+        counters->next_peak_check[tag] = bytes + kPeakGranule;
+    }
+    free(block);
+  }
+
+}
+
+void* operator new(size_t size) {
+  void* ptr = eda::MemoryTracker::allocate(size > 0 ? size : 1);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  void* ptr = eda::MemoryTracker::allocate(size > 0 ? size : 1);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw() {
+  return eda::MemoryTracker::allocate(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw() {
+  return eda::MemoryTracker::allocate(size > 0 ? size : 1);
+}
+
+void operator delete(void* ptr) throw() {
+  eda::MemoryTracker::release(ptr);
+}
+
+void operator delete[](void* ptr) throw() {
+  eda::MemoryTracker::release(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) throw() {
+  eda::MemoryTracker::release(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) throw() {
+  eda::MemoryTracker::release(ptr);
+}
@@ -0,0 +1,221 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <algorithm>
+#include <utility>
+
+#include "utility/packed_rtree.h"
+
+namespace eda {
+
+  const uint32_t PackedRTree::kInvalidId;
+
+  namespace {
+
+    // position on a Hilbert curve filling a 65536 x 65536 grid
+    uint32_t hilbert(uint32_t x, uint32_t y) {
+      uint32_t d = 0;
+      for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) != 0 ? 1 : 0;
+        uint32_t ry = (y & s) != 0 ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+          if (rx == 1) {
+            x = 0xffff - x;
+            y = 0xffff - y;
+          }
+          std::swap(x, y);
+        }
+      }
+      return d;
+    }
+
+    uint32_t gridPosition(float value, float low, float size) {
+      return static_cast<uint32_t>(65535.0f * ((value - low) / size));
+    }
+
+  }
+
+  void PackedRTree::Box::expand(const Box& box) {
+    x0 = std::min(x0, box.x0);
+    y0 = std::min(y0, box.y0);
+    x1 = std::max(x1, box.x1);
+    y1 = std::max(y1, box.y1);
+  }
+
+  PackedRTree::PackedRTree(uint32_t node_size) {
+    node_size_ = node_size < 2 ? 2 : node_size;
+    num_leaves_ = 0;
+    num_removed_ = 0;
+  }
+
+  void PackedRTree::clear() {
+    items_.clear();
+    boxes_.clear();
+    indices_.clear();
+    level_end_.clear();
+    leaf_of_.clear();
+    removed_.clear();
+    overflow_.clear();
+    num_leaves_ = 0;
+    num_removed_ = 0;
+  }
+
+  void PackedRTree::add(uint32_t id, const Box& box) {
+    Item item;
+    item.box = box;
+    item.id = id;
+    items_.push_back(item);
+  }
+
+  void PackedRTree::build() {
+    pack();
+  }
+
+  void PackedRTree::insert(uint32_t id, const Box& box) {
+    Item item;
+    item.box = box;
+    item.id = id;
+    overflow_.push_back(item);
+    if (overflow_.size() > std::max<size_t>(256, num_leaves_ / 16)) {
+      pack();
+    }
+  }
+
+  bool PackedRTree::remove(uint32_t id) {
+    for (size_t i = 0; i < overflow_.size(); i++) {
+      if (overflow_[i].id == id) {
+        overflow_[i] = overflow_.back();
+        overflow_.pop_back();
+        return true;
+      }
+    }
+    if (id >= leaf_of_.size() || leaf_of_[id] == kInvalidId) {
+      return false;
+    }
+    removed_[leaf_of_[id]] = 1;
+    leaf_of_[id] = kInvalidId;
+    num_removed_++;
+    if (num_removed_ > 256 && num_removed_ > num_leaves_ / 4) {
+      pack();
+    }
+    return true;
+  }
+
+  void PackedRTree::pack() {
+    // what is left of the current tree is packed again with the new boxes
+    std::vector<Item> items;
+    items.swap(items_);
+    for (uint32_t i = 0; i < num_leaves_; i++) {
+      if (removed_[i] == 0) {
+        Item item;
+        item.box = boxes_[i];
+        item.id = indices_[i];
+        items.push_back(item);
+      }
+    }
+    items.insert(items.end(), overflow_.begin(), overflow_.end());
+    clear();
+    if (items.empty()) {
+      return;
+    }
+
+    Box bounds = items[0].box;
+    uint32_t max_id = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+      bounds.expand(items[i].box);
+      max_id = std::max(max_id, items[i].id);
+    }
+    float width = bounds.x1 > bounds.x0 ? bounds.x1 - bounds.x0 : 1.0f;
+    float height = bounds.y1 > bounds.y0 ? bounds.y1 - bounds.y0 : 1.0f;
+    std::vector<std::pair<uint32_t, uint32_t> > order(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+      const Box& box = items[i].box;
+      uint32_t x = gridPosition((box.x0 + box.x1) / 2, bounds.x0, width);
+      uint32_t y = gridPosition((box.y0 + box.y1) / 2, bounds.y0, height);
+      order[i] = std::make_pair(hilbert(x, y), static_cast<uint32_t>(i));
+    }
+    std::sort(order.begin(), order.end());
+
+    num_leaves_ = static_cast<uint32_t>(items.size());
+    size_t num_nodes = items.size();
+    for (size_t count = items.size(); count > 1; ) {
+      count = (count + node_size_ - 1) / node_size_;
+      num_nodes += count;
+    }
+    boxes_.reserve(num_nodes);
+    indices_.reserve(num_nodes);
+    for (size_t i = 0; i < order.size(); i++) {
+      const Item& item = items[order[i].second];
+      boxes_.push_back(item.box);
+      indices_.push_back(item.id);
+    }
+    uint32_t begin = 0;
+    uint32_t end = num_leaves_;
+    level_end_.push_back(end);
+    while (end - begin > 1) {
+      for (uint32_t i = begin; i < end; i += node_size_) {
+        Box box = boxes_[i];
+        uint32_t last = std::min(i + node_size_, end);
+        for (uint32_t child = i + 1; child < last; child++) {
+          box.expand(boxes_[child]);
+        }
+        boxes_.push_back(box);
+        indices_.push_back(i);
+      }
+      begin = end;
+      end = static_cast<uint32_t>(boxes_.size());
+      level_end_.push_back(end);
+    }
+
+    leaf_of_.assign(static_cast<size_t>(max_id) + 1, kInvalidId);
+    for (uint32_t i = 0; i < num_leaves_; i++) {
+      leaf_of_[indices_[i]] = i;
+    }
+    removed_.assign(num_leaves_, 0);
+  }
+
+  void PackedRTree::search(const Box& box, std::vector<uint32_t>& ids) const {
+    if (!boxes_.empty()) {
+      // (node, level)
+      std::vector<std::pair<uint32_t, uint32_t> > stack;
+      stack.reserve(level_end_.size() * node_size_);
+      stack.push_back(std::make_pair(static_cast<uint32_t>(boxes_.size() - 1), static_cast<uint32_t>(level_end_.size() - 1)));
+      while (!stack.empty()) {
+        std::pair<uint32_t, uint32_t> node = stack.back();
+        stack.pop_back();
+        if (!boxes_[node.first].intersects(box))
+          continue;
+        if (node.second == 0) {
+          if (removed_[node.first] == 0)
+            ids.push_back(indices_[node.first]);
+          continue;
+        }
+        uint32_t child_begin = indices_[node.first];
+        uint32_t child_end = std::min(child_begin + node_size_, level_end_[node.second - 1]);
+        for (uint32_t child = child_begin; child < child_end; child++) {
+          stack.push_back(std::make_pair(child, node.second - 1));
+        }
+      }
+    }
+    for (size_t i = 0; i < overflow_.size(); i++) {
+      if (overflow_[i].box.intersects(box))
+        ids.push_back(overflow_[i].id);
+    }
+  }
+
+  size_t PackedRTree::memoryUsage() const {
+    return items_.capacity() * sizeof(Item) +
+      boxes_.capacity() * sizeof(Box) +
+      indices_.capacity() * sizeof(uint32_t) +
+      level_end_.capacity() * sizeof(uint32_t) +
+      leaf_of_.capacity() * sizeof(uint32_t) +
+      removed_.capacity() +
+      overflow_.capacity() * sizeof(Item);
+  }
+
+}
@@ -0,0 +1,99 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <pthread.h>
+#include <vector>
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "utility/parallel.h"
+#include "utility/memory_tracker.h"
+#include "utility/tracer.h"
+
+namespace eda {
+
+  namespace {
+
+    // set by set_max_processors()
+    int gMaxProcessors = 0;
+
+    struct ParallelChunk {
+      const std::function<void(size_t, size_t)>* fn;
+      size_t begin;
+      size_t end;
+      // allocations of the chunk count to the tag of the caller
+      MemoryTracker::Tag tag;
+    };
+
+    void* runChunk(void* arg) {
+      ParallelChunk* chunk = static_cast<ParallelChunk*>(arg);
+      MemoryTagScope scope(chunk->tag);
+      TraceScope trace("parallel_chunk");
+      (*chunk->fn)(chunk->begin, chunk->end);
+      return NULL;
+    }
+
+  }
+
+  int numProcessors() {
+#ifdef WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = static_cast<int>(info.dwNumberOfProcessors);
+#else
+    int count = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+    if (gMaxProcessors > 0 && count > gMaxProcessors) {
+      count = gMaxProcessors;
+    }
+    return count > 0 ? count : 1;
+  }
+
+  void set_max_processors(int count) {
+    gMaxProcessors = count;
+  }
+
+  void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn, int num_threads) {
+    if (num_threads <= 0) {
+      num_threads = numProcessors();
+    }
+    size_t num_chunks = static_cast<size_t>(num_threads);
+    if (num_chunks > count) {
+      num_chunks = count;
+    }
+    if (num_chunks <= 1) {
+      if (count > 0) fn(0, count);
+      return;
+    }
+
+    std::vector<ParallelChunk> chunks(num_chunks);
+    for (size_t i = 0; i < num_chunks; i++) {
+      chunks[i].fn = &fn;
+      chunks[i].begin = count * i / num_chunks;
+      chunks[i].end = count * (i + 1) / num_chunks;
+      chunks[i].tag = MemoryTracker::tag();
+    }
+    // the calling thread takes the first chunk
+    std::vector<pthread_t> threads(num_chunks);
+    std::vector<bool> started(num_chunks, false);
+    for (size_t i = 1; i < num_chunks; i++) {
+      started[i] = pthread_create(&threads[i], NULL, runChunk, &chunks[i]) == 0;
+    }
+    runChunk(&chunks[0]);
+    for (size_t i = 1; i < num_chunks; i++) {
+      if (started[i]) {
+        pthread_join(threads[i], NULL);
+      } else {
+        runChunk(&chunks[i]);
+      }
+    }
+  }
+
+}
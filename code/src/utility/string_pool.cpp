@@ -0,0 +1,191 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <string.h>
+
+#include "utility/binary_io.h"
+#include "utility/string_pool.h"
+
+namespace eda {
+
+  const StringPool::Id StringPool::kInvalidId;
+  const size_t StringPool::kBlockSize;
+
+  StringPool::StringPool() {
+    block_end_ = NULL;
+    block_free_ = NULL;
+    block_bytes_ = 0;
+    num_interned_ = 0;
+  }
+
+  StringPool::~StringPool() {
+    clear();
+  }
+
+  void StringPool::clear() {
+    for (size_t i = 0; i < blocks_.size(); i++) {
+      delete[] blocks_[i];
+    }
+    std::vector<char*>().swap(blocks_);
+    std::vector<const char*>().swap(strings_);
+    std::vector<uint32_t>().swap(lengths_);
+    std::vector<Id>().swap(slots_);
+    block_end_ = NULL;
+    block_free_ = NULL;
+    block_bytes_ = 0;
+    num_interned_ = 0;
+  }
+
+  // FNV-1a
+  uint32_t StringPool::hash(const char* str, size_t length) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+      h ^= static_cast<unsigned char>(str[i]);
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  const char* StringPool::store(const char* str, size_t length) {
+    size_t bytes = length + 1;
+    if (block_free_ == NULL || static_cast<size_t>(block_end_ - block_free_) < bytes) {
+      // blocks grow from 4KB to kBlockSize so that small pools stay small,
+      // oversized strings get a block of their own
+      size_t size = blocks_.empty() ? 4096 : static_cast<size_t>(block_end_ - blocks_.back()) * 2;
+      if (size > kBlockSize) size = kBlockSize;
+      if (size < bytes) size = bytes;
+      char* block = new char[size];
+      blocks_.push_back(block);
+      block_bytes_ += size;
+      block_free_ = block;
+      block_end_ = block + size;
+    }
+    char* copy = block_free_;
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    block_free_ += bytes;
+    return copy;
+  }
+
+  StringPool::Id StringPool::add(const char* str, size_t length) {
+    strings_.push_back(store(str, length));
+    lengths_.push_back(static_cast<uint32_t>(length));
+    return static_cast<Id>(strings_.size() - 1);
+  }
+
+  StringPool::Id StringPool::find(const char* str, size_t length) const {
+    if (slots_.empty()) {
+      return kInvalidId;
+    }
+    size_t mask = slots_.size() - 1;
+    for (size_t slot = hash(str, length) & mask; ; slot = (slot + 1) & mask) {
+      Id id = slots_[slot];
+      if (id == kInvalidId) {
+        return kInvalidId;
+      }
+      if (lengths_[id] == length && memcmp(strings_[id], str, length) == 0) {
+        return id;
+      }
+    }
+  }
+
+  StringPool::Id StringPool::intern(const char* str, size_t length) {
+    if ((num_interned_ + 1) * 2 > slots_.size()) {
+      rehash(slots_.empty() ? 1024 : slots_.size() * 2);
+    }
+    size_t mask = slots_.size() - 1;
+    size_t slot = hash(str, length) & mask;
+    for (; ; slot = (slot + 1) & mask) {
+      Id id = slots_[slot];
+      if (id == kInvalidId) {
+        break;
+      }
+      if (lengths_[id] == length && memcmp(strings_[id], str, length) == 0) {
+        return id;
+      }
+    }
+    Id id = add(str, length);
+    slots_[slot] = id;
+    num_interned_++;
+    return id;
+  }
+
+  void StringPool::rehash(size_t num_slots) {
+    std::vector<Id> old_slots(num_slots, kInvalidId);
+    old_slots.swap(slots_);
+    size_t mask = num_slots - 1;
+    for (size_t i = 0; i < old_slots.size(); i++) {
+      Id id = old_slots[i];
+      if (id == kInvalidId) continue;
+      size_t slot = hash(strings_[id], lengths_[id]) & mask;
+      while (slots_[slot] != kInvalidId) {
+        slot = (slot + 1) & mask;
+      }
+      slots_[slot] = id;
+    }
+  }
+
+  size_t StringPool::memoryUsage() const {
+    return block_bytes_ + blocks_.capacity() * sizeof(char*) +
+      strings_.capacity() * sizeof(const char*) + lengths_.capacity() * sizeof(uint32_t) +
+      slots_.capacity() * sizeof(Id);
+  }
+
+  bool StringPool::save(FILE* fp) const {
+    uint64_t num_bytes = 0;
+    for (size_t i = 0; i < lengths_.size(); i++) {
+      num_bytes += lengths_[i] + 1;
+    }
+    uint64_t num_interned = num_interned_;
+    bool ok = writeVector(fp, lengths_) && fwrite(&num_bytes, sizeof(num_bytes), 1, fp) == 1;
+    for (size_t i = 0; ok && i < strings_.size(); i++) {
+      ok = fwrite(strings_[i], 1, lengths_[i] + 1, fp) == lengths_[i] + 1;
+    }
+    return ok && writeVector(fp, slots_) && fwrite(&num_interned, sizeof(num_interned), 1, fp) == 1;
+  }
+
+  bool StringPool::load(const char*& p, const char* end) {
+    clear();
+    uint64_t num_bytes = 0;
+    uint64_t num_interned = 0;
+    if (!readVector(p, end, lengths_) || !readValue(p, end, num_bytes) || num_bytes > static_cast<uint64_t>(end - p)) {
+      clear();
+      return false;
+    }
+    // all strings go to one block, later ones to new blocks as usual
+    size_t size = static_cast<size_t>(num_bytes);
+    if (size > 0) {
+      char* block = new char[size];
+      memcpy(block, p, size);
+      blocks_.push_back(block);
+      block_bytes_ = size;
+      block_free_ = block + size;
+      block_end_ = block + size;
+    }
+    p += size;
+    strings_.resize(lengths_.size());
+    size_t offset = 0;
+    bool ok = true;
+    for (size_t i = 0; ok && i < lengths_.size(); i++) {
+      ok = offset + lengths_[i] < size && blocks_[0][offset + lengths_[i]] == '\0';
+      if (ok) strings_[i] = blocks_[0] + offset;
+      offset += lengths_[i] + 1;
+    }
+    ok = ok && offset == size && readVector(p, end, slots_) && readValue(p, end, num_interned) &&
+      (slots_.size() & (slots_.size() - 1)) == 0 && num_interned * 2 <= slots_.size();
+    for (size_t i = 0; ok && i < slots_.size(); i++) {
+      ok = slots_[i] == kInvalidId || slots_[i] < strings_.size();
+    }
+    if (!ok) {
+      clear();
+      return false;
+    }
+    num_interned_ = static_cast<size_t>(num_interned);
+    return true;
+  }
+
+}
@@ -0,0 +1,317 @@
+//******************************************************************************
+//* Author: Sitong Zhai
+//* Affiliation: University of Toronto
+//* Created: 2026-10-17
+//* Last updated: 2026-10-17
+//******************************************************************************
+
+#include <stdio.h>
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include "utility/tracer.h"
+
+namespace eda {
+
+  namespace {
+
+    enum EventType {
+      EVENT_BEGIN,
+      EVENT_END,
+      EVENT_COUNTER,
+      EVENT_INSTANT
+    };
+
+    struct Event {
+      int64_t time_ns;
+      const char* name;
+      const char* category;
+      double value;
+      uint32_t thread;
+      int type;
+    };
+
+    struct Chunk {
+      std::atomic<uint32_t> count;
+      Event events[Tracer::kChunkEvents];
+    };
+
+    struct ThreadBuffer {
+      std::atomic<Chunk*> chunks[Tracer::kMaxChunks];
+      std::atomic<uint32_t> num_chunks;
+      // clear() the events belong to
+      uint32_t epoch;
+      ThreadBuffer* next;
+      bool in_use;
+    };
+
+    const std::chrono::steady_clock::time_point gStart = std::chrono::steady_clock::now();
+    std::atomic<bool> gEnabled(true);
+    std::atomic<uint32_t> gEpoch(0);
+    std::atomic<uint32_t> gNumThreads(0);
+    std::atomic<uint64_t> gDropped(0);
+    std::mutex gMutex;
+    ThreadBuffer* gBuffers = NULL;
+    std::set<std::string> gNames;
+    std::map<uint32_t, std::string> gThreadNames;
+    pthread_key_t gKey;
+    pthread_once_t gKeyOnce = PTHREAD_ONCE_INIT;
+
+    thread_local ThreadBuffer* tBuffer = NULL;
+    thread_local uint32_t tThreadId = 0;
+
+    int64_t now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - gStart).count();
+    }
+
+    void releaseBuffer(void* buffer) {
+      std::lock_guard<std::mutex> lock(gMutex);
+      static_cast<ThreadBuffer*>(buffer)->in_use = false;
+      tBuffer = NULL;
+    }
+
+    void createKey() {
+      pthread_key_create(&gKey, releaseBuffer);
+    }
+
+    // called with gMutex held
+    void resetBuffer(ThreadBuffer* buffer) {
+      uint32_t num_chunks = buffer->num_chunks.load(std::memory_order_relaxed);
+      for (uint32_t i = 0; i < num_chunks; i++) {
+        buffer->chunks[i].load(std::memory_order_relaxed)->count.store(0, std::memory_order_relaxed);
+      }
+      buffer->num_chunks.store(0, std::memory_order_release);
+      buffer->epoch = gEpoch.load();
+    }
+
+    ThreadBuffer* threadBuffer() {
+      if (tBuffer != NULL)
+        return tBuffer;
+      pthread_once(&gKeyOnce, createKey);
+      ThreadBuffer* buffer = NULL;
+      {
+        std::lock_guard<std::mutex> lock(gMutex);
+        for (ThreadBuffer* b = gBuffers; b != NULL; b = b->next) {
+          if (!b->in_use) {
+            buffer = b;
+            break;
+          }
+        }
+        if (buffer == NULL) {
+          buffer = new ThreadBuffer();
+          for (size_t i = 0; i < Tracer::kMaxChunks; i++) {
+            buffer->chunks[i].store(NULL);
+          }
+          buffer->num_chunks.store(0);
+          buffer->epoch = gEpoch.load();
+          buffer->next = gBuffers;
+          gBuffers = buffer;
+        }
+        buffer->in_use = true;
+      }
+      pthread_setspecific(gKey, buffer);
+      tBuffer = buffer;
+      return buffer;
+    }
+
+    void record(int type, const char* name, const char* category, double value) {
+      if (!gEnabled.load(std::memory_order_relaxed))
+        return;
+      ThreadBuffer* buffer = threadBuffer();
+      if (buffer->epoch != gEpoch.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(gMutex);
+        resetBuffer(buffer);
+      }
+      uint32_t num_chunks = buffer->num_chunks.load(std::memory_order_relaxed);
+      Chunk* chunk = num_chunks > 0 ? buffer->chunks[num_chunks - 1].load(std::memory_order_relaxed) : NULL;
+      uint32_t count = chunk != NULL ? chunk->count.load(std::memory_order_relaxed) : Tracer::kChunkEvents;
+      if (count == Tracer::kChunkEvents) {
+        if (num_chunks == Tracer::kMaxChunks) {
+          gDropped++;
+          return;
+        }
+        // chunks of a reset buffer are used again
+        chunk = buffer->chunks[num_chunks].load(std::memory_order_relaxed);
+        if (chunk == NULL) {
+          chunk = new Chunk();
+          chunk->count.store(0, std::memory_order_relaxed);
+          buffer->chunks[num_chunks].store(chunk, std::memory_order_release);
+        }
+        buffer->num_chunks.store(num_chunks + 1, std::memory_order_release);
+        count = 0;
+      }
+      Event& event = chunk->events[count];
+      event.time_ns = now();
+      event.name = name;
+      event.category = category;
+      event.value = value;
+      event.thread = Tracer::threadId();
+      event.type = type;
+      chunk->count.store(count + 1, std::memory_order_release);
+    }
+
+    void writeString(FILE* fp, const char* text) {
+      fputc('"', fp);
+      for (const char* p = text; *p != '\0'; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+          fputc('\\', fp);
+          fputc(c, fp);
+        } else if (c < 0x20) {
+          fprintf(fp, "\\u%04x", c);
+        } else {
+          fputc(c, fp);
+        }
+      }
+      fputc('"', fp);
+    }
+
+    void writeEvent(FILE* fp, const Event& event, bool& first) {
+      fputs(first ? "\n" : ",\n", fp);
+      first = false;
+      double ts = static_cast<double>(event.time_ns) / 1000.0;
+      switch (event.type) {
+        case EVENT_BEGIN:
+          fputs("{\"name\":", fp);
+          writeString(fp, event.name);
+          fputs(",\"cat\":", fp);
+          writeString(fp, event.category);
+          fprintf(fp, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, event.thread);
+          break;
+        case EVENT_END:
+          fprintf(fp, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, event.thread);
+          break;
+        case EVENT_COUNTER:
+          fputs("{\"name\":", fp);
+          writeString(fp, event.name);
+          fprintf(fp, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%.17g}}", ts, event.thread, event.value);
+          break;
+        default:
+          fputs("{\"name\":", fp);
+          writeString(fp, event.name);
+          fputs(",\"cat\":", fp);
+          writeString(fp, event.category);
+          fprintf(fp, ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, event.thread);
+          break;
+      }
+    }
+
+  }
+
+  const size_t Tracer::kChunkEvents;
+  const size_t Tracer::kMaxChunks;
+
+  bool Tracer::enabled() {
+    return gEnabled.load();
+  }
+
+  void Tracer::set_enabled(bool enabled) {
+    gEnabled.store(enabled);
+  }
+
+  void Tracer::begin(const char* name, const char* category) {
+    record(EVENT_BEGIN, name, category, 0.0);
+  }
+
+  void Tracer::end() {
+    record(EVENT_END, "", "", 0.0);
+  }
+
+  void Tracer::counter(const char* name, double value) {
+    record(EVENT_COUNTER, name, "counter", value);
+  }
+
+  void Tracer::instant(const char* name, const char* category) {
+    record(EVENT_INSTANT, name, category, 0.0);
+  }
+
+  const char* Tracer::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(gMutex);
+    return gNames.insert(name).first->c_str();
+  }
+
+  uint32_t Tracer::threadId() {
+    if (tThreadId == 0)
+      tThreadId = ++gNumThreads;
+    return tThreadId;
+  }
+
+  void Tracer::set_thread_name(const char* name) {
+    uint32_t thread = threadId();
+    std::lock_guard<std::mutex> lock(gMutex);
+    gThreadNames[thread] = name;
+  }
+
+  bool Tracer::writeChromeTrace(const std::string& file_name, size_t& num_events) {
+    num_events = 0;
+    FILE* fp = fopen(file_name.c_str(), "w");
+    if (fp == NULL)
+      return false;
+    std::lock_guard<std::mutex> lock(gMutex);
+    int64_t end_time = now();
+    bool first = true;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", fp);
+    for (std::map<uint32_t, std::string>::const_iterator iter = gThreadNames.begin(); iter != gThreadNames.end(); ++iter) {
+      fputs(first ? "\n" : ",\n", fp);
+      first = false;
+      fprintf(fp, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", iter->first);
+      writeString(fp, iter->second.c_str());
+      fputs("}}", fp);
+    }
+    // open zones per thread, an end without a begin was cut off by clear()
+    std::map<uint32_t, int> depth;
+    for (ThreadBuffer* buffer = gBuffers; buffer != NULL; buffer = buffer->next) {
+      // not reset by its thread since the last clear()
+      if (buffer->epoch != gEpoch.load())
+        continue;
+      uint32_t num_chunks = buffer->num_chunks.load(std::memory_order_acquire);
+      for (uint32_t i = 0; i < num_chunks; i++) {
+        Chunk* chunk = buffer->chunks[i].load(std::memory_order_acquire);
+        uint32_t count = chunk->count.load(std::memory_order_acquire);
+        for (uint32_t e = 0; e < count; e++) {
+          const Event& event = chunk->events[e];
+          if (event.type == EVENT_BEGIN) {
+            depth[event.thread]++;
+          } else if (event.type == EVENT_END) {
+            if (depth[event.thread] == 0)
+              continue;
+            depth[event.thread]--;
+          }
+          writeEvent(fp, event, first);
+          num_events++;
+        }
+      }
+    }
+    for (std::map<uint32_t, int>::const_iterator iter = depth.begin(); iter != depth.end(); ++iter) {
+      Event event;
+      event.time_ns = end_time;
+      event.thread = iter->first;
+      event.type = EVENT_END;
+      for (int i = 0; i < iter->second; i++) {
+        writeEvent(fp, event, first);
+      }
+    }
+    fputs("\n]}\n", fp);
+    return fclose(fp) == 0;
+  }
+
+  void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(gMutex);
+    gEpoch++;
+    // buffers of running threads are reset by their owner on its next event
+    for (ThreadBuffer* buffer = gBuffers; buffer != NULL; buffer = buffer->next) {
+      if (!buffer->in_use)
+        resetBuffer(buffer);
+    }
+    gDropped.store(0);
+  }
+
+  uint64_t Tracer::numDropped() {
+    return gDropped.load();
+  }
+
+}
@@ -14,17 +14,42 @@ win32 {
 
 HEADERS += $$top_srcdir/include/utility/app.h \
            $$top_srcdir/include/utility/assert.h \
+           $$top_srcdir/include/utility/binary_io.h \
+           $$top_srcdir/include/utility/completion_index.h \
            $$top_srcdir/include/utility/data_var.h \
            $$top_srcdir/include/utility/exception.h \
            $$top_srcdir/include/utility/file.h \
+           $$top_srcdir/include/utility/hash.h \
            $$top_srcdir/include/utility/log.h \
+           $$top_srcdir/include/utility/log_file.h \
+           $$top_srcdir/include/utility/log_index.h \
+           $$top_srcdir/include/utility/log_queue.h \
+           $$top_srcdir/include/utility/mapped_file.h \
+           $$top_srcdir/include/utility/memory_sampler.h \
+           $$top_srcdir/include/utility/memory_tracker.h \
+           $$top_srcdir/include/utility/packed_rtree.h \
+           $$top_srcdir/include/utility/parallel.h \
+           $$top_srcdir/include/utility/string_pool.h \
            $$top_srcdir/include/utility/time.h \
+           $$top_srcdir/include/utility/tracer.h \
            $$top_srcdir/include/utility/utility.h \
            $$top_srcdir/include/utility/win32.h \
 
 SOURCES += app.cpp \
+           completion_index.cpp \
            data_var.cpp \
+           hash.cpp \
            log.cpp \
+           log_file.cpp \
+           log_index.cpp \
+           log_queue.cpp \
+           mapped_file.cpp \
+           memory_sampler.cpp \
+           memory_tracker.cpp \
+           packed_rtree.cpp \
+           parallel.cpp \
+           string_pool.cpp \
            time.cpp \
+           tracer.cpp \
            utility.cpp\
            
\ No newline at end of file